@@ -0,0 +1,68 @@
+#ifndef BATTLEEVENTLOG_H
+#define BATTLEEVENTLOG_H
+
+#include "C:/DandD/include/Utils/Attack.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+enum class BattleResult : uint8_t {
+    ONGOING,
+    PLAYER_WON,
+    PLAYER_LOST,
+    PLAYER_FLED
+};
+
+enum class BattleEventType : uint8_t {
+    BATTLE_STARTED,
+    ATTACK,
+    FLED,
+    BATTLE_ENDED
+};
+
+enum class BattleActor : uint8_t {
+    HERO,
+    MONSTER
+};
+
+// Fixed-size record of a single battle action. Text is only produced when the event is displayed.
+struct BattleEvent {
+    BattleEventType type;
+    BattleActor actor;
+    AttackType attackType;
+    bool critical;
+    BattleResult result;
+    float damage;
+};
+
+static_assert(std::is_trivially_copyable<BattleEvent>::value, "BattleEvent must stay a POD record");
+
+// Ring buffer holding the most recent battle events. Old events are overwritten, never erased.
+class BattleEventLog {
+public:
+    static constexpr size_t CAPACITY = 64;
+
+    BattleEventLog();
+
+    void Push(const BattleEvent &event);
+
+    void Clear();
+
+    // Number of events currently retained (at most CAPACITY)
+    size_t Size() const;
+
+    // Event by age: 0 is the oldest retained event, Size() - 1 the newest
+    const BattleEvent &At(size_t index) const;
+
+    // Total number of events pushed since the last Clear, including overwritten ones
+    uint64_t GetTotalPushed() const;
+
+private:
+    std::array<BattleEvent, CAPACITY> events;
+    size_t head;
+    size_t count;
+    uint64_t totalPushed;
+};
+
+#endif //BATTLEEVENTLOG_H
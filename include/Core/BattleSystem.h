@@ -6,13 +6,16 @@
 #include "C:/DandD/include/Utils/Attack.h"
 #include "C:/DandD/include/Utils/Position.h"
 #include "C:/DandD/include/Core/MapSystem.h"
+#include "C:/DandD/include/Core/BattleEventLog.h"
+#include "C:/DandD/include/Core/MonsterAI.h"
+#include <cstdint>
 #include <functional>
 
-enum class BattleResult {
-    ONGOING,
-    PLAYER_WON,
-    PLAYER_LOST,
-    PLAYER_FLED
+// How the hero picks attacks when a battle is auto-resolved
+enum class BattlePolicy : uint8_t {
+    WEAPON_ONLY,
+    SPELL_ONLY,
+    BEST_DAMAGE
 };
 
 class BattleSystem {
@@ -24,7 +27,8 @@ public:
     // Battle management
     bool CheckForBattle(Hero *player, const Position &newPosition);
 
-    void StartBattle(Hero *player, Monster *monster);
+    // The monster is fought through a combatant copy; its health is written back to the map after every hit
+    void StartBattle(Hero *player, MonsterHandle monster);
 
     void EndBattle(BattleResult result);
 
@@ -36,31 +40,64 @@ public:
 
     void PlayerFlee();
 
+    // Plays the whole encounter at once: hero attacks chosen by the policy, monster answers, until it ends.
+    // Never ends in a flight; a fight still going after MAX_AUTO_ROUNDS is decided on remaining health.
+    BattleResult ResolveBattle(BattlePolicy policy);
+
+    // Result of the most recent battle, ONGOING while one is running
+    BattleResult GetLastResult() const { return lastResult; }
+
     bool IsBattleActive() const;
 
     Hero *GetCurrentPlayer() const { return currentPlayer; }
 
     Monster *GetCurrentMonster() const { return currentMonster; }
 
+    MonsterHandle GetCurrentMonsterHandle() const { return currentHandle; }
+
     void SetMap(Map *map);
 
+    // Decision engine for monster turns; difficulty and time budget are configured on it
+    MonsterAI *GetMonsterAI() const { return monsterAI; }
+
     void SetBattleEndCallback(const std::function<void(BattleResult)> &callback);
 
+    // Events of the current (or last finished) battle, oldest first
+    const BattleEventLog &GetEventLog() const { return eventLog; }
+
+    // Called for every emitted event, e.g. for telemetry or replay recording
+    void SetEventListener(const std::function<void(const BattleEvent &)> &listener);
+
 private:
     static constexpr double HEALTH_RESTORE_PERCENTAGE = 0.3;
+    static constexpr int MAX_AUTO_ROUNDS = 1000; // Safety net for fights where nobody can deal damage
 
     Attack *attackSystem;
+    MonsterAI *monsterAI;
     Map *gameMap;
     Hero *currentPlayer;
-    Monster *currentMonster;
+    Monster *currentMonster; // Points at 'combatant' while a battle runs
+    Monster combatant;
+    MonsterHandle currentHandle;
     double playerHealthBeforeBattle;
     bool battleActive;
+    BattleResult lastResult;
     std::function<void(BattleResult)> onBattleEnd;
+    BattleEventLog eventLog;
+    std::function<void(const BattleEvent &)> onEvent;
 
 private:
-    Monster *GetMonsterAtPosition(const Position &pos) const;
+    void RecordEvent(BattleEventType type, BattleActor actor, AttackType attackType = AttackType::WEAPON,
+                     double damage = 0.0, bool critical = false, BattleResult result = BattleResult::ONGOING);
+
+    void SyncMonsterHealth();
+
+    // Ends a fight that hit MAX_AUTO_ROUNDS with a win or a loss
+    void DecideOnPoints();
 
     bool DetermineFirstTurn() const;
+
+    AttackType ChoosePlayerAttack(BattlePolicy policy) const;
 };
 
 #endif //BATTLESYSTEM_H
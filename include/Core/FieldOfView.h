@@ -0,0 +1,63 @@
+#ifndef FIELDOFVIEW_H
+#define FIELDOFVIEW_H
+
+#include "C:/DandD/include/Core/MapSystem.h"
+#include "C:/DandD/include/Utils/Position.h"
+#include <cstdint>
+#include <vector>
+
+// The hero's sight: cells within a radius that '#' walls do not hide, found by recursive shadowcasting,
+// plus every cell seen so far on the current level. Both are bitsets sized once per level, so recomputing
+// after every step allocates nothing and only touches the cells inside the radius.
+class FieldOfView {
+public:
+    static constexpr int DEFAULT_RADIUS = 8;
+
+    explicit FieldOfView(int radius = DEFAULT_RADIUS);
+
+    // Recomputes what is visible from origin; a newly loaded level starts with nothing explored
+    void Compute(const Map &map, const Position &origin);
+
+    bool IsVisible(int x, int y) const;
+
+    bool IsExplored(int x, int y) const;
+
+    int GetRadius() const { return radius; }
+
+    // Cells marked visible by the last Compute
+    size_t GetVisibleCount() const { return visibleCount; }
+
+    // Bumped by every Compute, so cached drawings of the fog know when to refresh
+    uint32_t GetComputeCount() const { return computeCount; }
+
+    const Position &GetOrigin() const { return lastOrigin; }
+
+private:
+    int radius;
+    int width;
+    int height;
+    int wordsPerRow;
+    uint32_t mapGeneration;
+    size_t visibleCount;
+    uint32_t computeCount;
+    Position lastOrigin;
+    const Map *map; // Only valid during Compute
+
+    std::vector<uint64_t> visible;
+    std::vector<uint64_t> explored;
+
+private:
+    void Reset(const Map &newMap);
+
+    void ClearVisible();
+
+    void Mark(int x, int y);
+
+    bool BlocksSight(int x, int y) const;
+
+    // Scans one octant from 'row' outwards between two slopes; xx..yy map octant coordinates to the map
+    void CastLight(const Position &origin, int row, float startSlope, float endSlope, int xx, int xy, int yx,
+                   int yy);
+};
+
+#endif //FIELDOFVIEW_H
@@ -0,0 +1,78 @@
+#ifndef FLOWFIELD_H
+#define FLOWFIELD_H
+
+#include "C:/DandD/include/Core/MapSystem.h"
+#include "C:/DandD/include/Utils/Position.h"
+#include <cstdint>
+#include <vector>
+
+// Walking distance from every cell to one goal cell (the hero), up to a maximum distance.
+// Opening or closing a cell repairs only the cells whose distance changes. Moving the goal shifts
+// almost every distance by one, so it re-floods, which is cheaper than repairing nearly the whole field;
+// the re-flood resets only the cells the last one reached, so it never touches the whole map.
+class FlowField {
+public:
+    static constexpr uint16_t UNREACHED = 0xFFFF;
+
+    explicit FlowField(int maxDistance);
+
+    // Full rebuild: copies the map's passability and floods from the goal
+    void Build(const Map &map, const Position &goal);
+
+    // Floods from the new goal, limited to the maximum distance
+    void MoveGoal(const Position &newGoal);
+
+    // Re-reads one cell's passability from the map and repairs the field around it
+    void OnCellChanged(const Map &map, const Position &pos);
+
+    uint16_t GetDistance(int x, int y) const;
+
+    const Position &GetGoal() const { return goal; }
+
+    bool IsBuilt() const { return !distance.empty(); }
+
+    int GetMaxDistance() const { return maxDistance; }
+
+    // Number of cells whose distance was written by the last Build/MoveGoal/OnCellChanged
+    size_t GetLastUpdateCount() const { return lastUpdateCount; }
+
+private:
+    int maxDistance;
+    int width;
+    int height;
+    int stride; // Grid is padded with a wall border, so neighbours never need bounds checks
+    Position goal;
+
+    std::vector<uint8_t> passable;
+    std::vector<uint16_t> distance;
+    std::vector<int> reached; // Cells given a distance since the last flood, to reset without a full pass
+
+    struct QueueEntry {
+        int cell;
+        uint16_t distance; // Distance when queued; the entry is stale if the cell got closer since
+    };
+
+    // Scratch space reused between updates
+    std::vector<QueueEntry> seeds; // Starting cells of the next propagation, any distance
+    std::vector<QueueEntry> frontier; // FIFO of relaxed cells, distances never decrease
+    std::vector<uint8_t> invalid;
+    std::vector<int> invalidCells;
+    size_t lastUpdateCount;
+
+private:
+    int CellIndex(int x, int y) const { return (y + 1) * stride + (x + 1); }
+
+    bool IsInside(int x, int y) const { return x >= 0 && y >= 0 && x < width && y < height; }
+
+    void Flood();
+
+    void Lower(int cell, uint16_t newDistance);
+
+    void Propagate();
+
+    void Raise(int seed);
+
+    uint16_t BestNeighbourDistance(int cell) const;
+};
+
+#endif //FLOWFIELD_H
@@ -10,6 +10,10 @@
 #include "C:/DandD/include/Core/MapSystem.h"
 #include "C:/DandD/include/Utils/Attack.h"
 #include "C:/DandD/include/Utils/ProbabilitySystem.h"
+#include "C:/DandD/include/Core/ReplayRecorder.h"
+#include "C:/DandD/include/Core/FieldOfView.h"
+#include "C:/DandD/include/Core/MonsterMovement.h"
+#include "C:/DandD/include/Core/Pathfinder.h"
 #include <raylib.h>
 
 class GameManager {
@@ -29,7 +33,44 @@ private:
     Hero *hero;
     Map *currentMap;
     Attack *attackSystem;
-    Monster *currentMonster;
+    MonsterHandle currentMonster;
+    ReplayRecorder *replayRecorder;
+    MonsterMovement *monsterMovement;
+    Pathfinder *pathfinder;
+    FieldOfView *fieldOfView;
+    uint32_t frameCounter;
+
+    // Fixed-step simulation: real time piles up here and is spent in SIM_TICK steps
+    float simAccumulator;
+
+    // F3 overlay: frame rate, simulation steps and their cost, map draw calls
+    bool showFrameStats;
+    int lastFrameTicks;
+    double simMillisPerTick; // Smoothed over recent frames
+
+    // Render on demand: frames are only drawn when input, a state change or an animation needs them
+    bool renderOnDemand;
+    double lastLoopTime;
+    float idleTime; // Since the last input or state change
+    float ambientTimer; // Since the last frame drawn for ambient animation
+    UIState lastState;
+    uint32_t skippedFrames;
+
+    // Click-to-move: cells still to walk, one step every AUTO_STEP_INTERVAL seconds
+    std::vector<Position> autoPath;
+    size_t autoPathIndex;
+    float autoStepTimer;
+
+    static constexpr float AUTO_STEP_INTERVAL = 0.08f;
+
+    static constexpr float SIM_TICK = 1.0f / 120.0f;
+    static constexpr float MAX_FRAME_TIME = 0.25f; // A longer stall (debugger, window drag) is not caught up
+
+    static constexpr float IDLE_GRACE = 0.5f; // Keep drawing this long after input so hover fades finish
+    static constexpr float AMBIENT_INTERVAL = 1.0f / 15.0f; // Redraw rate for slow looping effects when idle
+    static constexpr double IDLE_POLL_INTERVAL = 1.0 / 120.0; // Sleep between input polls of a skipped frame
+
+    static constexpr const char *REPLAY_FILE_PATH = "C:/DandD/replays/last_run.replay";
 
 private:
     void InitializeSystems();
@@ -40,11 +81,34 @@ private:
 
     void Update(float deltaTime) const;
 
+    // One fixed step of everything that moves with time rather than with input
+    void Simulate(float tickTime);
+
     void Render() const;
 
+    void DrawFrameStats() const;
+
+    // Decides whether this loop iteration draws; updates the idle timers
+    bool ShouldRender(float deltaTime);
+
+    bool HasInputActivity() const;
+
+    // Panels and non-gameplay screens take the input instead of the hero
+    bool IsMovementBlocked() const;
+
     void HandleMovement();
 
-    void HandleCombatTrigger();
+    bool TryMoveHero(MoveDirection direction);
+
+    void CheckTriggers();
+
+    void HandleClickToMove();
+
+    void HandleAutoStep(float tickTime);
+
+    void CancelAutoPath();
+
+    bool HandleCombatTrigger();
 
     void HandleTreasureCollection();
 
@@ -53,6 +117,8 @@ private:
     void TransitionToNextLevel() const;
 
     void PositionHeroAtStart() const;
+
+    void SaveReplay() const;
 };
 
 #endif //GAMEMANAGER_H
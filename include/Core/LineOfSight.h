@@ -0,0 +1,81 @@
+#ifndef LINEOFSIGHT_H
+#define LINEOFSIGHT_H
+
+#include "C:/DandD/include/Core/MapSystem.h"
+#include "C:/DandD/include/Core/MonsterStore.h"
+#include "C:/DandD/include/Utils/Position.h"
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+enum class SightMode {
+    BRESENHAM, // One line per query; cheap, but A seeing B does not guarantee B sees A
+    SYMMETRIC_SHADOWCAST // Shadowcast from the target once, every query against it is a lookup; always symmetric
+};
+
+struct SightStats {
+    size_t queries;
+    size_t cacheHits;
+    size_t cellsTested; // isPassable lookups done by lines and sweeps
+    size_t sweeps;
+};
+
+// "Can A see B" checks against Map::isPassable for monster aggro. Answers are cached until the next
+// BeginTurn, keyed by the packed (from, to) pair, since nothing on the map moves in between.
+class LineOfSight {
+public:
+    explicit LineOfSight(SightMode mode = SightMode::SYMMETRIC_SHADOWCAST);
+
+    // Drops the cached answers; call once per turn, after anything moved
+    void BeginTurn();
+
+    // True if nothing blocks sight between the two cells and they are at most 'range' apart (Euclidean)
+    bool HasLineOfSight(const Map &map, const Position &from, const Position &to, int range);
+
+    // One answer per monster (dense order) on whether it sees 'target'; in shadowcast mode a single sweep
+    void CanSeeTarget(const Map &map, const MonsterStore &monsters, const Position &target, int range,
+                      std::vector<uint8_t> &results);
+
+    void SetMode(SightMode newMode);
+
+    SightMode GetMode() const { return mode; }
+
+    const SightStats &GetStats() const { return stats; }
+
+private:
+    SightMode mode;
+    SightStats stats;
+    std::unordered_map<uint64_t, bool> cache;
+
+    // Last shadowcast sweep: cells visible from sweepOrigin, as a bitset over the square around it
+    bool sweepValid;
+    Position sweepOrigin;
+    int sweepRange;
+    int sweepSide;
+    std::vector<uint64_t> sweepVisible;
+
+    // Only valid during a sweep
+    const Map *sweepMap;
+
+private:
+    static uint64_t PackKey(const Position &from, const Position &to);
+
+    static bool InRange(const Position &from, const Position &to, int range);
+
+    bool TraceLine(const Map &map, const Position &from, const Position &to);
+
+    void Sweep(const Map &map, const Position &origin, int range);
+
+    bool SweepSees(const Position &cell) const;
+
+    // One quadrant row of the symmetric shadowcast; slopes are fractions num/den with den > 0
+    void ScanRow(int quadrant, int depth, int startNum, int startDen, int endNum, int endDen);
+
+    Position QuadrantToMap(int quadrant, int depth, int column) const;
+
+    bool IsWall(const Position &cell);
+
+    void Reveal(const Position &cell);
+};
+
+#endif //LINEOFSIGHT_H
@@ -5,8 +5,9 @@
 #define MAPSYSTEM_H
 
 #include "C:/DandD/include/Utils/Position.h"
-#include "C:/DandD/include/Entities/Monster.h"
+#include "C:/DandD/include/Core/MonsterStore.h"
 #include "C:/DandD/include/Entities/Treasure.h"
+#include "C:/DandD/include/Utils/SpatialGrid.h"
 #include <vector>
 #include <string>
 
@@ -28,9 +29,9 @@ public:
 
     size_t getHeight() const;
 
-    const std::vector<Monster> &getMonstersConst() const;
+    const MonsterStore &getMonstersConst() const;
 
-    std::vector<Monster> &getMonsters();
+    MonsterStore &getMonsters();
 
     size_t GetMonsterCount() const;
 
@@ -40,20 +41,41 @@ public:
 
     void removeTreasure(const Treasure &treasure);
 
-    void removeMonster(const Monster &monster);
+    // Appends the indices of treasures inside the inclusive cell rectangle, lowest first, looking only at the
+    // spatial buckets it overlaps
+    void QueryTreasures(int minX, int minY, int maxX, int maxY, std::vector<size_t> &out) const;
+
+    void removeMonster(MonsterHandle monster);
 
     size_t GetTreasureCount() const;
 
     int GetCurrentLevel() const;
 
+    // True when every normal monster or every boss on the level has been defeated
+    bool IsLevelCleared() const;
+
+    // Bumped by every load, so caches built from the grid know when to rebuild
+    uint32_t GetLoadGeneration() const;
+
+    // Cells that turned passable or blocked since the last load, in order
+    const std::vector<Position> &GetPassabilityChanges() const;
+
+    // Every cell whose character changed since the last load, in order
+    const std::vector<Position> &GetTileChanges() const;
+
 private:
     std::vector<std::vector<char> > grid;
     size_t width, height;
     int currentLevel;
+    uint32_t loadGeneration;
+    std::vector<Position> passabilityChanges;
+    std::vector<Position> tileChanges;
 
     Position startPos;
-    std::vector<Monster> enemies;
+    MonsterStore enemies;
     std::vector<Treasure> treasures;
+    SpatialGrid treasureIndex; // Indices into treasures; refiled whenever one is removed
+    mutable std::vector<uint32_t> treasureScratch;
 
 private:
     void validateMap() const;
@@ -61,6 +83,8 @@ private:
     static int parseLevelNumber(const std::string &line);
 
     void parseGridLine(const std::string &line, int rowIndex);
+
+    void indexTreasures();
 };
 
 #endif //MAPSYSTEM_H
@@ -0,0 +1,90 @@
+#ifndef MONSTERAI_H
+#define MONSTERAI_H
+
+#include "C:/DandD/include/Entities/Hero.h"
+#include "C:/DandD/include/Entities/Monster.h"
+#include "C:/DandD/include/Utils/Attack.h"
+#include <array>
+#include <cstdint>
+
+struct MonsterSearchStats {
+    int depthReached;
+    uint32_t nodes;
+    uint32_t tableHits;
+    bool outOfNodes;
+    long long elapsedMicros;
+};
+
+// Preset search depths, picked in the options menu and stored with each replay
+enum class MonsterDifficulty : uint8_t {
+    EASY,
+    NORMAL,
+    HARD
+};
+
+// Chooses monster attacks with an expectimax search over attack types and critical hit outcomes.
+// The hero is modelled as picking the reply that is worst for the monster; crits are chance nodes.
+class MonsterAI {
+public:
+    // Deepest search the default node budget still finishes: at most 3304 nodes over levels 1-20
+    static constexpr int MAX_DEPTH = 12;
+
+    explicit MonsterAI(const Attack *attackSystem);
+
+    AttackType ChooseAttack(const Monster &monster, const Hero &hero);
+
+    // Difficulty: number of attacks (plies) looked ahead for each monster type
+    void SetSearchDepth(MonsterType type, int depth);
+
+    int GetSearchDepth(MonsterType type) const;
+
+    // Sets both depths from a preset; HARD searches bosses to MAX_DEPTH
+    void SetDifficulty(MonsterDifficulty difficulty);
+
+    // Hard cap on nodes per decision; the deepest fully searched iteration is used when it runs out.
+    // Counted in nodes rather than time so a replay makes the same choices on any machine. Zero disables it.
+    void SetNodeBudget(uint32_t budget);
+
+    // Drops cached positions, e.g. when a new battle starts
+    void ClearTable();
+
+    const MonsterSearchStats &GetLastSearchStats() const;
+
+private:
+    static constexpr size_t TABLE_SIZE = 4096;
+    static constexpr uint32_t DEFAULT_NODE_BUDGET = 4096; // Room for MAX_DEPTH, still under 0.1 ms per decision
+    static constexpr float WIN_SCORE = 1000.0f;
+
+    struct TableEntry {
+        uint64_t key;
+        float value;
+        int8_t depth;
+    };
+
+    const Attack *attackSystem;
+    int normalDepth;
+    int bossDepth;
+    uint32_t nodeBudget;
+
+    std::array<TableEntry, TABLE_SIZE> table;
+
+    // Per-decision constants: damage[attackType][critical] for both sides
+    float monsterDamage[2][2];
+    float heroDamage[2][2];
+    float heroMaxHealth;
+    float monsterMaxHealth;
+    float critChance;
+    uint64_t statsKey;
+
+    bool aborted;
+    MonsterSearchStats stats;
+
+private:
+    float Search(float heroHealth, float monsterHealth, int depth, bool monsterToMove);
+
+    float Evaluate(float heroHealth, float monsterHealth) const;
+
+    uint64_t MakeKey(float heroHealth, float monsterHealth, bool monsterToMove) const;
+};
+
+#endif //MONSTERAI_H
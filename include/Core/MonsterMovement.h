@@ -0,0 +1,66 @@
+#ifndef MONSTERMOVEMENT_H
+#define MONSTERMOVEMENT_H
+
+#include "C:/DandD/include/Core/FlowField.h"
+#include "C:/DandD/include/Core/LineOfSight.h"
+#include "C:/DandD/include/Core/MapSystem.h"
+#include "C:/DandD/include/Core/TurnScheduler.h"
+#include "C:/DandD/include/Utils/Position.h"
+#include <cstdint>
+#include <vector>
+
+// Turn-based monster roaming: after every hero step, each alive monster within chase range takes one
+// step down a single distance field shared by all monsters, instead of searching a path of its own.
+// A monster starts chasing once it sees the hero and keeps at it until the hero leaves chase range.
+// Who moves how often comes from a turn scheduler: bosses are slower than the hero and skip some turns.
+// Only monsters that can act are scheduled; idle ones are parked outside it until they notice the hero.
+class MonsterMovement {
+public:
+    static constexpr int DEFAULT_CHASE_RADIUS = 8; // Walking distance at which monsters notice the hero
+    static constexpr int HERO_SPEED = TurnScheduler::NORMAL_SPEED;
+    static constexpr int MONSTER_SPEED = TurnScheduler::NORMAL_SPEED;
+    static constexpr int BOSS_SPEED = 75; // Three moves for every four hero steps
+
+    explicit MonsterMovement(int chaseRadius = DEFAULT_CHASE_RADIUS);
+
+    // The hero took a step: every monster due before the hero's next turn acts. Returns how many monsters
+    // moved. Rebuilds the field and the schedule when the map was reloaded.
+    size_t Tick(Map &map, const Position &heroPos);
+
+    // Brings the field and the schedule up to date: full build after a level load, incremental repairs
+    // otherwise. Tick does this itself; calling it on level load keeps the full build out of the first turn.
+    void SyncField(const Map &map, const Position &heroPos);
+
+    const FlowField &GetFlowField() const { return field; }
+
+    LineOfSight &GetLineOfSight() { return sight; }
+
+    const TurnScheduler &GetScheduler() const { return scheduler; }
+
+private:
+    FlowField field;
+    LineOfSight sight;
+    std::vector<uint8_t> seesHero; // Per monster, refreshed every turn in one sweep
+    uint32_t mapGeneration;
+    size_t changesApplied; // Entries of Map::GetPassabilityChanges already fed to the field
+    std::vector<uint8_t> occupied; // One monster per cell
+    TurnScheduler scheduler;
+    ActorId heroActor;
+    std::vector<ActorId> monsterActors; // By monster slot; stale while the monster is parked
+
+private:
+    void RebuildSchedule(const MonsterStore &monsters);
+
+    // Schedules parked monsters within chase range that are chasing or just saw the hero
+    void WakeMonsters(const MonsterStore &monsters);
+
+    // Whether an alive monster within walking reach is not chasing yet, i.e. the sight sweep matters
+    bool AnyMonsterUnaware(const MonsterStore &monsters) const;
+
+    // Whether the monster would do anything on its turn
+    bool CanAct(const MonsterStore &monsters, size_t index) const;
+
+    bool StepMonster(MonsterStore &monsters, size_t index, int width);
+};
+
+#endif //MONSTERMOVEMENT_H
@@ -0,0 +1,112 @@
+#ifndef MONSTERSTORE_H
+#define MONSTERSTORE_H
+
+#include "C:/DandD/include/Entities/Monster.h"
+#include "C:/DandD/include/Utils/Position.h"
+#include "C:/DandD/include/Utils/SpatialGrid.h"
+#include <cstdint>
+#include <vector>
+
+// Refers to a monster in a MonsterStore. Survives removals of other monsters;
+// once its own monster is removed (or the level reloaded) the generation no longer matches.
+struct MonsterHandle {
+    uint32_t slot;
+    uint32_t generation;
+
+    static constexpr uint32_t INVALID_SLOT = 0xFFFFFFFF;
+
+    static MonsterHandle Invalid() { return {INVALID_SLOT, 0}; }
+
+    bool operator==(const MonsterHandle &other) const {
+        return slot == other.slot && generation == other.generation;
+    }
+
+    bool operator!=(const MonsterHandle &other) const { return !(*this == other); }
+};
+
+// Monsters of a level kept as parallel arrays (structure of arrays), densely packed so scans are linear.
+// Removal swaps the last monster into the hole; handles go through a slot table and stay valid.
+// Everything else about a monster (name, mana, armor) follows from its level via Balance tables.
+class MonsterStore {
+public:
+    MonsterStore();
+
+    MonsterHandle Add(const Position &pos, int level, MonsterType type);
+
+    // Removes the monster; the handle (and every copy of it) becomes stale
+    void Remove(MonsterHandle handle);
+
+    // Removes every monster, e.g. when a new level is loaded; all handles become stale
+    void Clear();
+
+    bool IsValid(MonsterHandle handle) const;
+
+    // Dense index of a valid handle; reports and throws on a stale one
+    size_t IndexOf(MonsterHandle handle) const;
+
+    MonsterHandle HandleAt(size_t index) const;
+
+    // First alive monster standing on the position, or an invalid handle
+    MonsterHandle FindAliveAt(const Position &pos) const;
+
+    // Appends the dense indices of monsters (alive or not) inside the inclusive cell rectangle, lowest first.
+    // Looks only at the spatial buckets the rectangle overlaps.
+    void QueryArea(int minX, int minY, int maxX, int maxY, std::vector<size_t> &out) const;
+
+    size_t Size() const { return positions.size(); }
+
+    bool Empty() const { return positions.empty(); }
+
+    size_t CountAlive(MonsterType type) const;
+
+    // Hot fields, indexed 0..Size()-1
+    const Position &GetPosition(const size_t index) const { return positions[index]; }
+
+    float GetHealth(const size_t index) const { return health[index]; }
+
+    int GetLevel(const size_t index) const { return levels[index]; }
+
+    MonsterType GetType(const size_t index) const { return types[index]; }
+
+    bool IsAlive(const size_t index) const { return alive[index] != 0; }
+
+    // Has noticed the hero and keeps chasing while in range
+    bool IsAggro(const size_t index) const { return aggro[index] != 0; }
+
+    float GetMaxHealth(size_t index) const;
+
+    // Also refiles the monster in the spatial index
+    void SetPosition(size_t index, const Position &pos);
+
+    void SetAggro(const size_t index, const bool value) { aggro[index] = value ? 1 : 0; }
+
+    // Health is clamped to [0, max]; the alive flag follows it
+    void SetHealth(size_t index, float newHealth);
+
+    void SetDefeated(size_t index, bool defeated);
+
+    // Builds a standalone combatant (an Entity for the attack rules) with the monster's current state
+    Monster MakeCombatant(size_t index) const;
+
+private:
+    // Hot arrays, all Size() long
+    std::vector<Position> positions;
+    std::vector<float> health;
+    std::vector<int> levels;
+    std::vector<MonsterType> types;
+    std::vector<uint8_t> alive;
+    std::vector<uint8_t> aggro;
+    std::vector<uint32_t> denseToSlot; // Slot owning each dense entry
+
+    // Slot table, only touched when resolving handles
+    std::vector<uint32_t> slotToDense;
+    std::vector<uint32_t> slotGeneration;
+    std::vector<uint32_t> freeSlots;
+
+    SpatialGrid spatialIndex; // Slots by position; slots survive the swap in Remove, dense indices do not
+    mutable std::vector<uint32_t> queryScratch;
+
+    static constexpr uint32_t NO_INDEX = 0xFFFFFFFF;
+};
+
+#endif //MONSTERSTORE_H
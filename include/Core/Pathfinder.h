@@ -0,0 +1,116 @@
+#ifndef PATHFINDER_H
+#define PATHFINDER_H
+
+#include "C:/DandD/include/Core/MapSystem.h"
+#include "C:/DandD/include/Utils/Position.h"
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+struct PathQueryStats {
+    size_t expanded; // Jump points taken from the open list
+    size_t generated; // Jump points pushed onto the open list
+    bool budgetExceeded;
+    long long elapsedMicros;
+};
+
+// A* over jump points on the 4-connected, uniform-cost map grid (JPS4).
+// Canonical paths run horizontally and only turn at cells where a vertical scan finds something, so straight
+// runs are skipped in one scan. Columns are stored as bitsets, making each vertical scan a few word operations.
+class Pathfinder {
+public:
+    Pathfinder();
+
+    // Shortest path from start to goal, both ends included. Returns false if the goal is unreachable or the
+    // time budget ran out; 'path' then leads to the explored cell closest to the goal (possibly just the start).
+    // Brings the grid up to date first, outside the budget; call SyncGrid after a level load to keep that cheap.
+    bool FindPath(const Map &map, const Position &start, const Position &goal, std::vector<Position> &path);
+
+    // Full rebuild after a level load, otherwise just the cells whose walls changed since the last call
+    void SyncGrid(const Map &map);
+
+    // Hard cap per query; zero disables it
+    void SetTimeBudget(std::chrono::microseconds budget);
+
+    const PathQueryStats &GetLastQueryStats() const;
+
+private:
+    static constexpr uint32_t TIME_CHECK_INTERVAL = 4;
+    static constexpr int64_t BUILD_NANOS_PER_CELL = 10; // Rough cost of one cell of BuildPath, kept out of the budget
+    static constexpr int RESERVE_DIVISOR = 10; // A tenth of the budget covers the last expansions and the setup
+    static constexpr int MAX_ROW_SCAN = 64; // Longer open runs are cut into jump points, so expansions stay short
+
+    // Scan directions still to expand from a node, as bits
+    enum DirectionBit : uint8_t {
+        RIGHT = 1,
+        LEFT = 2,
+        DOWN = 4,
+        UP = 8,
+        ALL_DIRECTIONS = RIGHT | LEFT | DOWN | UP
+    };
+
+    struct Node {
+        uint32_t g;
+        int parent;
+        uint32_t stamp; // Query that wrote the node; any other value means not visited yet
+        uint8_t pending; // Directions queued for expansion
+        uint8_t done; // Directions already expanded
+    };
+
+    struct OpenEntry {
+        uint32_t f;
+        uint32_t g;
+        int cell;
+
+        // Lowest f first; on ties prefer the deeper node, which heads straight for the goal
+        bool operator<(const OpenEntry &other) const {
+            return f != other.f ? f > other.f : g < other.g;
+        }
+    };
+
+    // Grid copied from the map, rebuilt when the map is reloaded or a wall changes
+    int width;
+    int height;
+    int wordsPerColumn;
+    uint32_t mapGeneration;
+    size_t changesSeen;
+    std::vector<uint8_t> passable;
+    std::vector<uint64_t> columnBlocked; // Per column: blocked cells, rows past the bottom count as blocked
+    std::vector<uint64_t> forcedDown; // Free cells where a side opens up for a scan moving down
+    std::vector<uint64_t> forcedUp; // Same for a scan moving up
+    std::vector<Node> nodes; // One per cell, sized with the grid so queries never allocate or clear it
+
+    // Per-query state
+    Position goal;
+    int bestCell; // Closest to the goal so far, for partial paths
+    uint32_t queryStamp;
+    std::vector<OpenEntry> open;
+    std::chrono::microseconds timeBudget;
+    PathQueryStats stats;
+
+private:
+    // Recomputes the blocked and forced bits of one cell from 'passable'
+    void RefreshCellBits(int x, int y);
+
+    bool IsFree(int x, int y) const;
+
+    // Next jump point when scanning column x from row y in direction dy, or -1
+    int ScanColumn(int x, int y, int dy) const;
+
+    // Next jump point when scanning row y from column x in direction dx, or -1
+    int ScanRow(int x, int y, int dx) const;
+
+    void Expand(int cell);
+
+    void Push(int cell, int parent, uint32_t g, uint8_t directions);
+
+    static uint8_t DirectionsAfterRow(int dx);
+
+    uint8_t DirectionsAfterColumn(int x, int y, int dy) const;
+
+    uint32_t Heuristic(int cell) const;
+
+    void BuildPath(int endCell, std::vector<Position> &path) const;
+};
+
+#endif //PATHFINDER_H
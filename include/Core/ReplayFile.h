@@ -0,0 +1,91 @@
+#ifndef REPLAYFILE_H
+#define REPLAYFILE_H
+
+#include "C:/DandD/include/Core/MonsterAI.h"
+#include "C:/DandD/include/Entities/Hero.h"
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+enum class ReplayInputType : uint8_t {
+    MOVE,
+    BATTLE_ACTION,
+    LEVEL_UP,
+    EQUIPMENT,
+    CHECKPOINT,
+    AUTO_BATTLE
+};
+
+enum class MoveDirection : uint8_t {
+    RIGHT,
+    LEFT,
+    UP,
+    DOWN
+};
+
+enum class BattleAction : uint8_t {
+    WEAPON,
+    SPELL,
+    FLEE
+};
+
+// One recorded input. 'args' holds the input payload, 'value' the checksum of CHECKPOINT records.
+// AUTO_BATTLE carries a BattlePolicy and resolves the current battle in one step.
+struct ReplayRecord {
+    uint32_t frame;
+    ReplayInputType type;
+    uint8_t args[3];
+    uint32_t value;
+};
+
+struct ReplayHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint8_t race;
+    uint8_t difficulty; // MonsterDifficulty the run was played at
+    uint32_t seed;
+    uint32_t recordCount;
+};
+
+static_assert(std::is_trivially_copyable<ReplayRecord>::value && sizeof(ReplayRecord) == 12,
+              "ReplayRecord is written to disk as-is");
+static_assert(std::is_trivially_copyable<ReplayHeader>::value && sizeof(ReplayHeader) == 16,
+              "ReplayHeader is written to disk as-is");
+
+// RNG seed, starting race, monster difficulty and the ordered input stream of a single run
+class ReplayFile {
+public:
+    static constexpr uint32_t MAGIC = 0x52444E44; // "DNDR"
+    static constexpr uint16_t VERSION = 4; // Bumped whenever rule changes make older recordings diverge
+
+    ReplayFile();
+
+    void Reset(uint32_t seed, Race race, MonsterDifficulty difficulty);
+
+    void Append(const ReplayRecord &record);
+
+    uint32_t GetSeed() const;
+
+    Race GetRace() const;
+
+    MonsterDifficulty GetDifficulty() const;
+
+    const std::vector<ReplayRecord> &GetRecords() const;
+
+    void Save(const std::string &filePath) const;
+
+    // Throws on a file that is not a replay of this version, or whose size does not match its record count
+    static ReplayFile Load(const std::string &filePath);
+
+    // Hash of the hero state compared at checkpoints to detect desyncs
+    static uint32_t ComputeChecksum(const Hero &hero);
+
+private:
+    uint32_t seed;
+    Race race;
+    MonsterDifficulty difficulty;
+    std::vector<ReplayRecord> records;
+};
+
+#endif //REPLAYFILE_H
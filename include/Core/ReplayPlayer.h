@@ -0,0 +1,110 @@
+#ifndef REPLAYPLAYER_H
+#define REPLAYPLAYER_H
+
+#include "C:/DandD/include/Core/ReplayFile.h"
+#include "C:/DandD/include/Core/BattleSystem.h"
+#include "C:/DandD/include/Core/MapSystem.h"
+#include "C:/DandD/include/Core/MonsterMovement.h"
+#include "C:/DandD/include/Entities/Hero.h"
+#include "C:/DandD/include/Items/Item.h"
+#include <deque>
+#include <memory>
+#include <optional>
+#include <string>
+
+struct ReplayStats {
+    bool desynced;
+    size_t recordsApplied;
+    uint32_t desyncFrame;
+    std::string desyncReason;
+    int levelReached;
+    int heroLevel;
+    int battlesFought;
+    int itemsFound;
+    uint32_t finalChecksum;
+};
+
+// Runs a recorded input stream through the game rules without a window, renderer or frame pacing.
+// Mirrors the state flow of GameManager/UIManager: battles, treasure choices, level transitions.
+// Inputs can come from a replay file (Play) or be generated on the fly (Begin + Step).
+class ReplayPlayer {
+public:
+    enum class Phase {
+        GAMEPLAY,
+        BATTLE,
+        EQUIPMENT,
+        LEVEL_UP,
+        DEFEAT
+    };
+
+    explicit ReplayPlayer(std::string mapFilePath = "C:/DandD/assets/maps/maps.txt");
+
+    ReplayStats Play(const ReplayFile &replay);
+
+    // Starts a run from the state GameManager::HandleRaceSelection creates
+    void Begin(uint32_t seed, Race race, MonsterDifficulty difficulty = MonsterDifficulty::NORMAL);
+
+    // Applies one input; returns false on a desync
+    bool Step(const ReplayRecord &record);
+
+    // Generated input streams carry no checkpoints, so verification can be switched off
+    void SetCheckpointVerification(bool enabled);
+
+    Phase GetPhase() const;
+
+    const Hero &GetHero() const;
+
+    const Map &GetMap() const;
+
+    const Item *GetPendingItem() const;
+
+    ReplayStats GetStats() const;
+
+private:
+    struct Checkpoint {
+        BattleResult result;
+        uint32_t checksum;
+    };
+
+    std::string mapFilePath;
+
+    std::unique_ptr<Hero> hero;
+    Map map;
+    BattleSystem battleSystem;
+    MonsterMovement monsterMovement;
+
+    Phase phase;
+    int currentLevel;
+    bool levelComplete;
+    BattleResult lastResult;
+    std::optional<Item> pendingItem;
+    std::deque<Checkpoint> checkpoints;
+    bool verifyCheckpoints;
+
+    ReplayStats stats;
+
+private:
+    bool ApplyRecord(const ReplayRecord &record);
+
+    bool ApplyMove(const ReplayRecord &record);
+
+    bool ApplyBattleAction(const ReplayRecord &record);
+
+    bool ApplyAutoBattle(const ReplayRecord &record);
+
+    void FinishBattle();
+
+    bool ApplyCheckpoint(const ReplayRecord &record);
+
+    void CheckTriggers();
+
+    void OnBattleEnd(BattleResult result);
+
+    bool LoadLevel(int levelNumber);
+
+    void TransitionToNextLevel();
+
+    bool Desync(const ReplayRecord &record, const std::string &reason);
+};
+
+#endif //REPLAYPLAYER_H
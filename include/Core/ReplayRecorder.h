@@ -0,0 +1,48 @@
+#ifndef REPLAYRECORDER_H
+#define REPLAYRECORDER_H
+
+#include "C:/DandD/include/Core/ReplayFile.h"
+#include "C:/DandD/include/Core/BattleEventLog.h"
+#include "C:/DandD/include/Core/BattleSystem.h"
+#include <string>
+
+// Collects player inputs of the running game into a ReplayFile
+class ReplayRecorder {
+public:
+    ReplayRecorder();
+
+    // Starts a new recording; the seed must already be applied to RandomUtils
+    void Begin(uint32_t seed, Race race, MonsterDifficulty difficulty);
+
+    bool IsRecording() const;
+
+    // Frame number stamped on the following records
+    void SetFrame(uint32_t frame);
+
+    void RecordMove(MoveDirection direction);
+
+    // Hero attacks and flee become battle inputs, battle ends become checkpoints
+    void RecordBattleEvent(const BattleEvent &event, const Hero &hero);
+
+    // The current battle is resolved in one go; its attacks are left out until it ends, as replay repeats them
+    void RecordAutoBattle(BattlePolicy policy);
+
+    void RecordLevelUp(int strength, int mana, int health);
+
+    void RecordEquipment(bool equipped);
+
+    void Save(const std::string &filePath) const;
+
+    const ReplayFile &GetReplay() const;
+
+private:
+    ReplayFile replay;
+    bool recording;
+    uint32_t currentFrame;
+    bool autoBattle; // Inside a fight recorded as one AUTO_BATTLE
+
+private:
+    void Append(ReplayInputType type, uint8_t arg0 = 0, uint8_t arg1 = 0, uint8_t arg2 = 0, uint32_t value = 0);
+};
+
+#endif //REPLAYRECORDER_H
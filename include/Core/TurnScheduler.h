@@ -0,0 +1,112 @@
+#ifndef TURNSCHEDULER_H
+#define TURNSCHEDULER_H
+
+#include "C:/DandD/include/Core/MonsterStore.h"
+#include <cstdint>
+#include <map>
+#include <vector>
+
+enum class ActorKind {
+    HERO,
+    MONSTER,
+    EFFECT // Timed effects act like any other actor, e.g. once every few turns
+};
+
+// Refers to an actor in a TurnScheduler; goes stale once the actor is removed or the scheduler cleared
+struct ActorId {
+    uint32_t slot;
+    uint32_t generation;
+
+    static constexpr uint32_t INVALID_SLOT = 0xFFFFFFFF;
+
+    static ActorId Invalid() { return {INVALID_SLOT, 0}; }
+
+    bool operator==(const ActorId &other) const { return slot == other.slot && generation == other.generation; }
+
+    bool operator!=(const ActorId &other) const { return !(*this == other); }
+};
+
+struct ScheduledActor {
+    ActorKind kind;
+    MonsterHandle monster; // Only for MONSTER actors
+    int speed;
+};
+
+// Energy-based turn order. Actors gain energy at their speed and act once they have ACTION_COST of it,
+// so a speed 200 actor acts twice for every action of a speed 100 one. Stored as the world time at
+// which each actor's energy is full again, with one queue per distinct time: an action costs O(log t)
+// in the number of distinct pending times, which stays small while actors share a few speeds.
+// Equal times act in the order they were scheduled, which keeps turn order deterministic.
+class TurnScheduler {
+public:
+    static constexpr int ACTION_COST = 100;
+    static constexpr int NORMAL_SPEED = 100;
+
+    TurnScheduler();
+
+    // New actors act at the current time, after everyone already due then
+    ActorId Add(ActorKind kind, MonsterHandle monster, int speed);
+
+    void Remove(ActorId id);
+
+    // Removes every actor; all ids become stale
+    void Clear();
+
+    // Makes room for this many actors up front, so adding them does not reallocate
+    void Reserve(size_t actors);
+
+    bool IsValid(ActorId id) const;
+
+    // Actor whose turn it is, or an invalid id when there are no actors; advances the world time to it
+    ActorId Next();
+
+    // The actor took an action costing 'cost' energy and waits until it has recovered it
+    void Spend(ActorId id, int cost = ACTION_COST);
+
+    const ScheduledActor &Get(ActorId id) const;
+
+    void SetSpeed(ActorId id, int speed);
+
+    size_t Size() const { return liveCount; }
+
+    uint64_t GetTime() const { return now; }
+
+private:
+    struct Slot {
+        ScheduledActor actor;
+        uint32_t generation;
+        bool used;
+        uint64_t readyTime;
+        uint64_t ticket; // Matches the actor's one live queue entry; older entries are skipped
+        int carry; // Remainder of the last delay division, so odd speeds do not drift
+    };
+
+    struct QueueEntry {
+        uint64_t ticket; // Increasing, so appending keeps each queue in scheduling order
+        uint32_t slot;
+    };
+
+    // Actors due at one time; 'head' passes over the ones that already had their turn
+    struct Bucket {
+        std::vector<QueueEntry> entries;
+        size_t head;
+    };
+
+    std::vector<Slot> slots;
+    std::vector<uint32_t> freeSlots;
+    std::map<uint64_t, Bucket> buckets; // By ready time
+    std::vector<std::vector<QueueEntry> > spareEntries; // Storage of used-up buckets, reused for new ones
+    uint64_t now;
+    uint64_t nextTicket;
+    size_t liveCount;
+
+private:
+    Slot &Resolve(ActorId id);
+
+    void Schedule(uint32_t slot, uint64_t readyTime);
+
+    // Drops queue entries of removed or rescheduled actors from the front
+    void DropStaleTop();
+};
+
+#endif //TURNSCHEDULER_H
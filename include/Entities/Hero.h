@@ -13,6 +13,17 @@ enum class Race {
 
 Race stringToRace(const std::string &r);
 
+// Everything derived from attributes and equipment, recomputed only after one of them changes
+struct HeroStats {
+    int strength;
+    int mana;
+    float maxHealth;
+    int level;
+    float weaponBonus; // Equipment bonuses as fractions (20% -> 0.2)
+    float spellBonus;
+    float armorReduction;
+};
+
 class Hero : public Entity {
 public:
     Hero(const std::string &raceName, std::string heroName);
@@ -69,10 +80,17 @@ public:
 
     Inventory &GetInventory();
 
+    const Inventory &GetInventory() const;
+
     void levelUp(int str, int mna, float hlth);
 
     void restoreHealthAfterBattle();
 
+    const HeroStats &GetStats() const;
+
+    // Changes whenever GetStats() changes; widgets compare it to skip rebuilding what they show
+    uint32_t GetStatsVersion() const;
+
 private:
     Race race;
 
@@ -89,6 +107,15 @@ private:
     Position currentPosition;
 
     std::string name;
+
+    // Derived stats cache; the inventory is changed through a reference, so it is checked by version
+    mutable HeroStats stats;
+    mutable uint32_t statsVersion;
+    mutable uint32_t statsInventoryVersion;
+    mutable bool statsDirty;
+
+private:
+    void RefreshStats() const;
 };
 
 #endif //Hero_h
@@ -3,6 +3,7 @@
 
 #include "Entity.h"
 #include "C:/DandD/include/Utils/Position.h"
+#include "C:/DandD/include/Utils/BalanceTables.h"
 #include <sstream>
 
 enum class MonsterType {
@@ -10,10 +11,6 @@ enum class MonsterType {
     MONSTER
 };
 
-const int BASE_HEALTH = 50;
-const int BASE_MANA = 25;
-const int BASE_STRENGTH = 25;
-
 class Monster : public Entity {
 public:
     Monster(const Position &pos, int curlvl, MonsterType _type);
@@ -68,7 +65,7 @@ private:
     int scaleArmor;
 
     Position pos;
-    std::string name;
+    const char *name; // Interned in Balance::monsterName
     MonsterType type;
 };
 
@@ -1,21 +1,30 @@
 #ifndef Item_h
 #define Item_h
 
+#include "C:/DandD/include/Items/ItemNames.h"
+#include <cstdint>
 #include <iostream>
 
-enum class ItemType {
+enum class ItemType : uint8_t {
     WEAPON,
     ARMOR,
     SPELL
 };
 
+// Index into the rarity tiers of the loot tables; 0 is the plainest tier
+using ItemRarity = uint8_t;
+
+// Plain value (16 bytes, trivially copyable): the type is a tag and the name an interned id,
+// so items are passed, stored and swapped by value with no heap allocation and no virtual destructor.
 class Item {
 public:
     Item(const std::string &n, double _bonus, int _level, ItemType _type);
 
-    virtual ~Item() = default;
+    Item(ItemNameId _nameId, double _bonus, int _level, ItemType _type, ItemRarity _rarity = 0);
+
+    const std::string &GetName() const;
 
-    std::string GetName() const;
+    ItemNameId GetNameId() const;
 
     void SetName(const std::string &name);
 
@@ -27,16 +36,19 @@ public:
 
     void SetLevel(int level);
 
-    std::string GetTypeStr() const;
+    const char *GetTypeStr() const;
 
     ItemType GetType() const;
 
+    ItemRarity GetRarity() const;
+
 protected:
-    std::string name;
     double bonus = 0;
     int level = 1;
+    ItemNameId nameId;
 
     ItemType type;
+    ItemRarity rarity = 0; // Fits in what used to be padding
 };
 
 #endif //Item_h
@@ -0,0 +1,29 @@
+#ifndef ITEMNAMES_H
+#define ITEMNAMES_H
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <unordered_map>
+
+using ItemNameId = uint16_t;
+
+// Interned item names: every distinct name is stored once and items carry its 16-bit id,
+// so copying, swapping or comparing items never touches a string.
+class ItemNames {
+public:
+    // Id of the name, adding it on first use
+    static ItemNameId Intern(const std::string &name);
+
+    static const std::string &Get(ItemNameId id);
+
+    static size_t Count();
+
+private:
+    static constexpr size_t MAX_NAMES = 0x10000;
+
+    inline static std::deque<std::string> names; // Deque: references handed out by Get stay valid
+    inline static std::unordered_map<std::string, ItemNameId> ids;
+};
+
+#endif //ITEMNAMES_H
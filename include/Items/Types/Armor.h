@@ -6,6 +6,9 @@
 class Armor : public Item {
 public:
     Armor(const std::string &n, double _bonus, int _level);
+
+    // Same item seen as a armor; the caller has checked its type
+    explicit Armor(const Item &item);
 };
 
 #endif //Armor_h
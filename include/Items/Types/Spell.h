@@ -6,6 +6,9 @@
 class Spell : public Item {
 public:
     Spell(const std::string &n, double _bonus, int _level);
+
+    // Same item seen as a spell; the caller has checked its type
+    explicit Spell(const Item &item);
 };
 
 #endif //Spell_h
@@ -6,6 +6,9 @@
 class Weapon : public Item {
 public:
     Weapon(const std::string &n, double _bonus, int _level);
+
+    // Same item seen as a weapon; the caller has checked its type
+    explicit Weapon(const Item &item);
 };
 
 #endif //Weapon_h
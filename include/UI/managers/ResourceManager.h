@@ -0,0 +1,76 @@
+#ifndef RESOURCEMANAGER_H
+#define RESOURCEMANAGER_H
+
+#include "raylib.h"
+#include "C:/DandD/include/Utils/WorkerPool.h"
+#include <functional>
+#include <future>
+#include <string>
+#include <unordered_map>
+
+// Textures and fonts loaded from disk, shared by everyone who asks for the same file.
+// Paths are resolved to one canonical form first, so "walls4", "walls4.png" and "./walls4.png" are one load.
+// Each Acquire hands back the shared resource and takes a reference; the last Release unloads it.
+// Texture files are decoded on a worker pool; the main thread only uploads them, a few per frame.
+class ResourceManager {
+public:
+    static constexpr int UPLOADS_PER_FRAME = 2; // Keeps any one frame from stalling on big uploads
+
+    // The texture lives in the manager and stays empty (id 0) until its file is decoded and uploaded,
+    // so callers keep a pointer to it and treat id 0 as "not there yet". A file that fails to load stays empty.
+    static const Texture2D &AcquireTexture(const std::string &path);
+
+    static void ReleaseTexture(const Texture2D &texture);
+
+    // Whether the texture's file could not be decoded, as opposed to still being on its way
+    static bool HasFailed(const Texture2D &texture);
+
+    // Uploads up to maxUploads decoded textures; call once per frame from the main thread
+    static void UploadDecoded(int maxUploads = UPLOADS_PER_FRAME);
+
+    static bool HasPendingUploads();
+
+    // Runs a CPU-only image job, such as a decode, on the worker pool
+    static std::future<Image> DecodeAsync(std::function<Image()> decode);
+
+    // Loaded at once, as raylib builds the glyph texture together with the glyphs.
+    // A file that fails to load gives raylib's default font, which Release ignores.
+    static Font AcquireFont(const std::string &path);
+
+    static void ReleaseFont(const Font &font);
+
+    // Canonical form of a path; with no extension and no such file, the default extension is tried
+    static std::string Resolve(const std::string &path, const char *defaultExtension = "");
+
+    // Unloads whatever is still held and stops the workers, e.g. at shutdown
+    static void Clear();
+
+    static size_t TextureCount() { return textures.size(); }
+
+    static size_t FontCount() { return fonts.size(); }
+
+private:
+    struct TextureEntry {
+        Texture2D texture;
+        std::future<Image> decoded; // Valid until the image has been uploaded
+        bool failed;
+        int references;
+    };
+
+    struct FontEntry {
+        Font font;
+        int references;
+    };
+
+    static WorkerPool &GetPool();
+
+    // By resolved path, plus the way back from a handed-out texture or font for Release.
+    // Map nodes never move, so the textures handed out stay put while entries come and go.
+    inline static std::unordered_map<std::string, TextureEntry> textures;
+    inline static std::unordered_map<const Texture2D *, std::string> texturePaths;
+    inline static std::unordered_map<std::string, FontEntry> fonts;
+    inline static std::unordered_map<unsigned int, std::string> fontPaths;
+    inline static WorkerPool *decodePool = nullptr;
+};
+
+#endif //RESOURCEMANAGER_H
@@ -16,11 +16,13 @@
 #include "C:/DandD/include/Entities/Hero.h"
 #include "C:/DandD/include/Entities/Monster.h"
 #include "C:/DandD/include/Core/MapSystem.h"
+#include "C:/DandD/include/Core/ReplayRecorder.h"
 #include "C:/DandD/include/Utils/Attack.h"
 #include "C:/DandD/include/Items/Item.h"
 #include <string>
 #include <vector>
 #include <memory>
+#include <optional>
 
 enum class UIState {
     MAIN_MENU,
@@ -33,6 +35,13 @@ enum class UIState {
     DEFEAT
 };
 
+// How often the current screen has to be redrawn when the player is not interacting with it
+enum class RedrawNeed {
+    NONE, // Static: redraw only on input or a state change
+    AMBIENT, // Slow looping effects (bar pulse, portals, blinking cursor): a low redraw rate is enough
+    EVERY_FRAME // Something is mid-transition
+};
+
 struct Portal {
     Position position;
     bool isActive;
@@ -59,6 +68,16 @@ public:
 
     void Update(float deltaTime);
 
+    // Fixed-rate part of the update (camera follow); Update stays once per frame for input and panels
+    void FixedUpdate(float tickTime);
+
+    // Where the frame falls between the last two fixed updates, 0..1
+    void SetRenderInterpolation(float alpha) const;
+
+    int GetMapTileDrawCalls() const;
+
+    RedrawNeed GetRedrawNeed() const;
+
     void Draw() const;
 
     void SetState(UIState newState);
@@ -95,7 +114,7 @@ public:
 
     void OnCharacterSelectionBack();
 
-    void StartBattle(Hero *hero, Monster *monster);
+    void StartBattle(Hero *hero, MonsterHandle monster);
 
     void EndBattle();
 
@@ -103,6 +122,11 @@ public:
 
     BattleResult GetBattleResult() const;
 
+    // Difficulty chosen in the options menu, and the one the battle system searches with
+    MonsterDifficulty GetMonsterDifficulty() const;
+
+    void SetMonsterDifficulty(MonsterDifficulty difficulty);
+
     void ShowEquipmentChoice(const Item *newItem);
 
     void HideEquipmentPanel();
@@ -125,17 +149,27 @@ public:
 
     void SetAttackSystem(Attack *attackSystem);
 
+    // Battle, level up and equipment inputs are forwarded to the recorder
+    void SetReplayRecorder(ReplayRecorder *recorder);
+
     void UpdateHUDStats();
 
     void UpdateMapRenderer();
 
+    // Fog of war for the map renderer; call after Initialize
+    void SetFieldOfView(const FieldOfView *fov);
+
+    // Map cell under a screen point, e.g. the mouse; false when the point is not over the map
+    bool ScreenToMapCell(Vector2 screenPos, Position &cell) const;
+
     bool IsPositionWall(const Position &pos) const;
 
     void SetOnRaceSelected(std::function<void(Race)> callback) {
         onRaceSelectedCallback = callback;
     }
 
-    void ShowEquipmentChoice(std::unique_ptr<Item> newItem);
+    // Keeps its own copy of the found item until it is equipped or declined
+    void ShowEquipmentChoice(const Item &newItem);
 
     void ReinitializeGameHUD();
 
@@ -155,13 +189,15 @@ private:
     LevelUpPanel *levelUpPanel;
     EquipmentPanel *equipmentPanel;
     MapRenderer *mapRenderer;
+    TextureAtlas *spriteAtlas; // Map, entity and HUD sprites in one texture
 
     Hero *hero;
     Map *currentMap;
     Attack *attackSystem;
-    Monster *currentBattleMonster;
+    MonsterHandle currentBattleMonster;
     BattleSystem *battleSystem;
     DefeatPanel *defeatPanel;
+    ReplayRecorder *replayRecorder;
 
     Race selectedRace;
 
@@ -170,7 +206,8 @@ private:
     bool levelComplete;
     bool portalCreated;
 
-    std::unique_ptr<Item> pendingItem;
+    std::optional<Item> pendingItem;
+    std::optional<Item> bossDrop; // Rolled when a boss falls, offered once the battle screen is gone
 
     std::string mapFilePath;
 
@@ -217,6 +254,10 @@ private:
 
     void InitializeGameplay();
 
+    void UploadLoadedResources() const;
+
+    void BuildSpriteAtlas() const;
+
 
     void CleanupGameplay();
 
@@ -236,6 +277,8 @@ private:
 
     void OnBattleEnd(BattleResult result);
 
+    void ShowBossDrop();
+
     bool CheckForBattle(const Position &newPosition);
 };
 
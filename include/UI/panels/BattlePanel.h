@@ -11,8 +11,8 @@
 #include "C:/DandD/include/Entities/Hero.h"
 #include "C:/DandD/include/Entities/Monster.h"
 #include "C:/DandD/include/Core/BattleSystem.h"
+#include <cstddef>
 #include <string>
-#include <vector>
 
 
 enum class BattleState {
@@ -64,7 +64,6 @@ private:
     Button spellButton;
     Button fleeButton;
 
-    std::vector<std::string> battleLog;
     int maxLogLines;
     float logScrollOffset;
 
@@ -96,9 +95,8 @@ private:
 
     void drawHealthBars() const;
 
-    void addLogEntry(const std::string &entry);
-
-    void clearLog();
+    // Formats a battle event into a display line; returns false for events with no text
+    bool formatLogEntry(const BattleEvent &event, char *buffer, size_t bufferSize) const;
 
     void onWeaponAttack();
 
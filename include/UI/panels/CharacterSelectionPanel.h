@@ -53,7 +53,8 @@ private:
     int screenWidth;
     int screenHeight;
 
-    Texture2D backgroundTexture;
+    const Texture2D *backgroundTexture; // Shared through the resource manager; empty until it has loaded
+    Texture2D fallbackTexture; // The gradient shown if the file fails, owned here
 
     std::vector<RaceData> races;
 
@@ -84,6 +85,10 @@ private:
 private:
     void LoadBackgroundImage();
 
+    void GenerateFallbackBackground();
+
+    void ReleaseBackgroundImage();
+
     void InitializeRaceData();
 
     void CreateRaceButtons();
@@ -5,7 +5,9 @@
 #ifndef MAPRENDERER_H
 #define MAPRENDERER_H
 
+#include "C:/DandD/include/Core/FieldOfView.h"
 #include "C:/DandD/include/Core/MapSystem.h"
+#include "C:/DandD/include/UI/renderers/TextureAtlas.h"
 #include "raylib.h"
 #include <vector>
 
@@ -17,43 +19,98 @@ public:
 
     void Initialize(Map *mapRef, Position *heroPosition);
 
+    // Fog of war source; without one the whole map is drawn
+    void SetFieldOfView(const FieldOfView *fov);
+
+    // Queues the map, entity and object sprites; they are drawn once the atlas is built
+    void RegisterSprites(TextureAtlas &atlas);
+
     void LoadResources();
 
     void Unload();
 
+    // One fixed simulation step: the camera moves towards the hero
     void Update(float deltaTime);
 
+    // Places the drawn camera between the last two steps (alpha 0..1), so motion stays smooth at any frame rate
+    void Interpolate(float alpha);
+
+    // The camera is still gliding after the hero
+    bool IsCameraMoving() const;
+
     void Draw() const;
 
     void DrawPortal(const Position &position, float animationTime) const;
 
     float GetCellSize() const;
 
+    // Zooms about the view's centre; the on-screen map area keeps its size, so the visible cell count follows.
+    // Ranges from MAX_CELL_SIZE down to the whole level in view.
     void SetCellSize(float size);
 
+    // Zooms by mouse wheel steps; positive is closer
+    void Zoom(float steps);
+
     void SetVisibleRange(int cellsX, int cellsY);
 
     Vector2 WorldToScreen(int worldX, int worldY) const;
 
-    void removeMonster(const Monster *monster);
+    // Map cell under a screen point; false outside the drawn map area or the map bounds
+    bool ScreenToWorld(Vector2 screenPos, Position &worldPos) const;
+
+    void removeMonster(const Position &monsterPos);
+
+    // Chunk blits and re-bakes issued by the last frame's tile layer
+    int GetTileDrawCalls() const;
+
+    // Switches the minimap between the area around the hero and the whole level
+    void ToggleMinimapOverview();
+
+    bool IsMinimapOverview() const;
 
 private:
+    static constexpr int CHUNK_CELLS = 16; // Tile layer chunks are this many cells on a side
+    static constexpr size_t MAX_BAKED_CHUNK_BYTES = 64u << 20; // Texture memory kept by baked chunks
+
+    static constexpr float MAX_CELL_SIZE = 100.0f;
+    static constexpr float ZOOM_STEP = 1.15f; // Cell size factor per wheel step
+    static constexpr float TEXTURED_DETAIL_CELL = 12.0f; // Below this cell size tiles are flat colours
+    static constexpr float RASTER_DETAIL_CELL = 3.0f; // Below this the minimap raster stands in for the map
+
+    // Level of detail of the tile layer, picked from the cell size. The first two bake chunks (sprites or flat
+    // quads); the raster is one quad from the minimap texture, whatever the number of cells in view.
+    enum class TileDetail { TEXTURED, FLAT, RASTER };
+
+    // The tile layer baked into render textures, one per chunk of the map. A chunk is baked the first time it
+    // is on screen, and again only when Map::setCell changes a cell in it or the fog over it moves. Off-screen
+    // chunks stay baked for panning back until they outgrow MAX_BAKED_CHUNK_BYTES, least recently seen first.
+    struct TileChunk {
+        RenderTexture2D target;
+        bool dirty;
+        uint32_t lastSeenFrame; // Value of tileFrame when the chunk was last on screen
+    };
+
     Map *map;
     Position *heroPosition;
+    const FieldOfView *fieldOfView;
 
     int screenWidth, screenHeight;
     float cellSize;
     bool resourcesLoaded;
 
     struct Camera {
-        Vector2 position;
+        Vector2 position; // As drawn: between previous and current
+        Vector2 previous; // Simulated position one step ago
+        Vector2 current; // Simulated position
         Vector2 target;
-        int visibleCellsX;
+        int visibleCellsX; // Whole cells touched by the view, rounded up
         int visibleCellsY;
+        float viewWidth; // On-screen map area in pixels; zooming keeps it
+        float viewHeight;
         float smoothFactor;
 
-        Camera() : position{0, 0}, target{0, 0},
-                   visibleCellsX{0}, visibleCellsY{0},
+        Camera() : position{0, 0}, previous{0, 0}, current{0, 0}, target{0, 0},
+                   visibleCellsX{0}, visibleCellsY{0}, viewWidth{0}, viewHeight{0},
                    smoothFactor{0.05f} {
         }
     } camera;
@@ -68,22 +125,75 @@ private:
         }
     } visibleArea;
 
-    Texture2D floorTexture;
-    Texture2D wallTexture;
-    Texture2D heroTexture;
-    Texture2D monsterTexture;
-    Texture2D bossTexture;
-    Texture2D treasureTexture;
-    Texture2D portalTexture;
+    mutable std::vector<TileChunk> tileChunks; // Row-major, chunksX per row
+    mutable std::vector<int> bakedChunks; // Indices of the chunks holding a render texture
+    mutable uint32_t tileFrame; // Counts BakeVisibleChunks calls, for the chunks' last-seen stamps
+    mutable int chunksX;
+    mutable int chunksY;
+    mutable int bakedCellPixels; // Cell size the chunks were baked at
+    mutable TileDetail bakedDetail;
+    mutable uint32_t bakedMapGeneration;
+    mutable size_t bakedTileChanges; // Entries of Map::GetTileChanges already applied
+    mutable uint32_t bakedFovCount;
+    mutable Position bakedFovOrigin;
+    mutable int tileDrawCalls;
+
+    mutable std::vector<size_t> visibleEntities; // Reused by DrawEntities' area queries
+
+    // The whole level at one texel per cell: explored tiles plus entity dots. Kept on the CPU and patched only
+    // where the map, the fog or an entity changed; the texture is re-uploaded only when a patch happened.
+    mutable struct MinimapRaster {
+        Texture2D texture;
+        std::vector<Color> pixels; // Row-major, one per cell
+        std::vector<int> entityCells; // Cells currently showing an entity dot instead of their tile
+        std::vector<Color> uploadBuffer; // Dirty rectangle, packed for the upload
+        int width, height;
+        int dirtyMinX, dirtyMinY, dirtyMaxX, dirtyMaxY; // Inclusive; empty when min > max
+        uint32_t mapGeneration;
+        size_t tileChanges; // Entries of Map::GetTileChanges already applied
+        uint32_t fovCount;
+        Position heroPos;
+        size_t treasureCount;
+        bool overview;
+
+        MinimapRaster() : texture{}, width(0), height(0), dirtyMinX(0), dirtyMinY(0), dirtyMaxX(-1), dirtyMaxY(-1),
+                          mapGeneration(0), tileChanges(0), fovCount(0), heroPos(-1, -1), treasureCount(0),
+                          overview(false) {
+        }
+    } minimap;
+
+    const TextureAtlas *atlas;
+    SpriteId floorSprite;
+    SpriteId wallSprite;
+    SpriteId heroSprite;
+    SpriteId monsterSprite;
+    SpriteId bossSprite;
+    SpriteId treasureSprite;
+    SpriteId portalSprite;
 
     Font gameFont;
 
     const Color BACKGROUND_COLOR = {20, 20, 35, 255};
     const Color BORDER_COLOR = {80, 80, 120, 255};
     const Color BORDER_GLOW = {100, 100, 180, 150};
+    const Color FOG_TINT = {90, 90, 110, 255}; // Explored cells outside the hero's sight
 
 private:
-    void UpdateCamera();
+    void UpdateCamera(float deltaTime);
+
+    // Cells covered by the map area at the current zoom, fractional
+    Vector2 GetViewCells() const;
+
+    // Keeps the view on the map; a level smaller than the view is centred in it
+    Vector2 ClampCamera(Vector2 position) const;
+
+    float GetMinCellSize() const;
+
+    TileDetail GetTileDetail() const;
+
+    // Chunk bake resolution: the cell size rounded up to the next step of a fixed ladder, so zooming re-bakes only
+    // now and then
+    int GetBakeCellPixels() const;
 
     void UpdateVisibleArea() const;
 
@@ -91,23 +201,60 @@ private:
 
     bool IsInVisibleArea(int x, int y) const;
 
+    bool IsCellInSight(int x, int y) const;
+
+    bool IsCellExplored(int x, int y) const;
+
+    void BakeVisibleChunks() const;
+
     void DrawTiles() const;
 
+    void DrawTileRaster() const;
+
+    void SyncTileChunks() const;
+
+    // Marks every chunk touching the cells from (minX, minY) to (maxX, maxY), inclusive
+    void MarkChunksDirty(int minX, int minY, int maxX, int maxY) const;
+
+    void BakeChunk(int chunkX, int chunkY) const;
+
+    // Releases the least recently seen off-screen chunks while the baked ones exceed MAX_BAKED_CHUNK_BYTES
+    void EvictTileChunks() const;
+
+    void ReleaseTileChunks() const;
+
+    SpriteId GetTileSprite(char cellType) const;
+
     void DrawEntities() const;
 
     void DrawMapBorder() const;
 
-    void DrawTexturedTile(const Texture2D &texture, const Vector2 &screenPos) const;
+    void DrawTexturedTile(SpriteId sprite, const Vector2 &screenPos, float size, Color tint = WHITE) const;
+
+    void DrawSprite(SpriteId sprite, const Position &cell) const;
 
     void DrawMinimap() const;
 
     void DrawMinimapBackground(Vector2 pos, float size) const;
 
-    void DrawMinimapTiles(Vector2 pos, float size, float cellSize) const;
+    // Cells shown in the minimap: a window around the hero clamped to the map, or the whole level in overview
+    Rectangle GetMinimapWindow() const;
+
+    void SyncMinimap() const;
+
+    void RebuildMinimap() const;
+
+    Color GetMinimapTileColor(int x, int y) const;
+
+    void SetMinimapPixel(int x, int y, Color color) const;
+
+    void PaintMinimapEntities() const;
+
+    void UploadMinimap() const;
 
-    void DrawMinimapEntities(Vector2 pos, float size, float cellSize) const;
+    void ReleaseMinimap() const;
 
-    void DrawMinimapViewport(Vector2 pos, float size, float cellSize) const;
+    void DrawMinimapViewport(Rectangle dest, Rectangle window) const;
 };
 
 #endif //MAPRENDERER_H
@@ -0,0 +1,57 @@
+#ifndef TEXTCACHE_H
+#define TEXTCACHE_H
+
+#include "raylib.h"
+#include <cstdint>
+#include <list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Measured sizes and laid-out glyph quads of recently drawn strings, keyed by (font, size, spacing, text).
+// A string drawn again skips UTF-8 decoding, glyph lookup and measuring: drawing is one textured quad per glyph
+// straight from the cache. Entries are least-recently-used evicted; changed text is simply a new key.
+class TextCache {
+public:
+    static constexpr size_t CAPACITY = 512;
+
+    // Same result as MeasureTextEx
+    static Vector2 Measure(const Font &font, std::string_view text, float fontSize, float spacing);
+
+    // Same output as DrawTextEx
+    static void Draw(const Font &font, std::string_view text, Vector2 position, float fontSize, float spacing,
+                     Color tint);
+
+    // Drop everything, e.g. when fonts are unloaded and their texture ids may be reused
+    static void Clear();
+
+    static size_t Size();
+
+private:
+    struct GlyphQuad {
+        Rectangle source; // In the font texture
+        Rectangle dest; // Relative to the text's position
+    };
+
+    struct Entry {
+        uint64_t key;
+        unsigned int fontTexture;
+        int fontBaseSize;
+        float fontSize;
+        float spacing;
+        std::string text;
+        Vector2 size;
+        std::vector<GlyphQuad> quads;
+        bool drawable; // False for multi-line text, which is drawn by raylib directly
+    };
+
+    inline static std::list<Entry> entries; // Most recently used first
+    inline static std::unordered_map<uint64_t, std::list<Entry>::iterator> index;
+
+    static const Entry &Find(const Font &font, std::string_view text, float fontSize, float spacing);
+
+    static void Layout(const Font &font, Entry &entry);
+};
+
+#endif //TEXTCACHE_H
@@ -0,0 +1,62 @@
+#ifndef TEXTUREATLAS_H
+#define TEXTUREATLAS_H
+
+#include "raylib.h"
+#include <cstdint>
+#include <future>
+#include <string>
+#include <vector>
+
+using SpriteId = uint16_t;
+
+// Small images packed into one texture at load time, with a table of source rectangles by sprite id.
+// Sprites drawn back to back then share a texture, so raylib's batcher merges them into one draw call.
+class TextureAtlas {
+public:
+    static constexpr SpriteId INVALID_SPRITE = 0xFFFF;
+    static constexpr int MAX_SPRITE_SIZE = 256; // Larger images are scaled down to fit; cells are drawn far smaller
+    static constexpr int PADDING = 2; // Transparent gap between sprites, so neighbours never bleed in
+
+    TextureAtlas();
+
+    ~TextureAtlas();
+
+    // Queues an image file for decoding on the worker pool and returns its id; the rectangle is known once Build
+    // has run. A file that fails to load gives a sprite that draws nothing, like an unloaded texture.
+    SpriteId Add(const std::string &filePath);
+
+    // Whether every queued image is decoded, so Build would not have to wait
+    bool IsDecoded() const;
+
+    // Packs every queued image into one texture (shelf packing, tallest first) and frees the images
+    void Build();
+
+    bool IsBuilt() const { return built; }
+
+    void Unload();
+
+    // Routes raylib's shape drawing through a white texel of the atlas, so rectangles and lines batch with sprites
+    void UseForShapes() const;
+
+    void Draw(SpriteId sprite, Rectangle dest, Color tint = WHITE) const;
+
+    bool IsValid(SpriteId sprite) const;
+
+    const Texture2D &GetTexture() const { return texture; }
+
+    Rectangle GetSource(SpriteId sprite) const;
+
+private:
+    struct Sprite {
+        Image image; // Only until Build
+        Rectangle source;
+        std::future<Image> decoded; // Until Build collects it
+    };
+
+    std::vector<Sprite> sprites;
+    Texture2D texture;
+    SpriteId whiteSprite;
+    bool built;
+};
+
+#endif //TEXTUREATLAS_H
@@ -8,6 +8,7 @@
 #include "raylib.h"
 #include "C:/DandD/include/UI/widgets/ProgressBar.h"
 #include "C:/DandD/include/UI/widgets/Button.h"
+#include "C:/DandD/include/UI/renderers/TextureAtlas.h"
 #include "../../Entities/Hero.h"
 #include "C:/DandD/include/Items/Types/Weapon.h"
 #include "C:/DandD/include/Items/Types/Armor.h"
@@ -33,12 +34,21 @@ public:
 
     void SetTreasuresRemaining(int count);
 
+    // Queues the frame and equipment icons; ApplyButtonSprites hands them to the buttons once the atlas is built
+    void RegisterSprites(TextureAtlas &atlas);
+
     void LoadResources();
 
+    // Points the equipment buttons at their atlas sprites; called again when the atlas is built after loading
+    void ApplyButtonSprites();
+
     void Update(float deltaTime);
 
     void Draw() const;
 
+    // HP or XP bar still animating towards a new value; the slow pulse does not count
+    bool IsTransitioning() const;
+
     void Unload();
 
     void RefreshInventoryDisplay();
@@ -66,12 +76,13 @@ private:
 
     Font hudFont{};
 
-    Texture2D hudTexture{};
-    Texture2D frameTexture{};
-    Texture2D characterIconTexture{};
-    Texture2D armorIconTexture{};
-    Texture2D weaponIconTexture{};
-    Texture2D spellIconTexture{};
+    const Texture2D *hudTexture = nullptr; // Screen-sized background, too large for the atlas; shared, loads late
+
+    const TextureAtlas *atlas = nullptr;
+    SpriteId frameSprite = TextureAtlas::INVALID_SPRITE;
+    SpriteId armorIconSprite = TextureAtlas::INVALID_SPRITE;
+    SpriteId weaponIconSprite = TextureAtlas::INVALID_SPRITE;
+    SpriteId spellIconSprite = TextureAtlas::INVALID_SPRITE;
 
     Color frameColor{};
     Color textColor{};
@@ -87,9 +98,21 @@ private:
     int monstersRemaining;
     int treasuresRemaining;
 
-    bool backgroundLoaded;
+
+    // Stat texts, rebuilt only when the hero's stats version moves
+    std::string strengthText;
+    std::string manaText;
+    uint32_t shownStatsVersion;
+    bool statsTextValid;
+
+    // Level info lines, rebuilt by their setters when the number changes
+    std::string levelText;
+    std::string monstersText;
+    std::string treasuresText;
 
 private:
+    void RefreshStatsText();
+
     void DrawBackground() const;
 
     void DrawFrame() const;
@@ -9,6 +9,7 @@
 #include <vector>
 #include <functional>
 #include "C:/DandD/include/UI/widgets/Button.h"
+#include "C:/DandD/include/Core/BattleSystem.h"
 
 class MainMenu {
 public:
@@ -40,6 +41,14 @@ public:
 
     void ResetSelections();
 
+    // Options: battles are either played through the battle panel or resolved instantly
+    bool IsAutoBattleEnabled() const;
+
+    BattlePolicy GetAutoBattlePolicy() const;
+
+    // How far ahead monsters search their attacks; applied when a run starts
+    MonsterDifficulty GetMonsterDifficulty() const;
+
 private:
     int screenWidth;
     int screenHeight;
@@ -50,6 +59,9 @@ private:
     Button creditsButton;
     Button quitButton;
     Button backButton;
+    Button battleModeButton;
+    Button battlePolicyButton;
+    Button difficultyButton;
 
     MenuState currentState;
 
@@ -57,10 +69,14 @@ private:
     bool startGameSelected;
     bool loadGameSelected;
 
+    bool autoBattleEnabled;
+    BattlePolicy autoBattlePolicy;
+    MonsterDifficulty monsterDifficulty;
+
     Font menuFont{};
-    Texture2D backgroundTexture{};
-    Texture2D titleTexture{};
-    Texture2D menuFrameTexture{};
+    // Shared through the resource manager; empty until their files are decoded and uploaded
+    const Texture2D *backgroundTexture = nullptr;
+    const Texture2D *titleTexture = nullptr;
 
     Color frameColor{};
     Color textColor{};
@@ -87,6 +103,8 @@ private:
 
     void CreateButtons();
 
+    void UpdateOptionLabels();
+
     void HandleMainMenuInput();
 
     void HandleOptionsMenuInput();
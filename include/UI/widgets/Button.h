@@ -17,8 +17,13 @@ public:
 
     void SetFont(const Font &customFont);
 
+    void SetText(const std::string &text);
+
     void SetTexture(const Texture2D &customTexture);
 
+    // Draws only this part of the texture, e.g. one sprite of an atlas
+    void SetTexture(const Texture2D &customTexture, Rectangle source);
+
     void SetColors(Color normal, Color hover, Color pressed, Color text);
 
     void SetBorder(Color color, int thickness = 1);
@@ -47,6 +52,7 @@ private:
     std::string label;
     Font font;
     Texture2D texture;
+    Rectangle textureSource; // Empty means the whole texture
     std::function<void()> action;
 
     bool isHovered;
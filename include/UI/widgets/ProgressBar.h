@@ -32,6 +32,9 @@ public:
 
     float GetPercentage() const;
 
+    // True while the drawn value is still sliding towards the target
+    bool IsTransitioning() const;
+
     void SetTransitionSpeed(float speed);
 
     void SetColors(Color background, Color foreground, Color border);
@@ -93,7 +96,13 @@ private:
     float pulseSpeed;
     float pulseTime;
 
-    std::string GetFormattedText() const;
+    // Last formatted text and the values it shows; the formatter only runs again when they change
+    mutable std::string formattedText;
+    mutable float formattedValue = 0.0f;
+    mutable float formattedMax = 0.0f;
+    mutable bool formattedValid = false;
+
+    const std::string &GetFormattedText() const;
 };
 
 #endif // PROGRESSBAR_H
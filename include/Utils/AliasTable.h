@@ -0,0 +1,35 @@
+#ifndef ALIASTABLE_H
+#define ALIASTABLE_H
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+// Walker's alias method: a weighted choice among n entries in O(1) per draw, whatever n is.
+// Built once in O(n) (Vose's variant); each column holds its own entry up to a threshold and
+// one alias entry above it, so a draw is one column pick plus one coin flip.
+class AliasTable {
+public:
+    AliasTable() = default;
+
+    // Weights need not sum to one; throws if there are none, any is negative, or all are zero
+    explicit AliasTable(const std::vector<double> &weights);
+
+    void Build(const std::vector<double> &weights);
+
+    size_t Sample(std::mt19937 &gen) const;
+
+    size_t Size() const { return alias.size(); }
+
+    // Chance of drawing the entry, as given by the weights it was built from
+    double Probability(size_t index) const { return probability[index]; }
+
+private:
+    static constexpr uint64_t COIN_RANGE = 1ull << 32; // One 32-bit engine output per coin flip
+
+    std::vector<uint64_t> threshold; // Keep the column's own entry when the coin is below this
+    std::vector<uint32_t> alias;
+    std::vector<double> probability;
+};
+
+#endif //ALIASTABLE_H
@@ -4,8 +4,9 @@
 #include "C:/DandD/include/Entities/Entity.h"
 #include "C:/DandD/include/Entities/Hero.h"
 #include "C:/DandD/include/Entities/Monster.h"
+#include <cstdint>
 
-enum class AttackType {
+enum class AttackType : uint8_t {
     WEAPON,
     SPELL
 };
@@ -16,23 +17,33 @@ public:
 
     double performAttack(const Entity &attacker, Entity &defender, AttackType type);
 
+    // Damage an attack would deal, without rolling for a critical hit or applying it
+    double estimateDamage(const Entity &attacker, const Entity &defender, AttackType type, bool criticalHit) const;
+
+    int getCriticalHitChance() const;
+
     void rewardExperience(Hero &player, const Monster &monster);
 
     std::string getAttackName(const Entity &attacker, AttackType type);
 
     bool checkCriticalHit();
 
+    // Whether the most recent performAttack call rolled a critical hit
+    bool wasLastAttackCritical() const;
+
 private:
     const int CRITICAL_HIT_CHANCE = 25;
 
     bool isPlayerTurn;
 
+    bool lastAttackCritical;
+
 private:
-    double calculateBaseAttack(float baseStat, float bonus, float armorReduction);
+    double calculateBaseAttack(float baseStat, float bonus, float armorReduction) const;
 
-    double calculateWeaponAttack(const Entity &attacker, const Entity &defender);
+    double calculateWeaponAttack(const Entity &attacker, const Entity &defender) const;
 
-    double calculateSpellAttack(const Entity &attacker, const Entity &defender);
+    double calculateSpellAttack(const Entity &attacker, const Entity &defender) const;
 
     bool isCriticalHit() const;
 };
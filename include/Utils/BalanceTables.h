@@ -0,0 +1,152 @@
+#ifndef BALANCETABLES_H
+#define BALANCETABLES_H
+
+#include "C:/DandD/include/Items/Item.h"
+#include <algorithm>
+#include <array>
+
+// Balance curves for monsters, loot and experience, generated at compile time.
+// Lookups are plain array loads indexed by level (and item type); levels outside the table are clamped.
+namespace Balance {
+    constexpr int MIN_LEVEL = 1;
+    constexpr int MAX_LEVEL = 99; // Far beyond the shipped maps, which stop at level 8
+
+    constexpr int MONSTER_BASE_HEALTH = 50;
+    constexpr int MONSTER_BASE_STRENGTH = 25;
+    constexpr int MONSTER_BASE_MANA = 25;
+    constexpr int MONSTER_LEVEL_BONUS = 10; // Linear scaling per level
+    constexpr int ARMOR_CAP_LEVEL = 17; // Armor scaling caps at this level
+    constexpr int ARMOR_CAP = 95;
+
+    struct MonsterStats {
+        int health;
+        int strength;
+        int mana;
+        int armor; // Damage resist in percent
+        int experience; // Awarded to the hero for the kill
+    };
+
+    struct BonusRange {
+        double min;
+        double max;
+    };
+
+    constexpr int clampLevel(const int level) {
+        return level < MIN_LEVEL ? MIN_LEVEL : (level > MAX_LEVEL ? MAX_LEVEL : level);
+    }
+
+    constexpr MonsterStats computeMonsterStats(const int level) {
+        const int levelBonus = (level - 1) * MONSTER_LEVEL_BONUS;
+        const int strength = MONSTER_BASE_STRENGTH + levelBonus;
+
+        return {
+            MONSTER_BASE_HEALTH + levelBonus,
+            strength,
+            MONSTER_BASE_MANA + levelBonus,
+            level < ARMOR_CAP_LEVEL ? 15 + level * 5 : ARMOR_CAP,
+            strength * 5 + level * 20
+        };
+    }
+
+    // Armor rolls in a narrow band, weapons and spells in a wider one that grows faster
+    constexpr BonusRange computeBonusRange(const ItemType type, const int level) {
+        const bool armor = type == ItemType::ARMOR;
+        const double growth = (level - 1) * (armor ? 4.0 : 15.0);
+
+        return armor
+                   ? BonusRange{5.0 + growth, 10.0 + growth}
+                   : BonusRange{20.0 + growth, 30.0 + growth};
+    }
+
+    // "Level N dragon" as a fixed-size, null-terminated buffer
+    using MonsterName = std::array<char, 20>;
+
+    constexpr MonsterName computeMonsterName(const int level) {
+        MonsterName name{};
+        const char prefix[] = "Level ";
+        const char suffix[] = " dragon";
+
+        size_t length = 0;
+        for (size_t i = 0; prefix[i] != '\0'; i++) name[length++] = prefix[i];
+
+        char digits[4] = {};
+        int digitCount = 0;
+        for (int value = level; value > 0 || digitCount == 0; value /= 10) {
+            digits[digitCount++] = static_cast<char>('0' + value % 10);
+        }
+        while (digitCount > 0) name[length++] = digits[--digitCount];
+
+        for (size_t i = 0; suffix[i] != '\0'; i++) name[length++] = suffix[i];
+
+        return name;
+    }
+
+    namespace detail {
+        constexpr size_t LEVEL_COUNT = MAX_LEVEL - MIN_LEVEL + 1;
+        constexpr size_t ITEM_TYPE_COUNT = 3;
+
+        constexpr std::array<MonsterStats, LEVEL_COUNT> buildMonsterTable() {
+            std::array<MonsterStats, LEVEL_COUNT> table{};
+            for (size_t i = 0; i < LEVEL_COUNT; i++) {
+                table[i] = computeMonsterStats(static_cast<int>(i) + MIN_LEVEL);
+            }
+            return table;
+        }
+
+        constexpr std::array<std::array<BonusRange, LEVEL_COUNT>, ITEM_TYPE_COUNT> buildBonusTable() {
+            std::array<std::array<BonusRange, LEVEL_COUNT>, ITEM_TYPE_COUNT> table{};
+            for (size_t t = 0; t < ITEM_TYPE_COUNT; t++) {
+                for (size_t i = 0; i < LEVEL_COUNT; i++) {
+                    table[t][i] = computeBonusRange(static_cast<ItemType>(t), static_cast<int>(i) + MIN_LEVEL);
+                }
+            }
+            return table;
+        }
+
+        constexpr std::array<MonsterName, LEVEL_COUNT> buildNameTable() {
+            std::array<MonsterName, LEVEL_COUNT> table{};
+            for (size_t i = 0; i < LEVEL_COUNT; i++) {
+                table[i] = computeMonsterName(static_cast<int>(i) + MIN_LEVEL);
+            }
+            return table;
+        }
+
+        inline constexpr auto MONSTER_TABLE = buildMonsterTable();
+        inline constexpr auto BONUS_TABLE = buildBonusTable();
+        inline constexpr auto NAME_TABLE = buildNameTable();
+    }
+
+    constexpr const MonsterStats &monsterStats(const int level) {
+        return detail::MONSTER_TABLE[clampLevel(level) - MIN_LEVEL];
+    }
+
+    constexpr const BonusRange &itemBonusRange(const ItemType type, const int level) {
+        return detail::BONUS_TABLE[static_cast<size_t>(type)][clampLevel(level) - MIN_LEVEL];
+    }
+
+    // Interned name: every monster of a level shares the same static string
+    constexpr const char *monsterName(const int level) {
+        return detail::NAME_TABLE[clampLevel(level) - MIN_LEVEL].data();
+    }
+
+    constexpr int experienceReward(const int level) {
+        return monsterStats(level).experience;
+    }
+
+    // Pinned balance numbers: changing a curve has to update these on purpose
+    static_assert(monsterStats(1).health == 50 && monsterStats(1).strength == 25 && monsterStats(1).mana == 25);
+    static_assert(monsterStats(8).health == 120 && monsterStats(8).strength == 95 && monsterStats(8).mana == 95);
+    static_assert(monsterStats(1).armor == 20 && monsterStats(8).armor == 55 && monsterStats(16).armor == 95);
+    static_assert(monsterStats(17).armor == ARMOR_CAP && monsterStats(MAX_LEVEL).armor == ARMOR_CAP);
+    static_assert(experienceReward(1) == 145 && experienceReward(8) == 635);
+    static_assert(monsterStats(0).health == monsterStats(1).health, "Levels below the table clamp to level 1");
+    static_assert(itemBonusRange(ItemType::ARMOR, 1).min == 5.0 && itemBonusRange(ItemType::ARMOR, 1).max == 10.0);
+    static_assert(itemBonusRange(ItemType::ARMOR, 8).min == 33.0 && itemBonusRange(ItemType::ARMOR, 8).max == 38.0);
+    static_assert(itemBonusRange(ItemType::WEAPON, 1).min == 20.0 && itemBonusRange(ItemType::WEAPON, 1).max == 30.0);
+    static_assert(itemBonusRange(ItemType::SPELL, 8).min == 125.0 && itemBonusRange(ItemType::SPELL, 8).max == 135.0);
+    static_assert(monsterName(1)[6] == '1' && monsterName(1)[7] == ' ' && monsterName(1)[14] == '\0');
+    static_assert(monsterName(12)[6] == '1' && monsterName(12)[7] == '2' && monsterName(12)[15] == '\0');
+    static_assert(monsterName(MAX_LEVEL)[16] == '\0', "Longest name fits the buffer");
+}
+
+#endif //BALANCETABLES_H
@@ -4,6 +4,7 @@
 #include "C:/DandD/include/Items/Types/Armor.h"
 #include "C:/DandD/include/Items/Types/Weapon.h"
 #include "C:/DandD/include/Items/Types/Spell.h"
+#include <cstdint>
 #include <optional>
 
 class Inventory {
@@ -16,16 +17,23 @@ public:
 
     bool newSpell(const Spell &replacement);
 
+    // Places the item into the slot matching its type
+    bool equip(const Item &item);
+
     const Armor &GetArmor() const;
 
     const Weapon &GetWeapon() const;
 
     const Spell &GetSpell() const;
 
+    // Bumped on every equipment change, so derived stats know when to recompute
+    uint32_t GetVersion() const;
+
 private:
     Armor armor;
     Weapon weapon;
     Spell spell;
+    uint32_t version;
 };
 
 #endif
@@ -9,14 +9,26 @@
 #include "C:/DandD/include/Items/Types/Armor.h"
 #include "C:/DandD/include/Items/Types/Spell.h"
 #include "C:/DandD/include/Items/Types/Weapon.h"
+#include "C:/DandD/include/Utils/BalanceTables.h"
+#include <cstdint>
 #include <random>
 #include <algorithm>
 #include <fstream>
 #include <unordered_map>
 
 namespace RandomUtils {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
+    // Single engine shared by every translation unit, so a recorded seed reproduces a whole run
+    inline uint32_t currentSeed = std::random_device{}();
+    inline std::mt19937 gen(currentSeed);
+
+    inline void seed(const uint32_t newSeed) {
+        currentSeed = newSeed;
+        gen.seed(newSeed);
+    }
+
+    inline uint32_t getSeed() {
+        return currentSeed;
+    }
 
     template<typename T>
     T randomValue(T min, T max) {
@@ -32,16 +44,35 @@ namespace RandomUtils {
 
 class ItemGenerator {
 public:
-    static Item *generateRandomItem(int level);
+    static constexpr const char *ITEMS_FILE_PATH = "C:/DandD/assets/equipment/items.txt";
 
-private:
-    static std::string chooseName(const std::vector<std::string> &names);
+    // Treasure drop: type and rarity come from the level's loot table, then a name and a bonus
+    static Item generateRandomItem(int level);
+
+    // Guaranteed drop for defeating a boss, from the level's boss loot table
+    static Item generateBossDrop(int level);
 
+    // Parses the items file once: name sections into a table indexed by (type, level), rarity tiers,
+    // and loot tables compiled to alias tables. Called at startup; the generators load the default file
+    // themselves if nobody did.
+    static void preloadTables(const std::string &filePath = ITEMS_FILE_PATH);
+
+    // Number of names in the table for one type and level (levels past the file reuse its last level)
+    static size_t nameCount(ItemType type, int level);
+
+    static size_t rarityCount();
+
+    static const std::string &rarityName(ItemRarity rarity);
+
+    // Chance that one drop at this level has the given type and rarity
+    static double dropChance(ItemType type, ItemRarity rarity, int level, bool boss);
+
+private:
     static std::string getEquipmentType(ItemType type);
 
-    static ItemType generateRandomType();
+    static Item rollItem(int level, bool boss);
 
-    static std::string generateRandomName(const std::string &filePath, ItemType type, int level);
+    static ItemNameId generateRandomName(ItemType type, int level);
 
     static double calculateBonus(ItemType type, int level);
 };
@@ -0,0 +1,39 @@
+#ifndef SPATIALGRID_H
+#define SPATIALGRID_H
+
+#include "C:/DandD/include/Utils/Position.h"
+#include <cstdint>
+#include <vector>
+
+// Uniform bucket index over map cells: ids are filed under the BUCKET_CELLS x BUCKET_CELLS square holding their
+// position, so a rectangle query only looks at the buckets it overlaps instead of every id.
+// The grid grows to fit whatever is inserted; negative coordinates are not indexed.
+class SpatialGrid {
+public:
+    static constexpr int BUCKET_CELLS = 8;
+
+    SpatialGrid();
+
+    void Clear();
+
+    void Insert(uint32_t id, const Position &pos);
+
+    void Remove(uint32_t id, const Position &pos);
+
+    // Refiles the id only when it crosses into another bucket
+    void Move(uint32_t id, const Position &from, const Position &to);
+
+    // Appends the ids of every bucket overlapping the inclusive cell rectangle. Buckets are coarser than cells,
+    // so callers still check the exact position of what comes back.
+    void Query(int minX, int minY, int maxX, int maxY, std::vector<uint32_t> &out) const;
+
+private:
+    std::vector<std::vector<uint32_t> > buckets; // Row-major, bucketsX by bucketsY
+    int bucketsX, bucketsY;
+
+    std::vector<uint32_t> *FindBucket(const Position &pos);
+
+    void Grow(int minBucketsX, int minBucketsY);
+};
+
+#endif //SPATIALGRID_H
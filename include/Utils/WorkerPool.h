@@ -0,0 +1,55 @@
+#ifndef WORKERPOOL_H
+#define WORKERPOOL_H
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// A fixed set of threads draining one job queue. Submit hands back a future for the job's result;
+// jobs must not touch anything that needs the main thread, like the GPU.
+class WorkerPool {
+public:
+    // Zero workers means one per hardware thread besides the main one
+    explicit WorkerPool(unsigned workerCount = 0);
+
+    // Runs whatever is still queued, then joins
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool &) = delete;
+
+    WorkerPool &operator=(const WorkerPool &) = delete;
+
+    template<typename Job>
+    std::future<std::invoke_result_t<Job> > Submit(Job job) {
+        using Result = std::invoke_result_t<Job>;
+
+        // packaged_task is move-only and std::function wants a copyable callable
+        auto task = std::make_shared<std::packaged_task<Result()> >(std::move(job));
+        std::future<Result> result = task->get_future();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            jobs.emplace([task] { (*task)(); });
+        }
+        wake.notify_one();
+        return result;
+    }
+
+    size_t WorkerCount() const { return workers.size(); }
+
+private:
+    void Run();
+
+    std::vector<std::thread> workers;
+    std::queue<std::function<void()> > jobs;
+    std::mutex mutex;
+    std::condition_variable wake;
+    bool stopping;
+};
+
+#endif //WORKERPOOL_H
@@ -0,0 +1,40 @@
+#include "C:/DandD/include/Core/BattleEventLog.h"
+
+BattleEventLog::BattleEventLog()
+    : events{},
+      head(0),
+      count(0),
+      totalPushed(0) {
+}
+
+void BattleEventLog::Push(const BattleEvent &event) {
+    // Write at the head slot and advance; the oldest event is overwritten once full
+    events[head] = event;
+    head = (head + 1) % CAPACITY;
+
+    if (count < CAPACITY) {
+        count++;
+    }
+
+    totalPushed++;
+}
+
+void BattleEventLog::Clear() {
+    head = 0;
+    count = 0;
+    totalPushed = 0;
+}
+
+size_t BattleEventLog::Size() const {
+    return count;
+}
+
+const BattleEvent &BattleEventLog::At(const size_t index) const {
+    // The oldest retained event sits 'count' slots behind the head
+    const size_t start = (head + CAPACITY - count) % CAPACITY;
+    return events[(start + index) % CAPACITY];
+}
+
+uint64_t BattleEventLog::GetTotalPushed() const {
+    return totalPushed;
+}
@@ -2,18 +2,25 @@
 #include "C:/DandD/include/Utils/ProbabilitySystem.h"
 #include <algorithm>
 #include <cmath>
+#include <iostream>
 
 BattleSystem::BattleSystem()
     : attackSystem(new Attack()),
+      monsterAI(new MonsterAI(attackSystem)),
       gameMap(nullptr),
       currentPlayer(nullptr),
       currentMonster(nullptr),
+      combatant(Position(-1, -1), 1, MonsterType::MONSTER),
+      currentHandle(MonsterHandle::Invalid()),
       playerHealthBeforeBattle(0.0),
       battleActive(false),
-      onBattleEnd(nullptr) {
+      lastResult(BattleResult::ONGOING),
+      onBattleEnd(nullptr),
+      onEvent(nullptr) {
 }
 
 BattleSystem::~BattleSystem() {
+    delete monsterAI;
     delete attackSystem;
 }
 
@@ -22,8 +29,8 @@ bool BattleSystem::CheckForBattle(Hero *player, const Position &newPosition) {
         return false;
     }
 
-    Monster *monster = GetMonsterAtPosition(newPosition);
-    if (monster && !monster->isDefeated()) {
+    const MonsterHandle monster = gameMap->getMonsters().FindAliveAt(newPosition);
+    if (gameMap->getMonsters().IsValid(monster)) {
         StartBattle(player, monster);
         return true;
     }
@@ -31,15 +38,28 @@ bool BattleSystem::CheckForBattle(Hero *player, const Position &newPosition) {
     return false;
 }
 
-void BattleSystem::StartBattle(Hero *player, Monster *monster) {
-    if (!player || !monster || battleActive) {
+void BattleSystem::StartBattle(Hero *player, const MonsterHandle monster) {
+    if (!player || !gameMap || battleActive) {
         return;
     }
 
+    const MonsterStore &monsters = gameMap->getMonstersConst();
+    if (!monsters.IsValid(monster)) {
+        std::cerr << "Battle requested with a stale monster handle" << std::endl;
+        return;
+    }
+
+    combatant = monsters.MakeCombatant(monsters.IndexOf(monster));
     currentPlayer = player;
-    currentMonster = monster;
+    currentMonster = &combatant;
+    currentHandle = monster;
     playerHealthBeforeBattle = player->GetHealth();
     battleActive = true;
+    lastResult = BattleResult::ONGOING;
+
+    monsterAI->ClearTable(); // Cached positions belong to the previous opponent
+    eventLog.Clear();
+    RecordEvent(BattleEventType::BATTLE_STARTED, BattleActor::HERO);
 }
 
 void BattleSystem::EndBattle(const BattleResult result) {
@@ -62,6 +82,9 @@ void BattleSystem::EndBattle(const BattleResult result) {
         }
     }
 
+    lastResult = result;
+    RecordEvent(BattleEventType::BATTLE_ENDED, BattleActor::HERO, AttackType::WEAPON, 0.0, false, result);
+
     // Execute callback before resetting state
     if (onBattleEnd) {
         onBattleEnd(result);
@@ -71,6 +94,7 @@ void BattleSystem::EndBattle(const BattleResult result) {
     battleActive = false;
     currentPlayer = nullptr;
     currentMonster = nullptr;
+    currentHandle = MonsterHandle::Invalid();
     playerHealthBeforeBattle = 0.0;
 }
 
@@ -80,6 +104,9 @@ double BattleSystem::PerformPlayerAttack(AttackType attackType) {
     }
 
     const double damage = attackSystem->performAttack(*currentPlayer, *currentMonster, attackType);
+    SyncMonsterHealth();
+    RecordEvent(BattleEventType::ATTACK, BattleActor::HERO, attackType, damage,
+                attackSystem->wasLastAttackCritical());
 
     // Check if monster is defeated
     if (currentMonster->isDefeated()) {
@@ -94,12 +121,12 @@ double BattleSystem::PerformMonsterAttack() {
         return 0.0;
     }
 
-    // Randomly choose monster attack type
-    AttackType monsterAttackType = (RandomUtils::randomValue<int>(0, 1) == 0)
-                                       ? AttackType::WEAPON
-                                       : AttackType::SPELL;
+    // Let the search pick the attack type; it does not consume random numbers
+    const AttackType monsterAttackType = monsterAI->ChooseAttack(*currentMonster, *currentPlayer);
 
     double damage = attackSystem->performAttack(*currentMonster, *currentPlayer, monsterAttackType);
+    RecordEvent(BattleEventType::ATTACK, BattleActor::MONSTER, monsterAttackType, damage,
+                attackSystem->wasLastAttackCritical());
 
     // Check if player is defeated
     if (currentPlayer->isDefeated()) {
@@ -116,25 +143,85 @@ bool BattleSystem::CanPlayerFlee() const {
 
 void BattleSystem::PlayerFlee() {
     if (CanPlayerFlee()) {
+        RecordEvent(BattleEventType::FLED, BattleActor::HERO);
         EndBattle(BattleResult::PLAYER_FLED);
     }
 }
 
+BattleResult BattleSystem::ResolveBattle(const BattlePolicy policy) {
+    int rounds = 0;
+
+    // Same turn order as the battle panel: hero first, monster answers while the fight is still on
+    while (battleActive) {
+        if (++rounds > MAX_AUTO_ROUNDS) {
+            DecideOnPoints();
+            break;
+        }
+
+        PerformPlayerAttack(ChoosePlayerAttack(policy));
+
+        if (battleActive) {
+            PerformMonsterAttack();
+        }
+    }
+
+    return lastResult;
+}
+
+// A flee would leave the hero on the monster's cell and the next trigger would start the same fight again,
+// so the stalemate ends like a knockout: whoever kept the larger share of health wins, the hero on a tie
+void BattleSystem::DecideOnPoints() {
+    if (!battleActive || !currentPlayer || !currentMonster) return;
+
+    const float heroShare = currentPlayer->GetHealth() / currentPlayer->GetMaxHealth();
+    const float monsterShare = currentMonster->GetHealth() / currentMonster->GetMaxHealth();
+
+    if (heroShare >= monsterShare) {
+        currentMonster->SetHealth(0.0f);
+        SyncMonsterHealth();
+        EndBattle(BattleResult::PLAYER_WON);
+    } else {
+        currentPlayer->SetHealth(0.0f);
+        EndBattle(BattleResult::PLAYER_LOST);
+    }
+}
+
+AttackType BattleSystem::ChoosePlayerAttack(const BattlePolicy policy) const {
+    switch (policy) {
+        case BattlePolicy::WEAPON_ONLY:
+            return AttackType::WEAPON;
+
+        case BattlePolicy::SPELL_ONLY:
+            return AttackType::SPELL;
+
+        case BattlePolicy::BEST_DAMAGE:
+        default: {
+            if (!currentPlayer || !currentMonster) return AttackType::WEAPON;
+
+            const double weaponDamage = attackSystem->estimateDamage(*currentPlayer, *currentMonster,
+                                                                     AttackType::WEAPON, false);
+            const double spellDamage = attackSystem->estimateDamage(*currentPlayer, *currentMonster,
+                                                                    AttackType::SPELL, false);
+            return spellDamage > weaponDamage ? AttackType::SPELL : AttackType::WEAPON;
+        }
+    }
+}
+
 bool BattleSystem::IsBattleActive() const {
     return battleActive;
 }
 
-Monster *BattleSystem::GetMonsterAtPosition(const Position &pos) const {
-    if (!gameMap) return nullptr;
+// Writes the combatant's health back into the map's monster store
+void BattleSystem::SyncMonsterHealth() {
+    if (!gameMap) return;
 
-    std::vector<Monster> &monsters = gameMap->getMonsters();
-    for (auto &monster: monsters) {
-        if (monster.GetPosition().x == pos.x && monster.GetPosition().y == pos.y) {
-            return &monster;
-        }
+    MonsterStore &monsters = gameMap->getMonsters();
+    if (!monsters.IsValid(currentHandle)) {
+        std::cerr << "Monster left the map during battle; health not written back" << std::endl;
+        return;
     }
 
-    return nullptr;
+    monsters.SetHealth(monsters.IndexOf(currentHandle), currentMonster->GetHealth());
 }
 
 void BattleSystem::SetMap(Map *map) {
@@ -145,6 +232,20 @@ void BattleSystem::SetBattleEndCallback(const std::function<void(BattleResult)>
     onBattleEnd = callback;
 }
 
+void BattleSystem::SetEventListener(const std::function<void(const BattleEvent &)> &listener) {
+    onEvent = listener;
+}
+
+void BattleSystem::RecordEvent(const BattleEventType type, const BattleActor actor, const AttackType attackType,
+                               const double damage, const bool critical, const BattleResult result) {
+    const BattleEvent event{type, actor, attackType, critical, result, static_cast<float>(damage)};
+    eventLog.Push(event);
+
+    if (onEvent) {
+        onEvent(event);
+    }
+}
+
 bool BattleSystem::DetermineFirstTurn() const {
     return RandomUtils::randomValue<int>(0, 1) == 0;
 }
@@ -0,0 +1,144 @@
+#include "C:/DandD/include/Core/FieldOfView.h"
+#include <algorithm>
+
+FieldOfView::FieldOfView(const int radius)
+    : radius(radius),
+      width(0),
+      height(0),
+      wordsPerRow(0),
+      mapGeneration(0),
+      visibleCount(0),
+      computeCount(0),
+      lastOrigin(-1, -1),
+      map(nullptr) {
+}
+
+void FieldOfView::Compute(const Map &mapRef, const Position &origin) {
+    if (wordsPerRow == 0 || mapGeneration != mapRef.GetLoadGeneration()) {
+        Reset(mapRef);
+    } else {
+        ClearVisible();
+    }
+
+    map = &mapRef;
+    lastOrigin = origin;
+    computeCount++;
+    visibleCount = 0;
+
+    if (origin.x < 0 || origin.y < 0 || origin.x >= width || origin.y >= height) {
+        map = nullptr;
+        return;
+    }
+
+    Mark(origin.x, origin.y);
+
+    // The eight octants, as (xx, xy, yx, yy) transforms of the first one
+    static constexpr int OCTANTS[8][4] = {
+        {1, 0, 0, 1}, {0, 1, 1, 0}, {0, -1, 1, 0}, {-1, 0, 0, 1},
+        {-1, 0, 0, -1}, {0, -1, -1, 0}, {0, 1, -1, 0}, {1, 0, 0, -1}
+    };
+    for (const auto &octant: OCTANTS) {
+        CastLight(origin, 1, 1.0f, 0.0f, octant[0], octant[1], octant[2], octant[3]);
+    }
+
+    map = nullptr;
+}
+
+bool FieldOfView::IsVisible(const int x, const int y) const {
+    if (x < 0 || y < 0 || x >= width || y >= height) return false;
+    return visible[static_cast<size_t>(y) * wordsPerRow + (x >> 6)] >> (x & 63) & 1;
+}
+
+bool FieldOfView::IsExplored(const int x, const int y) const {
+    if (x < 0 || y < 0 || x >= width || y >= height) return false;
+    return explored[static_cast<size_t>(y) * wordsPerRow + (x >> 6)] >> (x & 63) & 1;
+}
+
+// Sizes both bitsets for a newly loaded level and forgets what was explored on the previous one
+void FieldOfView::Reset(const Map &newMap) {
+    mapGeneration = newMap.GetLoadGeneration();
+    width = static_cast<int>(newMap.getWidth());
+    height = static_cast<int>(newMap.getHeight());
+    wordsPerRow = std::max(1, (width + 63) / 64);
+
+    visible.assign(static_cast<size_t>(wordsPerRow) * std::max(1, height), 0);
+    explored.assign(visible.size(), 0);
+    lastOrigin = Position(-1, -1);
+}
+
+// Clears only the square the previous Compute could have marked
+void FieldOfView::ClearVisible() {
+    if (lastOrigin.x < 0) return;
+
+    const int minY = std::max(0, lastOrigin.y - radius);
+    const int maxY = std::min(height - 1, lastOrigin.y + radius);
+    const int firstWord = std::max(0, lastOrigin.x - radius) >> 6;
+    const int lastWord = std::min(width - 1, lastOrigin.x + radius) >> 6;
+
+    for (int y = minY; y <= maxY; y++) {
+        std::fill(visible.begin() + static_cast<size_t>(y) * wordsPerRow + firstWord,
+                  visible.begin() + static_cast<size_t>(y) * wordsPerRow + lastWord + 1, 0);
+    }
+}
+
+void FieldOfView::Mark(const int x, const int y) {
+    const size_t word = static_cast<size_t>(y) * wordsPerRow + (x >> 6);
+    const uint64_t bit = 1ull << (x & 63);
+
+    if (!(visible[word] & bit)) {
+        visible[word] |= bit;
+        explored[word] |= bit;
+        visibleCount++;
+    }
+}
+
+// Walls and everything outside the map stop sight
+bool FieldOfView::BlocksSight(const int x, const int y) const {
+    return !map->isPassable(x, y);
+}
+
+void FieldOfView::CastLight(const Position &origin, const int row, float startSlope, const float endSlope,
+                            const int xx, const int xy, const int yx, const int yy) {
+    if (startSlope < endSlope) return;
+
+    const int radiusSquared = radius * radius;
+    float newStart = 0.0f;
+
+    for (int distance = row; distance <= radius; distance++) {
+        bool blocked = false;
+
+        for (int dx = -distance, dy = -distance; dx <= 0; dx++) {
+            // Slopes of the cell's left and right edges, seen from the origin
+            const float leftSlope = (dx - 0.5f) / (dy + 0.5f);
+            const float rightSlope = (dx + 0.5f) / (dy - 0.5f);
+            if (startSlope < rightSlope) continue;
+            if (endSlope > leftSlope) break;
+
+            const int x = origin.x + dx * xx + dy * xy;
+            const int y = origin.y + dx * yx + dy * yy;
+            const bool inside = x >= 0 && y >= 0 && x < width && y < height;
+
+            if (inside && dx * dx + dy * dy <= radiusSquared) {
+                Mark(x, y);
+            }
+
+            const bool opaque = !inside || BlocksSight(x, y);
+            if (blocked) {
+                // Inside a run of walls: move the start past it, or leave it at the first open cell
+                if (opaque) {
+                    newStart = rightSlope;
+                } else {
+                    blocked = false;
+                    startSlope = newStart;
+                }
+            } else if (opaque && distance < radius) {
+                // A wall starts: the part of the octant before it continues on its own
+                blocked = true;
+                CastLight(origin, distance + 1, startSlope, leftSlope, xx, xy, yx, yy);
+                newStart = rightSlope;
+            }
+        }
+
+        if (blocked) break;
+    }
+}
@@ -0,0 +1,226 @@
+#include "C:/DandD/include/Core/FlowField.h"
+#include <algorithm>
+#include <cstdlib>
+
+FlowField::FlowField(const int maxDistance)
+    : maxDistance(std::clamp(maxDistance, 1, static_cast<int>(UNREACHED) - 1)),
+      width(0),
+      height(0),
+      stride(0),
+      goal(-1, -1),
+      lastUpdateCount(0) {
+}
+
+void FlowField::Build(const Map &map, const Position &newGoal) {
+    width = static_cast<int>(map.getWidth());
+    height = static_cast<int>(map.getHeight());
+    stride = width + 2;
+
+    // Copy passability into a flat, padded grid; the border stays blocked
+    const size_t cellCount = static_cast<size_t>(stride) * (height + 2);
+    passable.assign(cellCount, 0);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            passable[CellIndex(x, y)] = map.isPassable(x, y) ? 1 : 0;
+        }
+    }
+
+    distance.assign(cellCount, UNREACHED);
+    reached.clear();
+    invalid.assign(cellCount, 0);
+    invalidCells.clear();
+    seeds.clear();
+    frontier.clear();
+    frontier.reserve(cellCount);
+    reached.reserve(cellCount);
+
+    goal = newGoal;
+    Flood();
+}
+
+void FlowField::MoveGoal(const Position &newGoal) {
+    if (!IsBuilt() || newGoal == goal) return;
+
+    goal = newGoal;
+    Flood();
+}
+
+void FlowField::OnCellChanged(const Map &map, const Position &pos) {
+    if (!IsBuilt() || !IsInside(pos.x, pos.y)) return;
+
+    const int cell = CellIndex(pos.x, pos.y);
+    const uint8_t nowPassable = map.isPassable(pos.x, pos.y) ? 1 : 0;
+    if (nowPassable == passable[cell]) return;
+
+    passable[cell] = nowPassable;
+    lastUpdateCount = 0;
+
+    if (pos == goal) {
+        Flood();
+        return;
+    }
+
+    if (nowPassable) {
+        // An opened cell can only shorten paths: relax outwards from it
+        const uint16_t best = BestNeighbourDistance(cell);
+        if (best != UNREACHED) {
+            Lower(cell, static_cast<uint16_t>(best + 1));
+            Propagate();
+        }
+    } else if (distance[cell] != UNREACHED) {
+        // A closed cell can only lengthen paths that went through it
+        Raise(cell);
+    }
+}
+
+uint16_t FlowField::GetDistance(const int x, const int y) const {
+    if (!IsBuilt() || !IsInside(x, y)) return UNREACHED;
+    return distance[CellIndex(x, y)];
+}
+
+// Flood from the goal. Only the cells the previous field reached are reset, so the cost follows the
+// maximum distance rather than the map size.
+void FlowField::Flood() {
+    lastUpdateCount = 0;
+
+    // Repairs may list a cell more than once; past the grid size a plain fill is cheaper
+    if (reached.size() >= distance.size()) {
+        std::fill(distance.begin(), distance.end(), UNREACHED);
+    } else {
+        for (const int cell: reached) {
+            distance[cell] = UNREACHED;
+        }
+    }
+    reached.clear();
+
+    if (!IsInside(goal.x, goal.y) || !passable[CellIndex(goal.x, goal.y)]) return;
+
+    // Plain breadth-first pass from a single seed: 'reached' doubles as the queue, so every cell is
+    // pushed once and no entry can go stale
+    const int neighbours[4] = {1, -1, -stride, stride};
+    const int goalCell = CellIndex(goal.x, goal.y);
+    distance[goalCell] = 0;
+    reached.push_back(goalCell);
+
+    for (size_t next = 0; next < reached.size(); next++) {
+        const int cell = reached[next];
+        if (distance[cell] >= maxDistance) continue;
+
+        const uint16_t nextDistance = distance[cell] + 1;
+        for (const int offset: neighbours) {
+            const int neighbour = cell + offset;
+            if (passable[neighbour] && distance[neighbour] == UNREACHED) {
+                distance[neighbour] = nextDistance;
+                reached.push_back(neighbour);
+            }
+        }
+    }
+
+    lastUpdateCount = reached.size();
+}
+
+void FlowField::Lower(const int cell, const uint16_t newDistance) {
+    if (newDistance > maxDistance || newDistance >= distance[cell]) return;
+
+    if (distance[cell] == UNREACHED) reached.push_back(cell);
+    distance[cell] = newDistance;
+    seeds.push_back({cell, newDistance});
+    lastUpdateCount++;
+}
+
+// Breadth-first relaxation from the seeds. Every step costs one, so merging the sorted seeds with a
+// FIFO frontier visits cells in distance order without a priority queue.
+void FlowField::Propagate() {
+    const int neighbours[4] = {1, -1, -stride, stride};
+
+    std::sort(seeds.begin(), seeds.end(), [](const QueueEntry &a, const QueueEntry &b) {
+        return a.distance < b.distance;
+    });
+
+    frontier.clear();
+    size_t nextSeed = 0;
+    size_t nextFrontier = 0;
+
+    while (nextSeed < seeds.size() || nextFrontier < frontier.size()) {
+        const bool takeSeed = nextFrontier >= frontier.size() ||
+                              (nextSeed < seeds.size() && seeds[nextSeed].distance < frontier[nextFrontier].distance);
+        const QueueEntry entry = takeSeed ? seeds[nextSeed++] : frontier[nextFrontier++];
+
+        if (distance[entry.cell] != entry.distance || entry.distance >= maxDistance) continue;
+
+        const uint16_t nextDistance = entry.distance + 1;
+        for (const int offset: neighbours) {
+            const int next = entry.cell + offset;
+            if (passable[next] && nextDistance < distance[next]) {
+                if (distance[next] == UNREACHED) reached.push_back(next);
+                distance[next] = nextDistance;
+                frontier.push_back({next, nextDistance});
+                lastUpdateCount++;
+            }
+        }
+    }
+
+    seeds.clear();
+}
+
+// Invalidates every cell whose shortest path depended on 'seed', then re-derives them from the rest of the field
+void FlowField::Raise(const int seed) {
+    const int neighbours[4] = {1, -1, -stride, stride};
+
+    invalid[seed] = 1;
+    invalidCells.push_back(seed);
+
+    // Breadth-first by distance, so a cell's possible supports one step closer are settled before it is checked
+    for (size_t i = 0; i < invalidCells.size(); i++) {
+        const int cell = invalidCells[i];
+        const int nextDistance = distance[cell] + 1;
+
+        for (const int offset: neighbours) {
+            const int next = cell + offset;
+            if (invalid[next] || distance[next] != nextDistance) continue;
+
+            bool supported = false;
+            for (const int supportOffset: neighbours) {
+                const int support = next + supportOffset;
+                if (!invalid[support] && distance[support] + 1 == nextDistance) {
+                    supported = true;
+                    break;
+                }
+            }
+
+            if (!supported) {
+                invalid[next] = 1;
+                invalidCells.push_back(next);
+            }
+        }
+    }
+
+    for (const int cell: invalidCells) {
+        distance[cell] = UNREACHED;
+    }
+
+    // Seed the repair from the valid boundary around the invalidated region
+    for (const int cell: invalidCells) {
+        invalid[cell] = 0;
+        if (!passable[cell]) continue;
+
+        const uint16_t best = BestNeighbourDistance(cell);
+        if (best != UNREACHED) {
+            Lower(cell, static_cast<uint16_t>(best + 1));
+        }
+    }
+
+    invalidCells.clear();
+    Propagate();
+}
+
+uint16_t FlowField::BestNeighbourDistance(const int cell) const {
+    const int neighbours[4] = {1, -1, -stride, stride};
+
+    uint16_t best = UNREACHED;
+    for (const int offset: neighbours) {
+        best = std::min(best, distance[cell + offset]);
+    }
+
+    return best;
+}
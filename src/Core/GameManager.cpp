@@ -1,15 +1,26 @@
 #include "C:/DandD/include/Core/GameManager.h"
+#include <algorithm>
+#include <cstdlib>
 
 // Constructor: Initializes game systems and window
 GameManager::GameManager(const int screenWidth, const int screenHeight)
     : screenWidth(screenWidth), screenHeight(screenHeight),
       isRunning(false), uiManager(nullptr), hero(nullptr),
-      currentMap(nullptr), attackSystem(nullptr), currentMonster(nullptr) {
+      currentMap(nullptr), attackSystem(nullptr), currentMonster(MonsterHandle::Invalid()),
+      replayRecorder(nullptr), monsterMovement(nullptr), pathfinder(nullptr), fieldOfView(nullptr),
+      frameCounter(0), simAccumulator(0.0f), showFrameStats(false), lastFrameTicks(0), simMillisPerTick(0.0),
+      renderOnDemand(true), lastLoopTime(0.0), idleTime(0.0f), ambientTimer(0.0f), lastState(UIState::MAIN_MENU),
+      skippedFrames(0),
+      autoPathIndex(0), autoStepTimer(0.0f) {
     InitializeSystems();
 }
 
 // Destructor: Cleans up allocated resources
 GameManager::~GameManager() {
+    delete fieldOfView;
+    delete pathfinder;
+    delete monsterMovement;
+    delete replayRecorder;
     delete attackSystem;
     delete currentMap;
     delete hero;
@@ -18,13 +29,25 @@ GameManager::~GameManager() {
 
 // Initializes game subsystems and resources
 void GameManager::InitializeSystems() {
+    // Frames follow the display; the simulation keeps its own fixed rate
+    SetConfigFlags(FLAG_VSYNC_HINT);
     InitWindow(screenWidth, screenHeight, "Dungeons and Dragons");
-    SetTargetFPS(60);
 
     // Core game objects
     hero = new Hero("Human", "Player");
     currentMap = new Map();
     attackSystem = new Attack();
+    replayRecorder = new ReplayRecorder();
+    monsterMovement = new MonsterMovement();
+    pathfinder = new Pathfinder();
+    fieldOfView = new FieldOfView();
+
+    // Item names and loot tables are parsed once here instead of on every treasure pickup
+    try {
+        ItemGenerator::preloadTables();
+    } catch (const std::exception &e) {
+        std::cerr << "Failed to load item tables: " << e.what() << std::endl;
+    }
 
     // UI system setup
     uiManager = new UIManager(screenWidth, screenHeight);
@@ -35,6 +58,8 @@ void GameManager::InitializeSystems() {
     uiManager->SetCurrentMap(currentMap);
     uiManager->SetAttackSystem(attackSystem);
     uiManager->Initialize();
+    uiManager->SetReplayRecorder(replayRecorder);
+    uiManager->SetFieldOfView(fieldOfView);
     uiManager->LoadResources();
 
     LoadCurrentLevel();
@@ -60,6 +85,13 @@ void GameManager::HandleRaceSelection(const Race race) {
 
     hero = new Hero(raceName, "Player");
 
+    // A new run gets a fresh seed, recorded so the run can be replayed exactly; so is the monster difficulty
+    const uint32_t seed = std::random_device{}();
+    RandomUtils::seed(seed);
+    const MonsterDifficulty difficulty = uiManager->GetMonsterDifficulty();
+    uiManager->SetMonsterDifficulty(difficulty);
+    replayRecorder->Begin(seed, race, difficulty);
+
     // Update systems with new hero
     uiManager->SetHero(hero);
 
@@ -69,30 +101,74 @@ void GameManager::HandleRaceSelection(const Race race) {
     LoadCurrentLevel();
 }
 
-// Main game loop
+// Main game loop: input and UI once per frame, the simulation in fixed steps, rendering between the last two steps
 void GameManager::RunGame() {
     isRunning = true;
+    lastLoopTime = GetTime();
 
     while (isRunning && !WindowShouldClose()) {
-        const float deltaTime = GetFrameTime();
+        // Measured here rather than with GetFrameTime, which only advances on frames that are drawn
+        const double now = GetTime();
+        const float deltaTime = std::min(static_cast<float>(now - lastLoopTime), MAX_FRAME_TIME);
+        lastLoopTime = now;
+        replayRecorder->SetFrame(++frameCounter);
+
         ProcessInput();
         Update(deltaTime);
-        Render();
+
+        // Same number of steps per second on a 30 Hz and a 240 Hz display
+        const double simStart = GetTime();
+        int ticks = 0;
+        simAccumulator += deltaTime;
+        while (simAccumulator >= SIM_TICK) {
+            Simulate(SIM_TICK);
+            simAccumulator -= SIM_TICK;
+            ticks++;
+        }
+        if (ticks > 0) {
+            const double millis = (GetTime() - simStart) * 1000.0 / ticks;
+            simMillisPerTick += (millis - simMillisPerTick) * 0.05;
+        }
+        lastFrameTicks = ticks;
+
+        if (ShouldRender(deltaTime)) {
+            uiManager->SetRenderInterpolation(simAccumulator / SIM_TICK);
+            Render();
+        } else {
+            // The last frame stays on screen; EndDrawing would have polled input, so do that and sleep instead
+            skippedFrames++;
+            PollInputEvents();
+            WaitTime(IDLE_POLL_INTERVAL);
+        }
 
         // Check for quit request from UI
         if (uiManager->ShouldQuit()) {
             isRunning = false;
         }
     }
+
+    SaveReplay();
     CloseWindow();
 }
 
+// True while a panel or another screen owns the input
+bool GameManager::IsMovementBlocked() const {
+    return uiManager->IsEquipmentPanelVisible() ||
+           uiManager->IsLevelUpPanelVisible() ||
+           uiManager->GetCurrentState() != UIState::GAMEPLAY;
+}
+
 // Routes input handling based on current game state
 void GameManager::ProcessInput() {
+    if (IsKeyPressed(KEY_F3)) {
+        showFrameStats = !showFrameStats;
+    }
+    if (IsKeyPressed(KEY_F4)) {
+        renderOnDemand = !renderOnDemand;
+    }
+
     // Determine if UI panels are blocking movement
-    const bool shouldBlockMovement = uiManager->IsEquipmentPanelVisible() ||
-                                     uiManager->IsLevelUpPanelVisible() ||
-                                     uiManager->GetCurrentState() != UIState::GAMEPLAY;
+    const bool shouldBlockMovement = IsMovementBlocked();
 
     // State-specific input handling
     switch (uiManager->GetCurrentState()) {
@@ -104,13 +180,16 @@ void GameManager::ProcessInput() {
             // Only process game actions if no blocking UI
             if (!shouldBlockMovement) {
                 HandleMovement();
-                HandleCombatTrigger();
-                HandleTreasureCollection();
+                HandleClickToMove();
+                CheckTriggers(); // Also on frames without a step, as ReplayPlayer does before every record
+            } else {
+                CancelAutoPath(); // A panel opened mid-walk
             }
             break;
 
         case UIState::BATTLE:
             // BattlePanel handles its own input
+            CancelAutoPath();
             break;
 
         case UIState::LEVEL_UP:
@@ -127,55 +206,149 @@ void GameManager::ProcessInput() {
 void GameManager::HandleMovement() {
     if (!hero || !currentMap) return;
 
-    Position newPos = hero->getCurrentPosition();
     bool moved = false;
+    MoveDirection direction = MoveDirection::RIGHT;
 
     // Process directional input
     if (IsKeyPressed(KEY_RIGHT) || IsKeyPressed(KEY_D)) {
-        newPos.x++;
         moved = true;
+        direction = MoveDirection::RIGHT;
     } else if (IsKeyPressed(KEY_LEFT) || IsKeyPressed(KEY_A)) {
-        newPos.x--;
         moved = true;
+        direction = MoveDirection::LEFT;
     } else if (IsKeyPressed(KEY_UP) || IsKeyPressed(KEY_W)) {
-        newPos.y--;
         moved = true;
+        direction = MoveDirection::UP;
     } else if (IsKeyPressed(KEY_DOWN) || IsKeyPressed(KEY_S)) {
-        newPos.y++;
         moved = true;
+        direction = MoveDirection::DOWN;
     }
 
-    // Validate and apply movement
-    if (moved && currentMap->isPassable(newPos.x, newPos.y)) {
-        hero->setPosition(newPos);
-        uiManager->UpdateMapRenderer(); // Refresh map display
+    if (moved) {
+        CancelAutoPath(); // Keyboard input takes over from a click-to-move walk
+        TryMoveHero(direction);
     }
 }
 
-// Checks for combat encounters at hero's position
-void GameManager::HandleCombatTrigger() {
-    if (!hero || !currentMap) return;
+// Records one step and applies it if the target cell is passable; monsters answer every hero step.
+// Encounters on the resulting cell start at once, as ReplayPlayer::ApplyMove does, whatever made the step.
+bool GameManager::TryMoveHero(const MoveDirection direction) {
+    Position newPos = hero->getCurrentPosition();
+    switch (direction) {
+        case MoveDirection::RIGHT: newPos.x++;
+            break;
+        case MoveDirection::LEFT: newPos.x--;
+            break;
+        case MoveDirection::UP: newPos.y--;
+            break;
+        case MoveDirection::DOWN: newPos.y++;
+            break;
+    }
+
+    // Record every directional input, including moves into walls
+    replayRecorder->RecordMove(direction);
+
+    if (!currentMap->isPassable(newPos.x, newPos.y)) {
+        CheckTriggers();
+        return false;
+    }
+
+    hero->setPosition(newPos);
+    fieldOfView->Compute(*currentMap, newPos);
+    monsterMovement->Tick(*currentMap, newPos);
+    uiManager->UpdateMapRenderer(); // Refresh map display
+    CheckTriggers();
+    return true;
+}
+
+// A battle or a treasure on the hero's cell; the battle wins if both are there, matching ReplayPlayer::CheckTriggers
+void GameManager::CheckTriggers() {
+    if (IsMovementBlocked()) return; // Already in a battle or deciding on an item
+
+    if (HandleCombatTrigger()) return;
+    HandleTreasureCollection();
+}
+
+// Plans a walk to the clicked cell; an unreachable or too distant target walks as close as the search got
+void GameManager::HandleClickToMove() {
+    if (!IsMouseButtonPressed(MOUSE_BUTTON_LEFT)) return;
+
+    Position target(0, 0);
+    if (!uiManager->ScreenToMapCell(GetMousePosition(), target)) return;
+
+    CancelAutoPath();
+    pathfinder->FindPath(*currentMap, hero->getCurrentPosition(), target, autoPath);
+    autoPathIndex = 1; // Entry 0 is the hero's own cell
+    autoStepTimer = AUTO_STEP_INTERVAL; // First step right away
+}
+
+// Walks the planned path one cell at a time, as ordinary recorded moves
+void GameManager::HandleAutoStep(const float tickTime) {
+    if (autoPathIndex >= autoPath.size()) return;
+
+    autoStepTimer += tickTime;
+    if (autoStepTimer < AUTO_STEP_INTERVAL) return;
+    autoStepTimer = 0.0f;
+
+    const Position heroPos = hero->getCurrentPosition();
+    const Position next = autoPath[autoPathIndex];
+    const int dx = next.x - heroPos.x;
+    const int dy = next.y - heroPos.y;
+
+    // The hero was moved by something else (level change, battle), so the plan is stale
+    if (std::abs(dx) + std::abs(dy) != 1) {
+        CancelAutoPath();
+        return;
+    }
+
+    const MoveDirection direction = dx > 0
+                                        ? MoveDirection::RIGHT
+                                        : dx < 0
+                                              ? MoveDirection::LEFT
+                                              : dy < 0
+                                                    ? MoveDirection::UP
+                                                    : MoveDirection::DOWN;
+    if (!TryMoveHero(direction)) {
+        CancelAutoPath(); // A wall appeared on the way
+        return;
+    }
+    autoPathIndex++;
+
+    // The step's battle or treasure has already started; stop when it needs the player, or when a monster
+    // survived on the cell (the hero fled)
+    const MonsterStore &monsters = currentMap->getMonstersConst();
+    if (IsMovementBlocked() || monsters.IsValid(monsters.FindAliveAt(next))) {
+        CancelAutoPath();
+    }
+}
+
+void GameManager::CancelAutoPath() {
+    autoPath.clear();
+    autoPathIndex = 0;
+    autoStepTimer = 0.0f;
+}
+
+// Checks for combat encounters at hero's position; true if a battle was fought or started
+bool GameManager::HandleCombatTrigger() {
+    if (!hero || !currentMap) return false;
 
     const Position heroPos = hero->getCurrentPosition();
-    auto &monsters = currentMap->getMonsters();
+    MonsterStore &monsters = currentMap->getMonsters();
 
     // Check for undefeated monsters at hero's position
-    for (auto &monster: monsters) {
-        if (!monster.isDefeated()) {
-            const Position mPos = monster.GetPosition();
-            if (heroPos.x == mPos.x && heroPos.y == mPos.y) {
-                currentMonster = &monster;
-                uiManager->StartBattle(hero, currentMonster);
-
-                if (uiManager->GetBattleResult() == BattleResult::PLAYER_WON) {
-                    // Mark the monster as defeated instead of removing it immediately
-                    currentMonster->setDefeated(true);
-                    uiManager->UpdateMapRenderer();
-                }
-                return;
-            }
-        }
+    currentMonster = monsters.FindAliveAt(heroPos);
+    if (!monsters.IsValid(currentMonster)) {
+        return false;
+    }
+
+    uiManager->StartBattle(hero, currentMonster);
+
+    if (uiManager->GetBattleResult() == BattleResult::PLAYER_WON && monsters.IsValid(currentMonster)) {
+        // Mark the monster as defeated instead of removing it immediately
+        monsters.SetDefeated(monsters.IndexOf(currentMonster), true);
+        uiManager->UpdateMapRenderer();
     }
+    return true;
 }
 
 // Handles treasure collection mechanics
@@ -199,16 +372,12 @@ void GameManager::HandleTreasureCollection() {
             heroPos.y == treasure.getPosition().y) {
             currentMap->removeTreasure(treasure);
 
-            // Generate item and transfer ownership
-            std::unique_ptr<Item> newItem(ItemGenerator::generateRandomItem(
-                currentMap->GetCurrentLevel()
-            ));
+            // Generate the item; the UI keeps its own copy while the player decides
+            const Item newItem = ItemGenerator::generateRandomItem(currentMap->GetCurrentLevel());
 
-            if (newItem) {
-                uiManager->ShowEquipmentChoice(std::move(newItem));
-                uiManager->UpdateMapRenderer();
-                return;
-            }
+            uiManager->ShowEquipmentChoice(newItem);
+            uiManager->UpdateMapRenderer();
+            return;
         }
     }
 }
@@ -222,6 +391,9 @@ void GameManager::Update(const float deltaTime) const {
     // Cleanup after equipment selection
     if (uiManager->GetCurrentState() == UIState::EQUIPMENT_SELECTION &&
         !uiManager->IsEquipmentPanelVisible()) {
+        // Equipping returns to gameplay on its own, so reaching this point means the item was declined
+        replayRecorder->RecordEquipment(false);
+
         uiManager->SetState(UIState::GAMEPLAY);
         uiManager->UpdateMapRenderer();
         uiManager->UpdateHUDStats(); // Refresh HUD after equipment change
@@ -236,19 +408,103 @@ void GameManager::Update(const float deltaTime) const {
     }
 }
 
+// Advances the time-driven state by one fixed step; an auto-step that lands on an encounter starts it in the step,
+// and the blocked check stops later ticks of the frame from walking on
+void GameManager::Simulate(const float tickTime) {
+    if (!uiManager) return;
+
+    if (!IsMovementBlocked()) {
+        HandleAutoStep(tickTime);
+    }
+
+    uiManager->FixedUpdate(tickTime);
+}
+
+// Draws when something visible may have changed: input, a state change, a running animation or an auto-walk.
+// Slow looping effects get a low rate, static screens none at all.
+bool GameManager::ShouldRender(const float deltaTime) {
+    idleTime += deltaTime;
+    ambientTimer += deltaTime;
+
+    const UIState state = uiManager->GetCurrentState();
+    if (state != lastState || HasInputActivity() || autoPathIndex < autoPath.size()) {
+        idleTime = 0.0f;
+        lastState = state;
+    }
+
+    const RedrawNeed need = uiManager->GetRedrawNeed();
+    bool render = !renderOnDemand || idleTime < IDLE_GRACE || need == RedrawNeed::EVERY_FRAME;
+    if (!render && need == RedrawNeed::AMBIENT && ambientTimer >= AMBIENT_INTERVAL) {
+        render = true;
+    }
+
+    if (render) {
+        ambientTimer = 0.0f;
+    }
+    return render;
+}
+
+// Any mouse or window event, or a bound key held or released, since the last poll
+bool GameManager::HasInputActivity() const {
+    const Vector2 mouseDelta = GetMouseDelta();
+    if (mouseDelta.x != 0.0f || mouseDelta.y != 0.0f || GetMouseWheelMove() != 0.0f || IsWindowResized()) {
+        return true;
+    }
+
+    for (int button = MOUSE_BUTTON_LEFT; button <= MOUSE_BUTTON_BACK; button++) {
+        if (IsMouseButtonDown(button) || IsMouseButtonReleased(button)) return true;
+    }
+
+    // Only keys something reacts to; digits feed the level-up fields through GetCharPressed, whose queue
+    // belongs to that panel, so their key states stand in for it
+    static constexpr int BOUND_KEYS[] = {
+        KEY_RIGHT, KEY_LEFT, KEY_UP, KEY_DOWN, KEY_D, KEY_A, KEY_W, KEY_S, KEY_M,
+        KEY_ENTER, KEY_ESCAPE, KEY_BACKSPACE, KEY_F3, KEY_F4
+    };
+    for (const int key: BOUND_KEYS) {
+        if (IsKeyDown(key) || IsKeyReleased(key)) return true;
+    }
+    for (int digit = 0; digit <= 9; digit++) {
+        if (IsKeyDown(KEY_ZERO + digit) || IsKeyReleased(KEY_ZERO + digit) ||
+            IsKeyDown(KEY_KP_0 + digit) || IsKeyReleased(KEY_KP_0 + digit)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 // Main rendering pass
 void GameManager::Render() const {
     BeginDrawing();
     uiManager->Draw(); // Delegate drawing to UI system
+    if (showFrameStats) {
+        DrawFrameStats();
+    }
     EndDrawing();
 }
 
+// Draws the F3 overlay in the top-left corner
+void GameManager::DrawFrameStats() const {
+    DrawRectangle(10, 10, 260, 122, {0, 0, 0, 170});
+    DrawText(TextFormat("FPS: %d (%.2f ms)", GetFPS(), GetFrameTime() * 1000.0f), 20, 20, 16, RAYWHITE);
+    DrawText(TextFormat("Sim: %d ticks this frame at %.0f Hz", lastFrameTicks, 1.0f / SIM_TICK), 20, 42, 16,
+             RAYWHITE);
+    DrawText(TextFormat("Sim cost: %.3f ms per tick", simMillisPerTick), 20, 64, 16, RAYWHITE);
+    DrawText(TextFormat("Map tile draw calls: %d", uiManager->GetMapTileDrawCalls()), 20, 86, 16, RAYWHITE);
+    DrawText(TextFormat("On demand (F4): %s, %u skipped", renderOnDemand ? "on" : "off", skippedFrames), 20, 108,
+             16, RAYWHITE);
+}
+
 // Places hero at level starting position
 void GameManager::PositionHeroAtStart() const {
     if (!currentMap || !hero) return;
 
     const Position startPos = currentMap->getStartPos();
     hero->setPosition(startPos);
+    fieldOfView->Compute(*currentMap, startPos); // A new level starts unexplored
+    pathfinder->SyncGrid(*currentMap); // So the first click-to-move does not pay for the grid
+    monsterMovement->SyncField(*currentMap, startPos); // Same for the monsters' first turn
 
     if (uiManager) {
         uiManager->UpdateMapRenderer(); // Sync map display
@@ -266,6 +522,17 @@ void GameManager::LoadCurrentLevel() const {
     uiManager->UpdateHUDStats(); // Refresh player stats display
 }
 
+// Writes the input recording of the current run, if any
+void GameManager::SaveReplay() const {
+    if (!replayRecorder || !replayRecorder->IsRecording()) return;
+
+    try {
+        replayRecorder->Save(REPLAY_FILE_PATH);
+    } catch (const std::exception &e) {
+        std::cerr << "Failed to save replay: " << e.what() << std::endl;
+    }
+}
+
 // Handles level progression
 void GameManager::TransitionToNextLevel() const {
     if (!uiManager) return;
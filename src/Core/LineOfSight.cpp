@@ -0,0 +1,213 @@
+#include "C:/DandD/include/Core/LineOfSight.h"
+#include <cstdlib>
+
+namespace {
+    // Integer division rounding towards negative infinity (den > 0)
+    int floorDiv(const int num, const int den) {
+        return num >= 0 ? num / den : -((-num + den - 1) / den);
+    }
+
+    int ceilDiv(const int num, const int den) {
+        return -floorDiv(-num, den);
+    }
+}
+
+LineOfSight::LineOfSight(const SightMode mode)
+    : mode(mode),
+      stats{},
+      sweepValid(false),
+      sweepOrigin(-1, -1),
+      sweepRange(0),
+      sweepSide(0),
+      sweepMap(nullptr) {
+}
+
+void LineOfSight::BeginTurn() {
+    cache.clear(); // Keeps the buckets, so steady-state turns do not allocate
+    sweepValid = false;
+}
+
+bool LineOfSight::HasLineOfSight(const Map &map, const Position &from, const Position &to, const int range) {
+    stats.queries++;
+    if (!InRange(from, to, range)) return false;
+
+    const uint64_t key = PackKey(from, to);
+    const auto cached = cache.find(key);
+    if (cached != cache.end()) {
+        stats.cacheHits++;
+        return cached->second;
+    }
+
+    bool visible;
+    if (mode == SightMode::BRESENHAM) {
+        visible = TraceLine(map, from, to);
+    } else {
+        // Symmetric, so looking from 'to' answers the question; later queries against 'to' reuse the sweep
+        if (!sweepValid || !(sweepOrigin == to) || sweepRange < range) {
+            Sweep(map, to, range);
+        }
+        visible = SweepSees(from);
+    }
+
+    cache[key] = visible;
+    return visible;
+}
+
+void LineOfSight::CanSeeTarget(const Map &map, const MonsterStore &monsters, const Position &target, const int range,
+                               std::vector<uint8_t> &results) {
+    results.assign(monsters.Size(), 0);
+
+    if (mode == SightMode::BRESENHAM) {
+        for (size_t i = 0; i < monsters.Size(); i++) {
+            if (monsters.IsAlive(i)) {
+                results[i] = HasLineOfSight(map, monsters.GetPosition(i), target, range) ? 1 : 0;
+            }
+        }
+        return;
+    }
+
+    // One sweep from the target, then a bit lookup per monster
+    if (!sweepValid || !(sweepOrigin == target) || sweepRange < range) {
+        Sweep(map, target, range);
+    }
+
+    for (size_t i = 0; i < monsters.Size(); i++) {
+        if (monsters.IsAlive(i)) {
+            stats.queries++;
+            const Position &pos = monsters.GetPosition(i);
+            results[i] = InRange(pos, target, range) && SweepSees(pos) ? 1 : 0;
+        }
+    }
+}
+
+void LineOfSight::SetMode(const SightMode newMode) {
+    mode = newMode;
+    BeginTurn(); // Answers differ between the modes
+}
+
+uint64_t LineOfSight::PackKey(const Position &from, const Position &to) {
+    return static_cast<uint64_t>(static_cast<uint16_t>(from.x)) << 48 |
+           static_cast<uint64_t>(static_cast<uint16_t>(from.y)) << 32 |
+           static_cast<uint64_t>(static_cast<uint16_t>(to.x)) << 16 |
+           static_cast<uint64_t>(static_cast<uint16_t>(to.y));
+}
+
+bool LineOfSight::InRange(const Position &from, const Position &to, const int range) {
+    const int dx = to.x - from.x;
+    const int dy = to.y - from.y;
+    return dx * dx + dy * dy <= range * range;
+}
+
+// Bresenham line; only the cells strictly between the two ends have to be open
+bool LineOfSight::TraceLine(const Map &map, const Position &from, const Position &to) {
+    const int dx = std::abs(to.x - from.x);
+    const int dy = -std::abs(to.y - from.y);
+    const int stepX = from.x < to.x ? 1 : -1;
+    const int stepY = from.y < to.y ? 1 : -1;
+    int error = dx + dy;
+    int x = from.x;
+    int y = from.y;
+
+    while (true) {
+        const int doubled = 2 * error;
+        if (doubled >= dy) {
+            error += dy;
+            x += stepX;
+        }
+        if (doubled <= dx) {
+            error += dx;
+            y += stepY;
+        }
+
+        if (x == to.x && y == to.y) return true;
+
+        stats.cellsTested++;
+        if (!map.isPassable(x, y)) return false;
+    }
+}
+
+// Symmetric shadowcasting from origin, four quadrants scanned row by row
+void LineOfSight::Sweep(const Map &map, const Position &origin, const int range) {
+    stats.sweeps++;
+    sweepMap = &map;
+    sweepOrigin = origin;
+    sweepRange = range;
+    sweepSide = 2 * range + 1;
+    sweepVisible.assign((static_cast<size_t>(sweepSide) * sweepSide + 63) / 64, 0);
+
+    Reveal(origin);
+    for (int quadrant = 0; quadrant < 4; quadrant++) {
+        ScanRow(quadrant, 1, -1, 1, 1, 1);
+    }
+
+    sweepMap = nullptr;
+    sweepValid = true;
+}
+
+bool LineOfSight::SweepSees(const Position &cell) const {
+    const int localX = cell.x - sweepOrigin.x + sweepRange;
+    const int localY = cell.y - sweepOrigin.y + sweepRange;
+    if (localX < 0 || localY < 0 || localX >= sweepSide || localY >= sweepSide) return false;
+
+    const size_t bit = static_cast<size_t>(localY) * sweepSide + localX;
+    return sweepVisible[bit >> 6] >> (bit & 63) & 1;
+}
+
+void LineOfSight::ScanRow(const int quadrant, const int depth, int startNum, int startDen, const int endNum,
+                          const int endDen) {
+    if (depth > sweepRange) return;
+
+    // Columns whose centres fall inside the slopes, ties rounded towards the inside
+    const int minColumn = floorDiv(2 * depth * startNum + startDen, 2 * startDen);
+    const int maxColumn = ceilDiv(2 * depth * endNum - endDen, 2 * endDen);
+
+    int previous = -1; // -1 nothing yet, 0 floor, 1 wall
+    for (int column = minColumn; column <= maxColumn; column++) {
+        const Position cell = QuadrantToMap(quadrant, depth, column);
+        const bool wall = IsWall(cell);
+
+        // A floor cell counts only if its centre is inside the cone, which is what keeps sight symmetric
+        const bool centreInside = column * startDen >= depth * startNum && column * endDen <= depth * endNum;
+        if (wall || centreInside) {
+            Reveal(cell);
+        }
+
+        if (previous == 1 && !wall) {
+            // Leaving a wall: the cone restarts at this cell's left edge
+            startNum = 2 * column - 1;
+            startDen = 2 * depth;
+        }
+        if (previous == 0 && wall) {
+            // Hitting a wall: the open part so far continues one row further
+            ScanRow(quadrant, depth + 1, startNum, startDen, 2 * column - 1, 2 * depth);
+        }
+
+        previous = wall ? 1 : 0;
+    }
+
+    if (previous == 0) {
+        ScanRow(quadrant, depth + 1, startNum, startDen, endNum, endDen);
+    }
+}
+
+Position LineOfSight::QuadrantToMap(const int quadrant, const int depth, const int column) const {
+    switch (quadrant) {
+        case 0: return {sweepOrigin.x + column, sweepOrigin.y - depth}; // North
+        case 1: return {sweepOrigin.x + column, sweepOrigin.y + depth}; // South
+        case 2: return {sweepOrigin.x + depth, sweepOrigin.y + column}; // East
+        default: return {sweepOrigin.x - depth, sweepOrigin.y + column}; // West
+    }
+}
+
+bool LineOfSight::IsWall(const Position &cell) {
+    stats.cellsTested++;
+    return !sweepMap->isPassable(cell.x, cell.y);
+}
+
+void LineOfSight::Reveal(const Position &cell) {
+    if (!InRange(sweepOrigin, cell, sweepRange)) return;
+
+    const size_t bit = static_cast<size_t>(cell.y - sweepOrigin.y + sweepRange) * sweepSide +
+                       (cell.x - sweepOrigin.x + sweepRange);
+    sweepVisible[bit >> 6] |= 1ull << (bit & 63);
+}
@@ -8,7 +8,7 @@
 #include <stdexcept>
 
 // Constructor: Initializes map state
-Map::Map() : width(0), height(0), currentLevel(1), startPos(-1, -1) {
+Map::Map() : width(0), height(0), currentLevel(1), loadGeneration(0), startPos(-1, -1) {
 }
 
 // Validates map integrity after loading
@@ -52,7 +52,7 @@ void Map::parseGridLine(const std::string &line, const int rowIndex) {
             row.back() = 'H'; // Keep symbol in grid
         } else if (c == 'M' || c == 'B') {
             // Create monsters: Bosses are level+1, regular monsters at current level
-            enemies.emplace_back(
+            enemies.Add(
                 pos,
                 (c == 'B' ? currentLevel + 1 : currentLevel),
                 (c == 'B' ? MonsterType::BOSS : MonsterType::MONSTER)
@@ -74,8 +74,11 @@ void Map::parseGridLine(const std::string &line, const int rowIndex) {
 void Map::loadFromFile(const std::string &filePath, const std::string &levelTag) {
     // Reset state
     currentLevel = parseLevelNumber(levelTag);
+    loadGeneration++;
+    passabilityChanges.clear();
+    tileChanges.clear();
     grid.clear();
-    enemies.clear();
+    enemies.Clear(); // Handles into the previous level become stale
     treasures.clear();
     startPos = Position(-1, -1);
 
@@ -130,6 +133,8 @@ void Map::loadFromFile(const std::string &filePath, const std::string &levelTag)
     // Set dimensions
     height = grid.size();
     width = (height > 0) ? grid[0].size() : 0;
+
+    indexTreasures();
 }
 
 // Getters for map properties and entities
@@ -158,6 +163,13 @@ char Map::getCell(const Position &pos) const {
 
 void Map::setCell(const Position &pos, const char c) {
     if (pos.x >= 0 && pos.x < width && pos.y >= 0 && pos.y < height) {
+        // Remember walls appearing or disappearing for incremental pathing
+        if ((grid[pos.y][pos.x] == '#') != (c == '#')) {
+            passabilityChanges.push_back(pos);
+        }
+        if (grid[pos.y][pos.x] != c) {
+            tileChanges.push_back(pos); // Cached drawings of the grid redraw this cell
+        }
         grid[pos.y][pos.x] = c;
     }
 }
@@ -171,16 +183,16 @@ size_t Map::getHeight() const {
 }
 
 // Monster accessors
-const std::vector<Monster> &Map::getMonstersConst() const {
+const MonsterStore &Map::getMonstersConst() const {
     return enemies;
 }
 
-std::vector<Monster> &Map::getMonsters() {
+MonsterStore &Map::getMonsters() {
     return enemies;
 }
 
 size_t Map::GetMonsterCount() const {
-    return enemies.size();
+    return enemies.Size();
 }
 
 // Treasure accessors
@@ -195,10 +207,34 @@ std::vector<Treasure> &Map::getTreasures() {
 // Removes collected treasure
 void Map::removeTreasure(const Treasure &treasure) {
     treasures.erase(std::remove(treasures.begin(), treasures.end(), treasure), treasures.end());
+    indexTreasures(); // The erase shifted every index after it
 }
 
-void Map::removeMonster(const Monster &monster) {
-    enemies.erase(std::remove(enemies.begin(), enemies.end(), monster), enemies.end());
+void Map::QueryTreasures(const int minX, const int minY, const int maxX, const int maxY,
+                         std::vector<size_t> &out) const {
+    const size_t first = out.size();
+
+    treasureScratch.clear();
+    treasureIndex.Query(minX, minY, maxX, maxY, treasureScratch);
+    for (const uint32_t i: treasureScratch) {
+        const Position &pos = treasures[i].getPosition();
+        if (pos.x >= minX && pos.x <= maxX && pos.y >= minY && pos.y <= maxY) {
+            out.push_back(i);
+        }
+    }
+
+    std::sort(out.begin() + first, out.end());
+}
+
+void Map::indexTreasures() {
+    treasureIndex.Clear();
+    for (size_t i = 0; i < treasures.size(); i++) {
+        treasureIndex.Insert(static_cast<uint32_t>(i), treasures[i].getPosition());
+    }
+}
+
+void Map::removeMonster(const MonsterHandle monster) {
+    enemies.Remove(monster);
 }
 
 size_t Map::GetTreasureCount() const {
@@ -208,3 +244,43 @@ size_t Map::GetTreasureCount() const {
 int Map::GetCurrentLevel() const {
     return currentLevel;
 }
+
+uint32_t Map::GetLoadGeneration() const {
+    return loadGeneration;
+}
+
+const std::vector<Position> &Map::GetPassabilityChanges() const {
+    return passabilityChanges;
+}
+
+const std::vector<Position> &Map::GetTileChanges() const {
+    return tileChanges;
+}
+
+// Level completion rule shared by the game UI and headless replays
+bool Map::IsLevelCleared() const {
+    if (enemies.Empty()) {
+        return true;
+    }
+
+    int aliveNormalMonsters = 0;
+    int aliveBosses = 0;
+    int totalNormalMonsters = 0;
+    int totalBosses = 0;
+
+    // Count alive and total monsters/bosses in one pass over the type and alive arrays
+    for (size_t i = 0; i < enemies.Size(); i++) {
+        if (enemies.GetType(i) == MonsterType::BOSS) {
+            totalBosses++;
+            aliveBosses += enemies.IsAlive(i) ? 1 : 0;
+        } else {
+            totalNormalMonsters++;
+            aliveNormalMonsters += enemies.IsAlive(i) ? 1 : 0;
+        }
+    }
+
+    const bool normalMonstersCleared = (totalNormalMonsters > 0 && aliveNormalMonsters == 0);
+    const bool bossesCleared = (totalBosses > 0 && aliveBosses == 0);
+
+    return normalMonstersCleared || bossesCleared;
+}
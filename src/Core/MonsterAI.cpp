@@ -0,0 +1,200 @@
+#include "C:/DandD/include/Core/MonsterAI.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <limits>
+
+namespace {
+    uint64_t floatBits(const float value) {
+        uint32_t bits = 0;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    // splitmix64 finaliser, spreads neighbouring HP values over the table
+    uint64_t mixKey(uint64_t key) {
+        key ^= key >> 30;
+        key *= 0xBF58476D1CE4E5B9ull;
+        key ^= key >> 27;
+        key *= 0x94D049BB133111EBull;
+        key ^= key >> 31;
+        return key;
+    }
+}
+
+MonsterAI::MonsterAI(const Attack *attackSystem)
+    : attackSystem(attackSystem),
+      normalDepth(2), // Regular monsters only look at their own attack and the hero's answer
+      bossDepth(6), // Bosses plan three full exchanges ahead
+      nodeBudget(DEFAULT_NODE_BUDGET),
+      table{},
+      monsterDamage{},
+      heroDamage{},
+      heroMaxHealth(1.0f),
+      monsterMaxHealth(1.0f),
+      critChance(0.0f),
+      statsKey(0),
+      aborted(false),
+      stats{} {
+}
+
+AttackType MonsterAI::ChooseAttack(const Monster &monster, const Hero &hero) {
+    const auto start = std::chrono::steady_clock::now();
+    stats = MonsterSearchStats{};
+
+    if (!attackSystem) {
+        return AttackType::WEAPON;
+    }
+
+    // Stats do not change during a battle, so every damage value in the tree comes from this table
+    const AttackType types[2] = {AttackType::WEAPON, AttackType::SPELL};
+    statsKey = 1469598103934665603ull;
+    for (int t = 0; t < 2; t++) {
+        for (int crit = 0; crit < 2; crit++) {
+            monsterDamage[t][crit] = static_cast<float>(attackSystem->estimateDamage(monster, hero, types[t], crit));
+            heroDamage[t][crit] = static_cast<float>(attackSystem->estimateDamage(hero, monster, types[t], crit));
+            statsKey = mixKey(statsKey ^ floatBits(monsterDamage[t][crit]) ^ (floatBits(heroDamage[t][crit]) << 32));
+        }
+    }
+
+    heroMaxHealth = std::max(1.0f, hero.GetMaxHealth());
+    monsterMaxHealth = std::max(1.0f, monster.GetMaxHealth());
+    critChance = static_cast<float>(attackSystem->getCriticalHitChance()) / 100.0f;
+
+    const int maxDepth = GetSearchDepth(monster.GetType());
+    const float heroHealth = hero.GetHealth();
+    const float monsterHealth = monster.GetHealth();
+    AttackType bestAttack = AttackType::WEAPON;
+
+    // Iterative deepening: each finished depth replaces the answer, an interrupted one is discarded
+    for (int depth = 1; depth <= maxDepth; depth++) {
+        aborted = false;
+        float bestValue = -std::numeric_limits<float>::infinity();
+        AttackType bestAtDepth = AttackType::WEAPON;
+
+        for (int t = 0; t < 2 && !aborted; t++) {
+            const float normal = Search(heroHealth - monsterDamage[t][0], monsterHealth, depth - 1, false);
+            const float critical = Search(heroHealth - monsterDamage[t][1], monsterHealth, depth - 1, false);
+            const float value = (1.0f - critChance) * normal + critChance * critical;
+
+            // Strictly better only, so ties keep the weapon and decisions stay stable
+            if (value > bestValue) {
+                bestValue = value;
+                bestAtDepth = types[t];
+            }
+        }
+
+        if (aborted) {
+            stats.outOfNodes = true;
+            break;
+        }
+
+        bestAttack = bestAtDepth;
+        stats.depthReached = depth;
+    }
+
+    stats.elapsedMicros = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count();
+
+    return bestAttack;
+}
+
+float MonsterAI::Search(const float heroHealth, const float monsterHealth, const int depth, const bool monsterToMove) {
+    // Terminal positions; a quicker win (more depth left) scores higher
+    if (heroHealth <= 0) return WIN_SCORE + static_cast<float>(depth);
+    if (monsterHealth <= 0) return -WIN_SCORE - static_cast<float>(depth);
+    if (depth == 0) return Evaluate(heroHealth, monsterHealth);
+
+    if (nodeBudget > 0 && stats.nodes >= nodeBudget) {
+        aborted = true;
+        return 0.0f;
+    }
+
+    stats.nodes++;
+
+    const uint64_t key = MakeKey(heroHealth, monsterHealth, monsterToMove);
+    TableEntry &entry = table[key % TABLE_SIZE];
+    if (entry.key == key && entry.depth >= depth) {
+        stats.tableHits++;
+        return entry.value;
+    }
+
+    float best = monsterToMove
+                     ? -std::numeric_limits<float>::infinity()
+                     : std::numeric_limits<float>::infinity();
+
+    for (int t = 0; t < 2; t++) {
+        float normal;
+        float critical;
+
+        if (monsterToMove) {
+            normal = Search(heroHealth - monsterDamage[t][0], monsterHealth, depth - 1, false);
+            critical = Search(heroHealth - monsterDamage[t][1], monsterHealth, depth - 1, false);
+        } else {
+            normal = Search(heroHealth, monsterHealth - heroDamage[t][0], depth - 1, true);
+            critical = Search(heroHealth, monsterHealth - heroDamage[t][1], depth - 1, true);
+        }
+
+        if (aborted) return 0.0f;
+
+        // Chance node over the critical hit roll, then max (monster) or min (hero) over attack types
+        const float value = (1.0f - critChance) * normal + critChance * critical;
+        best = monsterToMove ? std::max(best, value) : std::min(best, value);
+    }
+
+    entry = {key, best, static_cast<int8_t>(depth)};
+    return best;
+}
+
+// Positive when the monster is ahead: its remaining health share minus the hero's
+float MonsterAI::Evaluate(const float heroHealth, const float monsterHealth) const {
+    return monsterHealth / monsterMaxHealth - heroHealth / heroMaxHealth;
+}
+
+uint64_t MonsterAI::MakeKey(const float heroHealth, const float monsterHealth, const bool monsterToMove) const {
+    const uint64_t healthBits = (floatBits(heroHealth) << 32) | floatBits(monsterHealth);
+    return mixKey(statsKey ^ mixKey(healthBits) ^ (monsterToMove ? 1u : 0u));
+}
+
+void MonsterAI::SetSearchDepth(const MonsterType type, const int depth) {
+    const int clamped = std::clamp(depth, 1, MAX_DEPTH);
+
+    if (type == MonsterType::BOSS) {
+        bossDepth = clamped;
+    } else {
+        normalDepth = clamped;
+    }
+}
+
+int MonsterAI::GetSearchDepth(const MonsterType type) const {
+    return type == MonsterType::BOSS ? bossDepth : normalDepth;
+}
+
+void MonsterAI::SetDifficulty(const MonsterDifficulty difficulty) {
+    switch (difficulty) {
+        case MonsterDifficulty::EASY:
+            normalDepth = 1;
+            bossDepth = 2;
+            break;
+        case MonsterDifficulty::NORMAL:
+            normalDepth = 2;
+            bossDepth = 6;
+            break;
+        case MonsterDifficulty::HARD:
+            normalDepth = 4;
+            bossDepth = MAX_DEPTH;
+            break;
+    }
+}
+
+void MonsterAI::SetNodeBudget(const uint32_t budget) {
+    nodeBudget = budget;
+}
+
+void MonsterAI::ClearTable() {
+    table.fill(TableEntry{});
+}
+
+const MonsterSearchStats &MonsterAI::GetLastSearchStats() const {
+    return stats;
+}
@@ -0,0 +1,173 @@
+#include "C:/DandD/include/Core/MonsterMovement.h"
+
+MonsterMovement::MonsterMovement(const int chaseRadius)
+    : field(chaseRadius),
+      mapGeneration(0),
+      changesApplied(0),
+      heroActor(ActorId::Invalid()) {
+}
+
+size_t MonsterMovement::Tick(Map &map, const Position &heroPos) {
+    SyncField(map, heroPos);
+
+    MonsterStore &monsters = map.getMonsters();
+    const int width = static_cast<int>(map.getWidth());
+
+    // Aggro checks for every monster at once, against this turn's positions. Sight only wakes monsters
+    // up, so the sweep is skipped once every monster in reach is already chasing.
+    sight.BeginTurn();
+    if (AnyMonsterUnaware(monsters)) {
+        sight.CanSeeTarget(map, monsters, heroPos, field.GetMaxDistance(), seesHero);
+    } else {
+        seesHero.assign(monsters.Size(), 0);
+    }
+
+    // Defeated monsters are gone from the board and do not block anyone
+    for (size_t i = 0; i < monsters.Size(); i++) {
+        if (monsters.IsAlive(i)) {
+            occupied[monsters.GetPosition(i).y * width + monsters.GetPosition(i).x] = 1;
+        }
+    }
+
+    WakeMonsters(monsters);
+
+    // The hero's step used up its energy; everyone due before its next turn acts, in schedule order
+    scheduler.Spend(heroActor);
+    size_t moved = 0;
+    for (ActorId actor = scheduler.Next(); actor != heroActor; actor = scheduler.Next()) {
+        const ScheduledActor &entry = scheduler.Get(actor);
+
+        if (entry.kind == ActorKind::MONSTER) {
+            if (!monsters.IsValid(entry.monster)) {
+                scheduler.Remove(actor); // Removed from the level since the schedule was built
+                continue;
+            }
+
+            const size_t index = monsters.IndexOf(entry.monster);
+            if (!CanAct(monsters, index)) {
+                // Idle monsters leave the schedule, so the hero's steps stop paying for them
+                if (field.GetDistance(monsters.GetPosition(index).x, monsters.GetPosition(index).y) ==
+                    FlowField::UNREACHED) {
+                    monsters.SetAggro(index, false); // Lost track of the hero
+                }
+                scheduler.Remove(actor);
+                continue;
+            }
+            moved += StepMonster(monsters, index, width) ? 1 : 0;
+        }
+
+        scheduler.Spend(actor);
+    }
+
+    // Clear only the cells marked above instead of the whole grid
+    for (size_t i = 0; i < monsters.Size(); i++) {
+        if (monsters.IsAlive(i)) {
+            occupied[monsters.GetPosition(i).y * width + monsters.GetPosition(i).x] = 0;
+        }
+    }
+
+    return moved;
+}
+
+// One step down the field for an aware monster; false if it stayed put
+bool MonsterMovement::StepMonster(MonsterStore &monsters, const size_t index, const int width) {
+    if (!monsters.IsAlive(index)) return false;
+
+    const Position pos = monsters.GetPosition(index);
+    const uint16_t current = field.GetDistance(pos.x, pos.y);
+    if (current == FlowField::UNREACHED) {
+        monsters.SetAggro(index, false); // Lost track of the hero
+        return false;
+    }
+    if (seesHero[index]) {
+        monsters.SetAggro(index, true);
+    }
+    if (!monsters.IsAggro(index) || current == 0) return false; // Unaware, or already on the hero
+
+    const int dx[4] = {1, -1, 0, 0};
+    const int dy[4] = {0, 0, -1, 1};
+
+    // Fixed direction order, so replays see the same moves
+    uint16_t best = current;
+    Position bestPos = pos;
+    for (int d = 0; d < 4; d++) {
+        const Position next(pos.x + dx[d], pos.y + dy[d]);
+        const uint16_t nextDistance = field.GetDistance(next.x, next.y);
+
+        if (nextDistance < best && !occupied[next.y * width + next.x]) {
+            best = nextDistance;
+            bestPos = next;
+        }
+    }
+
+    if (best == current) return false;
+
+    occupied[pos.y * width + pos.x] = 0;
+    occupied[bestPos.y * width + bestPos.x] = 1;
+    monsters.SetPosition(index, bestPos);
+    return true;
+}
+
+void MonsterMovement::SyncField(const Map &map, const Position &heroPos) {
+    if (!field.IsBuilt() || mapGeneration != map.GetLoadGeneration()) {
+        field.Build(map, heroPos);
+        mapGeneration = map.GetLoadGeneration();
+        changesApplied = map.GetPassabilityChanges().size();
+        occupied.assign(map.getWidth() * map.getHeight(), 0);
+        RebuildSchedule(map.getMonstersConst());
+        return;
+    }
+
+    const std::vector<Position> &changes = map.GetPassabilityChanges();
+    for (; changesApplied < changes.size(); changesApplied++) {
+        field.OnCellChanged(map, changes[changesApplied]);
+    }
+
+    field.MoveGoal(heroPos);
+}
+
+// Fresh level: only the hero is scheduled, monsters join once they can act
+void MonsterMovement::RebuildSchedule(const MonsterStore &monsters) {
+    scheduler.Clear();
+    scheduler.Reserve(monsters.Size() + 1);
+    heroActor = scheduler.Add(ActorKind::HERO, MonsterHandle::Invalid(), HERO_SPEED);
+    monsterActors.assign(monsters.Size(), ActorId::Invalid());
+}
+
+void MonsterMovement::WakeMonsters(const MonsterStore &monsters) {
+    // A plain sweep: the sight checks just filled seesHero for everyone, and CanAct is a few array reads
+    for (size_t index = 0; index < monsters.Size(); index++) {
+        if (!CanAct(monsters, index)) continue;
+
+        const MonsterHandle handle = monsters.HandleAt(index);
+        if (handle.slot >= monsterActors.size()) {
+            monsterActors.resize(handle.slot + 1, ActorId::Invalid());
+        }
+
+        // A stale id, or one left behind by a removed monster whose slot was reused, means parked
+        const ActorId actor = monsterActors[handle.slot];
+        if (scheduler.IsValid(actor) && scheduler.Get(actor).monster == handle) continue;
+
+        const int speed = monsters.GetType(index) == MonsterType::BOSS ? BOSS_SPEED : MONSTER_SPEED;
+        monsterActors[handle.slot] = scheduler.Add(ActorKind::MONSTER, handle, speed);
+    }
+}
+
+bool MonsterMovement::AnyMonsterUnaware(const MonsterStore &monsters) const {
+    for (size_t index = 0; index < monsters.Size(); index++) {
+        if (!monsters.IsAlive(index) || monsters.IsAggro(index)) continue;
+
+        const Position &pos = monsters.GetPosition(index);
+        if (field.GetDistance(pos.x, pos.y) != FlowField::UNREACHED) return true;
+    }
+
+    return false;
+}
+
+bool MonsterMovement::CanAct(const MonsterStore &monsters, const size_t index) const {
+    if (!monsters.IsAlive(index)) return false;
+
+    const Position &pos = monsters.GetPosition(index);
+    if (field.GetDistance(pos.x, pos.y) == FlowField::UNREACHED) return false;
+    return monsters.IsAggro(index) || seesHero[index];
+}
@@ -0,0 +1,167 @@
+#include "C:/DandD/include/Core/MonsterStore.h"
+#include "C:/DandD/include/Utils/BalanceTables.h"
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+MonsterStore::MonsterStore() = default;
+
+MonsterHandle MonsterStore::Add(const Position &pos, const int level, const MonsterType type) {
+    // Reuse a freed slot if there is one; its generation was bumped on removal
+    uint32_t slot;
+    if (!freeSlots.empty()) {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+    } else {
+        slot = static_cast<uint32_t>(slotToDense.size());
+        slotToDense.push_back(NO_INDEX);
+        slotGeneration.push_back(0);
+    }
+
+    slotToDense[slot] = static_cast<uint32_t>(positions.size());
+
+    positions.push_back(pos);
+    health.push_back(static_cast<float>(Balance::monsterStats(level).health));
+    levels.push_back(level);
+    types.push_back(type);
+    alive.push_back(1);
+    aggro.push_back(0);
+    denseToSlot.push_back(slot);
+    spatialIndex.Insert(slot, pos);
+
+    return {slot, slotGeneration[slot]};
+}
+
+void MonsterStore::Remove(const MonsterHandle handle) {
+    const size_t index = IndexOf(handle);
+    const size_t last = positions.size() - 1;
+    spatialIndex.Remove(handle.slot, positions[index]);
+
+    // Swap the last monster into the hole so the arrays stay dense
+    if (index != last) {
+        positions[index] = positions[last];
+        health[index] = health[last];
+        levels[index] = levels[last];
+        types[index] = types[last];
+        alive[index] = alive[last];
+        aggro[index] = aggro[last];
+        denseToSlot[index] = denseToSlot[last];
+        slotToDense[denseToSlot[index]] = static_cast<uint32_t>(index);
+    }
+
+    positions.pop_back();
+    health.pop_back();
+    levels.pop_back();
+    types.pop_back();
+    alive.pop_back();
+    aggro.pop_back();
+    denseToSlot.pop_back();
+
+    slotToDense[handle.slot] = NO_INDEX;
+    slotGeneration[handle.slot]++;
+    freeSlots.push_back(handle.slot);
+}
+
+void MonsterStore::Clear() {
+    // Keep the slot table so handles from the previous level can still be recognised as stale
+    for (const uint32_t slot: denseToSlot) {
+        slotToDense[slot] = NO_INDEX;
+        slotGeneration[slot]++;
+        freeSlots.push_back(slot);
+    }
+    spatialIndex.Clear();
+
+    positions.clear();
+    health.clear();
+    levels.clear();
+    types.clear();
+    alive.clear();
+    aggro.clear();
+    denseToSlot.clear();
+}
+
+bool MonsterStore::IsValid(const MonsterHandle handle) const {
+    return handle.slot < slotToDense.size() &&
+           slotGeneration[handle.slot] == handle.generation &&
+           slotToDense[handle.slot] != NO_INDEX;
+}
+
+size_t MonsterStore::IndexOf(const MonsterHandle handle) const {
+    if (!IsValid(handle)) {
+        std::cerr << "Stale monster handle (slot " << handle.slot << ", generation " << handle.generation << ")"
+                << std::endl;
+        throw std::runtime_error("Stale monster handle");
+    }
+
+    return slotToDense[handle.slot];
+}
+
+MonsterHandle MonsterStore::HandleAt(const size_t index) const {
+    const uint32_t slot = denseToSlot[index];
+    return {slot, slotGeneration[slot]};
+}
+
+MonsterHandle MonsterStore::FindAliveAt(const Position &pos) const {
+    // Lowest dense index wins, as with a plain scan, so replays pick the same monster
+    size_t found = NO_INDEX;
+    queryScratch.clear();
+    spatialIndex.Query(pos.x, pos.y, pos.x, pos.y, queryScratch);
+    for (const uint32_t slot: queryScratch) {
+        const size_t i = slotToDense[slot];
+        if (alive[i] && positions[i] == pos && i < found) {
+            found = i;
+        }
+    }
+
+    return found == NO_INDEX ? MonsterHandle::Invalid() : HandleAt(found);
+}
+
+void MonsterStore::QueryArea(const int minX, const int minY, const int maxX, const int maxY,
+                             std::vector<size_t> &out) const {
+    const size_t first = out.size();
+
+    queryScratch.clear();
+    spatialIndex.Query(minX, minY, maxX, maxY, queryScratch);
+    for (const uint32_t slot: queryScratch) {
+        const size_t i = slotToDense[slot];
+        if (positions[i].x >= minX && positions[i].x <= maxX && positions[i].y >= minY && positions[i].y <= maxY) {
+            out.push_back(i);
+        }
+    }
+
+    std::sort(out.begin() + first, out.end());
+}
+
+void MonsterStore::SetPosition(const size_t index, const Position &pos) {
+    spatialIndex.Move(denseToSlot[index], positions[index], pos);
+    positions[index] = pos;
+}
+
+size_t MonsterStore::CountAlive(const MonsterType type) const {
+    size_t count = 0;
+    for (size_t i = 0; i < types.size(); i++) {
+        count += (types[i] == type && alive[i]) ? 1 : 0;
+    }
+
+    return count;
+}
+
+float MonsterStore::GetMaxHealth(const size_t index) const {
+    return static_cast<float>(Balance::monsterStats(levels[index]).health);
+}
+
+void MonsterStore::SetHealth(const size_t index, const float newHealth) {
+    health[index] = std::clamp(newHealth, 0.0f, GetMaxHealth(index));
+    alive[index] = health[index] > 0 ? 1 : 0;
+}
+
+// Same semantics as Monster::setDefeated: defeated drops to zero, otherwise back to full health
+void MonsterStore::SetDefeated(const size_t index, const bool defeated) {
+    SetHealth(index, defeated ? 0.0f : GetMaxHealth(index));
+}
+
+Monster MonsterStore::MakeCombatant(const size_t index) const {
+    Monster monster(positions[index], levels[index], types[index]);
+    monster.SetHealth(health[index]);
+    return monster;
+}
@@ -0,0 +1,329 @@
+#include "C:/DandD/include/Core/Pathfinder.h"
+#include <algorithm>
+#include <cstdlib>
+
+namespace {
+    int firstSetBit(const uint64_t bits) { return __builtin_ctzll(bits); }
+
+    int lastSetBit(const uint64_t bits) { return 63 - __builtin_clzll(bits); }
+}
+
+Pathfinder::Pathfinder()
+    : width(0),
+      height(0),
+      wordsPerColumn(0),
+      mapGeneration(0),
+      changesSeen(0),
+      goal(-1, -1),
+      bestCell(-1),
+      queryStamp(0),
+      timeBudget(std::chrono::microseconds(1000)),
+      stats{} {
+}
+
+bool Pathfinder::FindPath(const Map &map, const Position &start, const Position &goalPos,
+                          std::vector<Position> &path) {
+    SyncGrid(map);
+
+    const auto startTime = std::chrono::steady_clock::now();
+    const auto deadline = startTime + timeBudget - timeBudget / RESERVE_DIVISOR;
+
+    stats = PathQueryStats{};
+    path.clear();
+    open.clear();
+
+    // A new stamp forgets the previous query's nodes; only a wrap-around needs the array touched
+    if (++queryStamp == 0) {
+        for (Node &node: nodes) {
+            node.stamp = 0;
+        }
+        queryStamp = 1;
+    }
+    goal = goalPos;
+
+    if (!IsFree(start.x, start.y)) {
+        return false;
+    }
+
+    path.push_back(start);
+    if (!IsFree(goal.x, goal.y)) {
+        return false;
+    }
+    if (start == goal) {
+        return true;
+    }
+    path.clear();
+
+    const int startCell = start.y * width + start.x;
+    const int goalCell = goal.y * width + goal.x;
+    bestCell = startCell;
+    Push(startCell, -1, 0, ALL_DIRECTIONS);
+
+    bool found = false;
+    while (!open.empty()) {
+        std::pop_heap(open.begin(), open.end());
+        const OpenEntry entry = open.back();
+        open.pop_back();
+
+        const Node &node = nodes[entry.cell];
+        if (entry.g != node.g || node.pending == 0) continue; // Superseded entry
+
+        if (entry.cell == goalCell) {
+            found = true;
+            break;
+        }
+
+        stats.expanded++;
+        // Walking back a partial path takes time as well, so stop early enough to build the best one so far
+        if (timeBudget.count() > 0 && stats.expanded % TIME_CHECK_INTERVAL == 0 &&
+            std::chrono::steady_clock::now() + std::chrono::nanoseconds(nodes[bestCell].g * BUILD_NANOS_PER_CELL) >=
+            deadline) {
+            stats.budgetExceeded = true;
+            break;
+        }
+
+        Expand(entry.cell);
+    }
+
+    BuildPath(found ? goalCell : bestCell, path);
+    stats.elapsedMicros = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - startTime).count();
+
+    return found;
+}
+
+void Pathfinder::SetTimeBudget(const std::chrono::microseconds budget) {
+    timeBudget = budget;
+}
+
+const PathQueryStats &Pathfinder::GetLastQueryStats() const {
+    return stats;
+}
+
+void Pathfinder::SyncGrid(const Map &map) {
+    const std::vector<Position> &changes = map.GetPassabilityChanges();
+
+    if (wordsPerColumn > 0 && mapGeneration == map.GetLoadGeneration()) {
+        // A wall changes the forced bits of its neighbours too
+        for (; changesSeen < changes.size(); changesSeen++) {
+            const Position &cell = changes[changesSeen];
+            if (cell.x < 0 || cell.y < 0 || cell.x >= width || cell.y >= height) continue;
+
+            passable[cell.y * width + cell.x] = map.isPassable(cell.x, cell.y) ? 1 : 0;
+            for (int y = cell.y - 1; y <= cell.y + 1; y++) {
+                for (int x = cell.x - 1; x <= cell.x + 1; x++) {
+                    RefreshCellBits(x, y);
+                }
+            }
+        }
+        return;
+    }
+
+    mapGeneration = map.GetLoadGeneration();
+    changesSeen = changes.size();
+    width = static_cast<int>(map.getWidth());
+    height = static_cast<int>(map.getHeight());
+    wordsPerColumn = std::max(1, (height + 63) / 64);
+
+    passable.assign(static_cast<size_t>(width) * height, 0);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            passable[y * width + x] = map.isPassable(x, y) ? 1 : 0;
+        }
+    }
+
+    // Rows past the bottom of a column stay blocked
+    const size_t wordCount = static_cast<size_t>(width) * wordsPerColumn;
+    columnBlocked.assign(wordCount, ~0ull);
+    forcedDown.assign(wordCount, 0);
+    forcedUp.assign(wordCount, 0);
+
+    for (int x = 0; x < width; x++) {
+        for (int y = 0; y < height; y++) {
+            RefreshCellBits(x, y);
+        }
+    }
+
+    nodes.assign(passable.size(), Node{0, -1, 0, 0, 0});
+    queryStamp = 0;
+}
+
+void Pathfinder::RefreshCellBits(const int x, const int y) {
+    if (x < 0 || y < 0 || x >= width || y >= height) return;
+
+    const size_t word = static_cast<size_t>(x) * wordsPerColumn + (y >> 6);
+    const uint64_t bit = 1ull << (y & 63);
+    columnBlocked[word] |= bit;
+    forcedDown[word] &= ~bit;
+    forcedUp[word] &= ~bit;
+    if (!IsFree(x, y)) return;
+
+    columnBlocked[word] &= ~bit;
+
+    // A side cell that is open here but walled one step back is where a vertical scan must stop
+    const bool leftOpen = IsFree(x - 1, y);
+    const bool rightOpen = IsFree(x + 1, y);
+    if ((leftOpen && !IsFree(x - 1, y - 1)) || (rightOpen && !IsFree(x + 1, y - 1))) {
+        forcedDown[word] |= bit;
+    }
+    if ((leftOpen && !IsFree(x - 1, y + 1)) || (rightOpen && !IsFree(x + 1, y + 1))) {
+        forcedUp[word] |= bit;
+    }
+}
+
+bool Pathfinder::IsFree(const int x, const int y) const {
+    return x >= 0 && y >= 0 && x < width && y < height && passable[y * width + x];
+}
+
+int Pathfinder::ScanColumn(const int x, const int y, const int dy) const {
+    const uint64_t *blocked = &columnBlocked[static_cast<size_t>(x) * wordsPerColumn];
+    const uint64_t *forced = &(dy > 0 ? forcedDown : forcedUp)[static_cast<size_t>(x) * wordsPerColumn];
+    const int goalRow = goal.x == x ? goal.y : -1;
+
+    // Stop at the first wall, forced cell or the goal; only the last two are jump points
+    if (dy > 0) {
+        const int from = y + 1;
+        if (from >= height) return -1;
+
+        for (int word = from >> 6; word < wordsPerColumn; word++) {
+            uint64_t bits = blocked[word] | forced[word];
+            if (word == from >> 6) bits &= ~0ull << (from & 63);
+            if (goalRow >= from && goalRow >> 6 == word) bits |= 1ull << (goalRow & 63);
+
+            if (bits) {
+                const int row = (word << 6) + firstSetBit(bits);
+                return blocked[word] >> (row & 63) & 1 ? -1 : row;
+            }
+        }
+    } else {
+        const int from = y - 1;
+        if (from < 0) return -1;
+
+        for (int word = from >> 6; word >= 0; word--) {
+            uint64_t bits = blocked[word] | forced[word];
+            if (word == from >> 6 && (from & 63) != 63) bits &= (1ull << ((from & 63) + 1)) - 1;
+            if (goalRow >= 0 && goalRow <= from && goalRow >> 6 == word) bits |= 1ull << (goalRow & 63);
+
+            if (bits) {
+                const int row = (word << 6) + lastSetBit(bits);
+                return blocked[word] >> (row & 63) & 1 ? -1 : row;
+            }
+        }
+    }
+
+    return -1;
+}
+
+int Pathfinder::ScanRow(const int x, const int y, const int dx) const {
+    // Every cell of a horizontal run may turn vertically, so it becomes a jump point when a column scan finds one.
+    // A long run stops early at an extra jump point that carries on, so the deadline is checked between pieces.
+    for (int nx = x + dx, steps = 1; IsFree(nx, y); nx += dx, steps++) {
+        if (nx == goal.x && y == goal.y) return nx;
+        if (ScanColumn(nx, y, 1) >= 0 || ScanColumn(nx, y, -1) >= 0) return nx;
+        if (steps == MAX_ROW_SCAN) return nx;
+    }
+
+    return -1;
+}
+
+void Pathfinder::Expand(const int cell) {
+    Node &node = nodes[cell];
+    const uint8_t directions = node.pending;
+    const uint32_t g = node.g;
+    node.done |= directions;
+    node.pending = 0;
+
+    const int x = cell % width;
+    const int y = cell / width;
+
+    if (directions & RIGHT) {
+        const int nx = ScanRow(x, y, 1);
+        if (nx >= 0) Push(y * width + nx, cell, g + (nx - x), DirectionsAfterRow(1));
+    }
+    if (directions & LEFT) {
+        const int nx = ScanRow(x, y, -1);
+        if (nx >= 0) Push(y * width + nx, cell, g + (x - nx), DirectionsAfterRow(-1));
+    }
+    if (directions & DOWN) {
+        const int ny = ScanColumn(x, y, 1);
+        if (ny >= 0) Push(ny * width + x, cell, g + (ny - y), DirectionsAfterColumn(x, ny, 1));
+    }
+    if (directions & UP) {
+        const int ny = ScanColumn(x, y, -1);
+        if (ny >= 0) Push(ny * width + x, cell, g + (y - ny), DirectionsAfterColumn(x, ny, -1));
+    }
+}
+
+void Pathfinder::Push(const int cell, const int parent, const uint32_t g, const uint8_t directions) {
+    Node &node = nodes[cell];
+
+    if (node.stamp != queryStamp || g < node.g) {
+        node = {g, parent, queryStamp, directions, 0};
+    } else if (g == node.g) {
+        // Same cost from another direction: expand whatever that direction adds
+        const uint8_t added = directions & ~(node.done | node.pending);
+        if (added == 0) return;
+        node.pending |= added;
+    } else {
+        return;
+    }
+
+    const uint32_t h = Heuristic(cell);
+    open.push_back({g + h, g, cell});
+    std::push_heap(open.begin(), open.end());
+    stats.generated++;
+
+    // Remember the cell nearest to the goal for partial paths
+    const uint32_t bestH = Heuristic(bestCell);
+    if (h < bestH || (h == bestH && g < nodes[bestCell].g)) {
+        bestCell = cell;
+    }
+}
+
+// Natural successors after a horizontal step: keep going, or turn up or down
+uint8_t Pathfinder::DirectionsAfterRow(const int dx) {
+    return (dx > 0 ? RIGHT : LEFT) | DOWN | UP;
+}
+
+// After a vertical step: keep going, plus sideways only where a wall just ended (forced neighbours)
+uint8_t Pathfinder::DirectionsAfterColumn(const int x, const int y, const int dy) const {
+    uint8_t directions = dy > 0 ? DOWN : UP;
+    if (IsFree(x - 1, y) && !IsFree(x - 1, y - dy)) directions |= LEFT;
+    if (IsFree(x + 1, y) && !IsFree(x + 1, y - dy)) directions |= RIGHT;
+    return directions;
+}
+
+uint32_t Pathfinder::Heuristic(const int cell) const {
+    return static_cast<uint32_t>(std::abs(cell % width - goal.x) + std::abs(cell / width - goal.y));
+}
+
+// Walks parent links back from the end and fills in the straight runs between jump points
+void Pathfinder::BuildPath(const int endCell, std::vector<Position> &path) const {
+    path.clear();
+    path.reserve(nodes[endCell].g + 1); // g is the number of steps
+
+    for (int cell = endCell; cell >= 0;) {
+        const int parent = nodes[cell].parent;
+        int x = cell % width;
+        int y = cell / width;
+
+        if (parent < 0) {
+            path.emplace_back(x, y);
+            break;
+        }
+
+        const int px = parent % width;
+        const int py = parent / width;
+        const int stepX = (px > x) - (px < x);
+        const int stepY = (py > y) - (py < y);
+        while (x != px || y != py) {
+            path.emplace_back(x, y);
+            x += stepX;
+            y += stepY;
+        }
+
+        cell = parent;
+    }
+
+    std::reverse(path.begin(), path.end());
+}
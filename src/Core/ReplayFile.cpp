@@ -0,0 +1,138 @@
+#include "C:/DandD/include/Core/ReplayFile.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+namespace {
+    // FNV-1a over the raw bytes of a value
+    template<typename T>
+    void hashValue(uint32_t &hash, const T &value) {
+        unsigned char bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+
+        for (const unsigned char byte: bytes) {
+            hash ^= byte;
+            hash *= 16777619u;
+        }
+    }
+}
+
+ReplayFile::ReplayFile() : seed(0), race(Race::Human), difficulty(MonsterDifficulty::NORMAL) {
+}
+
+void ReplayFile::Reset(const uint32_t newSeed, const Race newRace, const MonsterDifficulty newDifficulty) {
+    seed = newSeed;
+    race = newRace;
+    difficulty = newDifficulty;
+    records.clear();
+}
+
+void ReplayFile::Append(const ReplayRecord &record) {
+    records.push_back(record);
+}
+
+uint32_t ReplayFile::GetSeed() const {
+    return seed;
+}
+
+Race ReplayFile::GetRace() const {
+    return race;
+}
+
+MonsterDifficulty ReplayFile::GetDifficulty() const {
+    return difficulty;
+}
+
+const std::vector<ReplayRecord> &ReplayFile::GetRecords() const {
+    return records;
+}
+
+void ReplayFile::Save(const std::string &filePath) const {
+    const std::filesystem::path path(filePath);
+    if (path.has_parent_path()) {
+        std::filesystem::create_directories(path.parent_path());
+    }
+
+    std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        throw std::runtime_error("Could not open replay file for writing: " + filePath);
+    }
+
+    const ReplayHeader header{
+        MAGIC, VERSION, static_cast<uint8_t>(race), static_cast<uint8_t>(difficulty), seed, static_cast<uint32_t>(records.size())
+    };
+
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char *>(records.data()),
+               static_cast<std::streamsize>(records.size() * sizeof(ReplayRecord)));
+
+    if (!file) {
+        throw std::runtime_error("Failed to write replay file: " + filePath);
+    }
+}
+
+ReplayFile ReplayFile::Load(const std::string &filePath) {
+    std::ifstream file(filePath, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Could not open replay file: " + filePath);
+    }
+
+    ReplayHeader header{};
+    file.read(reinterpret_cast<char *>(&header), sizeof(header));
+
+    if (!file || header.magic != MAGIC) {
+        throw std::runtime_error("Not a replay file: " + filePath);
+    }
+    if (header.version != VERSION) {
+        throw std::runtime_error("Unsupported replay version " + std::to_string(header.version));
+    }
+    if (header.difficulty > static_cast<uint8_t>(MonsterDifficulty::HARD)) {
+        throw std::runtime_error("Unknown monster difficulty in replay file: " + filePath);
+    }
+
+    // The count comes from the file, so it must match what is actually there before anything is allocated
+    const std::streamoff dataStart = file.tellg();
+    file.seekg(0, std::ios::end);
+    const std::streamoff dataSize = file.tellg() - dataStart;
+    file.seekg(dataStart);
+
+    if (!file || static_cast<uint64_t>(header.recordCount) * sizeof(ReplayRecord) != static_cast<uint64_t>(dataSize)) {
+        throw std::runtime_error("Replay file size does not match its record count: " + filePath);
+    }
+
+    ReplayFile replay;
+    replay.Reset(header.seed, static_cast<Race>(header.race), static_cast<MonsterDifficulty>(header.difficulty));
+    replay.records.resize(header.recordCount);
+
+    file.read(reinterpret_cast<char *>(replay.records.data()),
+              static_cast<std::streamsize>(replay.records.size() * sizeof(ReplayRecord)));
+
+    if (!file) {
+        throw std::runtime_error("Replay file is truncated: " + filePath);
+    }
+
+    return replay;
+}
+
+uint32_t ReplayFile::ComputeChecksum(const Hero &hero) {
+    uint32_t hash = 2166136261u;
+
+    hashValue(hash, hero.GetHealth());
+    hashValue(hash, hero.GetMaxHealth());
+    hashValue(hash, hero.GetXP());
+    hashValue(hash, hero.GetLevel());
+    hashValue(hash, hero.GetStrength());
+    hashValue(hash, hero.GetMana());
+
+    const Position position = hero.getCurrentPosition();
+    hashValue(hash, position.x);
+    hashValue(hash, position.y);
+
+    const Inventory &inventory = hero.GetInventory();
+    hashValue(hash, inventory.GetWeapon().GetBonus());
+    hashValue(hash, inventory.GetArmor().GetBonus());
+    hashValue(hash, inventory.GetSpell().GetBonus());
+
+    return hash;
+}
@@ -0,0 +1,330 @@
+#include "C:/DandD/include/Core/ReplayPlayer.h"
+#include "C:/DandD/include/Utils/ProbabilitySystem.h"
+#include <algorithm>
+#include <utility>
+
+ReplayPlayer::ReplayPlayer(std::string mapFilePath)
+    : mapFilePath(std::move(mapFilePath)),
+      hero(nullptr),
+      phase(Phase::GAMEPLAY),
+      currentLevel(1),
+      levelComplete(false),
+      lastResult(BattleResult::ONGOING),
+      verifyCheckpoints(true),
+      stats{} {
+    battleSystem.SetMap(&map);
+
+    battleSystem.SetBattleEndCallback([this](const BattleResult result) {
+        OnBattleEnd(result);
+    });
+
+    // Same hook the live recorder uses, so checkpoints are computed at identical points
+    battleSystem.SetEventListener([this](const BattleEvent &event) {
+        if (event.type == BattleEventType::BATTLE_ENDED && hero && verifyCheckpoints) {
+            checkpoints.push_back({event.result, ReplayFile::ComputeChecksum(*hero)});
+        }
+    });
+}
+
+ReplayStats ReplayPlayer::Play(const ReplayFile &replay) {
+    Begin(replay.GetSeed(), replay.GetRace(), replay.GetDifficulty());
+
+    for (const ReplayRecord &record: replay.GetRecords()) {
+        if (!Step(record)) {
+            break;
+        }
+    }
+
+    return GetStats();
+}
+
+void ReplayPlayer::Begin(const uint32_t seed, const Race race, const MonsterDifficulty difficulty) {
+    RandomUtils::seed(seed);
+    battleSystem.GetMonsterAI()->SetDifficulty(difficulty);
+
+    std::string raceName;
+    switch (race) {
+        case Race::Human: raceName = "Human";
+            break;
+        case Race::Mage: raceName = "Mage";
+            break;
+        case Race::Warrior: raceName = "Warrior";
+            break;
+    }
+
+    hero = std::make_unique<Hero>(raceName, "Player");
+    phase = Phase::GAMEPLAY;
+    currentLevel = 1;
+    levelComplete = false;
+    lastResult = BattleResult::ONGOING;
+    pendingItem.reset();
+    checkpoints.clear();
+    stats = ReplayStats{};
+
+    LoadLevel(currentLevel);
+    hero->setPosition(map.getStartPos());
+    stats.levelReached = currentLevel;
+}
+
+bool ReplayPlayer::Step(const ReplayRecord &record) {
+    if (!hero || stats.desynced) return false;
+
+    if (!ApplyRecord(record)) {
+        return false;
+    }
+
+    stats.recordsApplied++;
+    return true;
+}
+
+void ReplayPlayer::SetCheckpointVerification(const bool enabled) {
+    verifyCheckpoints = enabled;
+}
+
+ReplayPlayer::Phase ReplayPlayer::GetPhase() const {
+    return phase;
+}
+
+const Hero &ReplayPlayer::GetHero() const {
+    return *hero;
+}
+
+const Map &ReplayPlayer::GetMap() const {
+    return map;
+}
+
+const Item *ReplayPlayer::GetPendingItem() const {
+    return pendingItem ? &*pendingItem : nullptr;
+}
+
+ReplayStats ReplayPlayer::GetStats() const {
+    ReplayStats result = stats;
+
+    if (hero) {
+        result.heroLevel = hero->GetLevel();
+        result.finalChecksum = ReplayFile::ComputeChecksum(*hero);
+    }
+
+    return result;
+}
+
+bool ReplayPlayer::ApplyRecord(const ReplayRecord &record) {
+    if (record.type == ReplayInputType::MOVE) {
+        return ApplyMove(record);
+    }
+    if (record.type == ReplayInputType::CHECKPOINT) {
+        return ApplyCheckpoint(record);
+    }
+
+    // Encounters are checked every frame in the live game, even on frames without movement
+    if (phase == Phase::GAMEPLAY) {
+        CheckTriggers();
+    }
+
+    switch (record.type) {
+        case ReplayInputType::BATTLE_ACTION:
+            return ApplyBattleAction(record);
+
+        case ReplayInputType::AUTO_BATTLE:
+            return ApplyAutoBattle(record);
+
+        case ReplayInputType::EQUIPMENT:
+            if (phase != Phase::EQUIPMENT || !pendingItem) {
+                return Desync(record, "equipment choice outside of equipment selection");
+            }
+
+            if (record.args[0] != 0) {
+                hero->GetInventory().equip(*pendingItem);
+            }
+            pendingItem.reset();
+            phase = Phase::GAMEPLAY;
+
+            // A boss drop held the level back until it was decided
+            if (levelComplete) {
+                TransitionToNextLevel();
+            }
+            return true;
+
+        case ReplayInputType::LEVEL_UP:
+            if (phase != Phase::LEVEL_UP) {
+                return Desync(record, "level up outside of level up panel");
+            }
+
+            hero->levelUp(record.args[0], record.args[1], record.args[2]);
+            LoadLevel(currentLevel);
+            phase = Phase::GAMEPLAY;
+            return true;
+
+        default:
+            return Desync(record, "unknown record type");
+    }
+}
+
+bool ReplayPlayer::ApplyMove(const ReplayRecord &record) {
+    if (phase != Phase::GAMEPLAY) {
+        return Desync(record, "movement while gameplay is blocked");
+    }
+
+    Position newPos = hero->getCurrentPosition();
+    switch (static_cast<MoveDirection>(record.args[0])) {
+        case MoveDirection::RIGHT: newPos.x++;
+            break;
+        case MoveDirection::LEFT: newPos.x--;
+            break;
+        case MoveDirection::UP: newPos.y--;
+            break;
+        case MoveDirection::DOWN: newPos.y++;
+            break;
+    }
+
+    if (map.isPassable(newPos.x, newPos.y)) {
+        hero->setPosition(newPos);
+        monsterMovement.Tick(map, newPos);
+    }
+
+    CheckTriggers();
+    return true;
+}
+
+// Mirrors BattlePanel: the hero acts, then the monster answers while the battle is still running
+bool ReplayPlayer::ApplyBattleAction(const ReplayRecord &record) {
+    if (phase != Phase::BATTLE || !battleSystem.IsBattleActive()) {
+        return Desync(record, "battle action outside of battle");
+    }
+
+    switch (static_cast<BattleAction>(record.args[0])) {
+        case BattleAction::WEAPON:
+            battleSystem.PerformPlayerAttack(AttackType::WEAPON);
+            break;
+        case BattleAction::SPELL:
+            battleSystem.PerformPlayerAttack(AttackType::SPELL);
+            break;
+        case BattleAction::FLEE:
+            battleSystem.PlayerFlee();
+            break;
+    }
+
+    if (battleSystem.IsBattleActive()) {
+        battleSystem.PerformMonsterAttack();
+    }
+
+    if (!battleSystem.IsBattleActive()) {
+        FinishBattle();
+    }
+
+    return true;
+}
+
+// Mirrors UIManager::StartBattle in auto battle mode
+bool ReplayPlayer::ApplyAutoBattle(const ReplayRecord &record) {
+    if (phase != Phase::BATTLE || !battleSystem.IsBattleActive()) {
+        return Desync(record, "auto battle outside of battle");
+    }
+
+    battleSystem.ResolveBattle(static_cast<BattlePolicy>(record.args[0]));
+    FinishBattle();
+    return true;
+}
+
+// Back to gameplay, or to the next level when the battle cleared this one
+void ReplayPlayer::FinishBattle() {
+    phase = (lastResult == BattleResult::PLAYER_LOST) ? Phase::DEFEAT : Phase::GAMEPLAY;
+
+    // Mirrors UIManager::ShowBossDrop: the choice comes before the next level
+    if (phase == Phase::GAMEPLAY && pendingItem) {
+        phase = Phase::EQUIPMENT;
+        return;
+    }
+
+    if (phase == Phase::GAMEPLAY && levelComplete) {
+        TransitionToNextLevel();
+    }
+}
+
+bool ReplayPlayer::ApplyCheckpoint(const ReplayRecord &record) {
+    if (checkpoints.empty()) {
+        return Desync(record, "checkpoint without a finished battle");
+    }
+
+    const Checkpoint expected = checkpoints.front();
+    checkpoints.pop_front();
+
+    if (static_cast<uint8_t>(expected.result) != record.args[0] || expected.checksum != record.value) {
+        return Desync(record, "hero state differs after battle");
+    }
+
+    return true;
+}
+
+// Same order as GameManager::ProcessInput: combat first, then treasure
+void ReplayPlayer::CheckTriggers() {
+    const Position heroPos = hero->getCurrentPosition();
+
+    const MonsterHandle monster = map.getMonstersConst().FindAliveAt(heroPos);
+    if (map.getMonstersConst().IsValid(monster)) {
+        battleSystem.StartBattle(hero.get(), monster);
+        phase = Phase::BATTLE;
+        stats.battlesFought++;
+        return;
+    }
+
+    for (const Treasure &treasure: map.getTreasuresConst()) {
+        if (treasure.getPosition() == heroPos) {
+            const Treasure collected = treasure; // Copy before erasing it from the map
+            map.removeTreasure(collected);
+            pendingItem = ItemGenerator::generateRandomItem(map.GetCurrentLevel());
+            phase = Phase::EQUIPMENT;
+            stats.itemsFound++;
+            return;
+        }
+    }
+}
+
+// Mirrors UIManager::OnBattleEnd
+void ReplayPlayer::OnBattleEnd(const BattleResult result) {
+    lastResult = result;
+
+    if (result == BattleResult::PLAYER_WON) {
+        map.setCell(hero->getCurrentPosition(), '.');
+
+        const MonsterStore &monsters = map.getMonstersConst();
+        const MonsterHandle monster = battleSystem.GetCurrentMonsterHandle();
+        if (monsters.IsValid(monster) && monsters.GetType(monsters.IndexOf(monster)) == MonsterType::BOSS) {
+            pendingItem = ItemGenerator::generateBossDrop(map.GetCurrentLevel());
+            stats.itemsFound++;
+        }
+
+        if (map.IsLevelCleared()) {
+            levelComplete = true;
+        }
+    }
+}
+
+// Mirrors UIManager::LoadLevel: a failed load keeps the current level number and completion flag
+bool ReplayPlayer::LoadLevel(const int levelNumber) {
+    try {
+        map.loadFromFile(mapFilePath, "[LEVEL_" + std::to_string(levelNumber) + "]");
+        currentLevel = levelNumber;
+        levelComplete = false;
+        return true;
+    } catch (const std::exception &) {
+        return false;
+    }
+}
+
+// Mirrors GameManager::TransitionToNextLevel followed by the level up panel
+void ReplayPlayer::TransitionToNextLevel() {
+    LoadLevel(currentLevel + 1);
+    LoadLevel(currentLevel);
+    hero->setPosition(map.getStartPos());
+
+    stats.levelReached = std::max(stats.levelReached, currentLevel);
+    phase = Phase::LEVEL_UP;
+}
+
+bool ReplayPlayer::Desync(const ReplayRecord &record, const std::string &reason) {
+    stats.desynced = true;
+    stats.desyncFrame = record.frame;
+    stats.desyncReason = reason;
+    return false;
+}
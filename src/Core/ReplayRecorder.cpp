@@ -0,0 +1,88 @@
+#include "C:/DandD/include/Core/ReplayRecorder.h"
+#include <algorithm>
+
+namespace {
+    // Level up points fit in a byte; clamp defensively instead of wrapping
+    uint8_t toByte(const int value) {
+        return static_cast<uint8_t>(std::clamp(value, 0, 255));
+    }
+}
+
+ReplayRecorder::ReplayRecorder() : recording(false), currentFrame(0), autoBattle(false) {
+}
+
+void ReplayRecorder::Begin(const uint32_t seed, const Race race, const MonsterDifficulty difficulty) {
+    replay.Reset(seed, race, difficulty);
+    recording = true;
+    autoBattle = false;
+}
+
+bool ReplayRecorder::IsRecording() const {
+    return recording;
+}
+
+void ReplayRecorder::SetFrame(const uint32_t frame) {
+    currentFrame = frame;
+}
+
+void ReplayRecorder::RecordMove(const MoveDirection direction) {
+    Append(ReplayInputType::MOVE, static_cast<uint8_t>(direction));
+}
+
+void ReplayRecorder::RecordBattleEvent(const BattleEvent &event, const Hero &hero) {
+    switch (event.type) {
+        case BattleEventType::ATTACK:
+            if (autoBattle) break;
+
+            // Monster attacks are reproduced: the search is bounded by nodes, not time, and crits come from the seed
+            if (event.actor == BattleActor::HERO) {
+                const BattleAction action = event.attackType == AttackType::WEAPON
+                                                ? BattleAction::WEAPON
+                                                : BattleAction::SPELL;
+                Append(ReplayInputType::BATTLE_ACTION, static_cast<uint8_t>(action));
+            }
+            break;
+
+        case BattleEventType::FLED:
+            if (autoBattle) break;
+            Append(ReplayInputType::BATTLE_ACTION, static_cast<uint8_t>(BattleAction::FLEE));
+            break;
+
+        case BattleEventType::BATTLE_ENDED:
+            Append(ReplayInputType::CHECKPOINT, static_cast<uint8_t>(event.result), 0, 0,
+                   ReplayFile::ComputeChecksum(hero));
+            autoBattle = false;
+            break;
+
+        default:
+            break;
+    }
+}
+
+void ReplayRecorder::RecordAutoBattle(const BattlePolicy policy) {
+    Append(ReplayInputType::AUTO_BATTLE, static_cast<uint8_t>(policy));
+    autoBattle = true;
+}
+
+void ReplayRecorder::RecordLevelUp(const int strength, const int mana, const int health) {
+    Append(ReplayInputType::LEVEL_UP, toByte(strength), toByte(mana), toByte(health));
+}
+
+void ReplayRecorder::RecordEquipment(const bool equipped) {
+    Append(ReplayInputType::EQUIPMENT, equipped ? 1 : 0);
+}
+
+void ReplayRecorder::Save(const std::string &filePath) const {
+    replay.Save(filePath);
+}
+
+const ReplayFile &ReplayRecorder::GetReplay() const {
+    return replay;
+}
+
+void ReplayRecorder::Append(const ReplayInputType type, const uint8_t arg0, const uint8_t arg1, const uint8_t arg2,
+                            const uint32_t value) {
+    if (!recording) return;
+
+    replay.Append({currentFrame, type, {arg0, arg1, arg2}, value});
+}
@@ -0,0 +1,149 @@
+#include "C:/DandD/include/Core/TurnScheduler.h"
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+TurnScheduler::TurnScheduler()
+    : now(0),
+      nextTicket(0),
+      liveCount(0) {
+}
+
+ActorId TurnScheduler::Add(const ActorKind kind, const MonsterHandle monster, const int speed) {
+    uint32_t slot;
+    if (!freeSlots.empty()) {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+    } else {
+        slot = static_cast<uint32_t>(slots.size());
+        slots.push_back({{ActorKind::HERO, MonsterHandle::Invalid(), NORMAL_SPEED}, 0, false, 0, 0, 0});
+    }
+
+    Slot &entry = slots[slot];
+    entry.actor = {kind, monster, std::max(1, speed)};
+    entry.used = true;
+    entry.carry = 0;
+    liveCount++;
+
+    Schedule(slot, now);
+    return {slot, entry.generation};
+}
+
+void TurnScheduler::Remove(const ActorId id) {
+    Slot &entry = Resolve(id);
+
+    // Its queue entry stays behind and is skipped once it reaches the front
+    entry.used = false;
+    entry.generation++;
+    freeSlots.push_back(id.slot);
+    liveCount--;
+}
+
+void TurnScheduler::Clear() {
+    for (uint32_t slot = 0; slot < slots.size(); slot++) {
+        if (slots[slot].used) {
+            slots[slot].used = false;
+            slots[slot].generation++;
+            freeSlots.push_back(slot);
+        }
+    }
+
+    buckets.clear();
+    liveCount = 0;
+    now = 0;
+}
+
+void TurnScheduler::Reserve(const size_t actors) {
+    slots.reserve(actors);
+    freeSlots.reserve(actors);
+
+    // New actors all join the bucket at the current time
+    if (spareEntries.empty()) {
+        spareEntries.emplace_back();
+    }
+    spareEntries.back().reserve(actors);
+}
+
+bool TurnScheduler::IsValid(const ActorId id) const {
+    return id.slot < slots.size() && slots[id.slot].used && slots[id.slot].generation == id.generation;
+}
+
+ActorId TurnScheduler::Next() {
+    DropStaleTop();
+    if (buckets.empty()) return ActorId::Invalid();
+
+    const auto first = buckets.begin();
+    const uint32_t slot = first->second.entries[first->second.head].slot;
+    now = first->first;
+    return {slot, slots[slot].generation};
+}
+
+void TurnScheduler::Spend(const ActorId id, const int cost) {
+    Slot &entry = Resolve(id);
+
+    // Exact integer delay: cost energy at 'speed' energy per NORMAL_SPEED time units
+    const int64_t numerator = static_cast<int64_t>(cost) * NORMAL_SPEED + entry.carry;
+    const int64_t delay = numerator / entry.actor.speed;
+    entry.carry = static_cast<int>(numerator % entry.actor.speed);
+
+    // An actor acting ahead of its turn (e.g. the hero answering input) still waits a full delay from now
+    Schedule(id.slot, std::max(entry.readyTime, now) + static_cast<uint64_t>(delay));
+}
+
+const ScheduledActor &TurnScheduler::Get(const ActorId id) const {
+    if (!IsValid(id)) {
+        std::cerr << "Stale actor id (slot " << id.slot << ", generation " << id.generation << ")" << std::endl;
+        throw std::runtime_error("Stale actor id");
+    }
+
+    return slots[id.slot].actor;
+}
+
+void TurnScheduler::SetSpeed(const ActorId id, const int speed) {
+    Slot &entry = Resolve(id);
+    entry.actor.speed = std::max(1, speed);
+    entry.carry = 0;
+}
+
+TurnScheduler::Slot &TurnScheduler::Resolve(const ActorId id) {
+    if (!IsValid(id)) {
+        std::cerr << "Stale actor id (slot " << id.slot << ", generation " << id.generation << ")" << std::endl;
+        throw std::runtime_error("Stale actor id");
+    }
+
+    return slots[id.slot];
+}
+
+void TurnScheduler::Schedule(const uint32_t slot, const uint64_t readyTime) {
+    Slot &entry = slots[slot];
+    entry.readyTime = readyTime;
+    entry.ticket = nextTicket++;
+
+    // Actors that just had their turn mostly land on the same few times, so this is usually a short lookup
+    const auto [bucket, created] = buckets.try_emplace(readyTime);
+    if (created) {
+        bucket->second.head = 0;
+        if (!spareEntries.empty()) {
+            bucket->second.entries = std::move(spareEntries.back());
+            spareEntries.pop_back();
+        }
+    }
+    bucket->second.entries.push_back({entry.ticket, slot});
+}
+
+void TurnScheduler::DropStaleTop() {
+    while (!buckets.empty()) {
+        const auto first = buckets.begin();
+        Bucket &bucket = first->second;
+
+        for (; bucket.head < bucket.entries.size(); bucket.head++) {
+            const QueueEntry &front = bucket.entries[bucket.head];
+            const Slot &entry = slots[front.slot];
+            if (entry.used && entry.ticket == front.ticket) return;
+        }
+
+        bucket.entries.clear();
+        spareEntries.push_back(std::move(bucket.entries));
+        buckets.erase(first);
+    }
+}
@@ -28,7 +28,11 @@ Hero::Hero(const std::string &raceName, std::string heroName)
           Spell("Fireball", 20, 1)),
       startingPosition{0, 0},
       currentPosition(startingPosition),
-      name(std::move(heroName)) {
+      name(std::move(heroName)),
+      stats{},
+      statsVersion(0),
+      statsInventoryVersion(0),
+      statsDirty(true) {
     // Race-specific attribute initialization
     switch (race) {
         case Race::Human:
@@ -94,17 +98,17 @@ void Hero::takeDamage(const float damage) {
     }
 }
 
-// Equipment bonus calculations (converted to decimal percentages)
+// Equipment bonuses, served from the derived stats cache
 float Hero::GetWeaponBonus() const {
-    return inventory.GetWeapon().GetBonus() / 100;
+    return GetStats().weaponBonus;
 }
 
 float Hero::GetSpellBonus() const {
-    return inventory.GetSpell().GetBonus() / 100;
+    return GetStats().spellBonus;
 }
 
 float Hero::GetArmorReduction() const {
-    return inventory.GetArmor().GetBonus() / 100; // Damage reduction percentage
+    return GetStats().armorReduction; // Damage reduction percentage
 }
 
 bool Hero::isDefeated() const {
@@ -127,14 +131,17 @@ Position Hero::getStartingPosition() const {
 // Attribute setters
 void Hero::SetStrength(const int str) {
     strength = str;
+    statsDirty = true;
 }
 
 void Hero::SetMana(const int mna) {
     mana = mna;
+    statsDirty = true;
 }
 
 void Hero::SetMaxHealth(const float hlth) {
     maxHealth = hlth;
+    statsDirty = true;
     // Adjust current health if over new max
     if (health > maxHealth) {
         health = maxHealth;
@@ -177,6 +184,10 @@ Inventory &Hero::GetInventory() {
     return inventory;
 }
 
+const Inventory &Hero::GetInventory() const {
+    return inventory;
+}
+
 // Character progression
 void Hero::levelUp(const int str, const int mna, const float hlth) {
     // Apply stat increases
@@ -185,6 +196,7 @@ void Hero::levelUp(const int str, const int mna, const float hlth) {
     this->health += hlth;
     this->maxHealth += hlth;
     this->level++; // Increment level
+    statsDirty = true;
 }
 
 // Post-battle recovery
@@ -200,3 +212,33 @@ void Hero::restoreHealthAfterBattle() {
         std::cout << GetName() << " kept their current health of " << health << "." << std::endl;
     }
 }
+
+// Derived stats, recomputed first if an attribute or the equipment changed since the last call
+const HeroStats &Hero::GetStats() const {
+    if (statsDirty || statsInventoryVersion != inventory.GetVersion()) {
+        RefreshStats();
+    }
+
+    return stats;
+}
+
+uint32_t Hero::GetStatsVersion() const {
+    GetStats(); // Picks up pending changes first
+    return statsVersion;
+}
+
+void Hero::RefreshStats() const {
+    stats.strength = strength;
+    stats.mana = mana;
+    stats.maxHealth = maxHealth;
+    stats.level = level;
+
+    // Converted to decimal percentages
+    stats.weaponBonus = inventory.GetWeapon().GetBonus() / 100;
+    stats.spellBonus = inventory.GetSpell().GetBonus() / 100;
+    stats.armorReduction = inventory.GetArmor().GetBonus() / 100;
+
+    statsInventoryVersion = inventory.GetVersion();
+    statsDirty = false;
+    statsVersion++;
+}
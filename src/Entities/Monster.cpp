@@ -1,19 +1,17 @@
 #include "../../include/Entities/Monster.h"
 
-// Monster constructor: Scales stats based on level
+// Monster constructor: Stats come from the compile-time balance table for the level
 Monster::Monster(const Position &pos, const int curlvl, const MonsterType _type)
     : level(curlvl), pos(pos), type(_type) {
-    const int levelBonus = (level - 1) * 10; // Linear scaling per level
+    const Balance::MonsterStats &stats = Balance::monsterStats(level);
 
-    health = BASE_HEALTH + levelBonus;
+    health = static_cast<float>(stats.health);
     maxHealth = health;
-    strength = BASE_STRENGTH + levelBonus;
-    mana = BASE_MANA + levelBonus;
+    strength = stats.strength;
+    mana = stats.mana;
+    scaleArmor = stats.armor; // Already capped at level 17
 
-    // Armor scaling caps at level 17
-    scaleArmor = (level < 17) ? 15 + level * 5 : 95;
-
-    name = "Level " + std::to_string(level) + " dragon";
+    name = Balance::monsterName(level);
 }
 
 bool Monster::operator==(const Monster &other) const {
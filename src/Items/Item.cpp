@@ -1,23 +1,33 @@
 #include "C:/DandD/include/Items/Item.h"
+#include <type_traits>
 
-// Item constructor
+static_assert(std::is_trivially_copyable_v<Item>, "Items are copied around by value");
+static_assert(sizeof(Item) <= 16, "Items should stay compact");
+
+// Item constructors
 Item::Item(const std::string &n, const double _bonus, const int _level,
-           const ItemType _type) : name(n), bonus(_bonus), level(_level), type(_type) {
+           const ItemType _type) : bonus(_bonus), level(_level), nameId(ItemNames::Intern(n)), type(_type) {
+}
+
+Item::Item(const ItemNameId _nameId, const double _bonus, const int _level, const ItemType _type,
+           const ItemRarity _rarity) : bonus(_bonus), level(_level), nameId(_nameId), type(_type), rarity(_rarity) {
 }
 
 // Accessors
-std::string Item::GetName() const { return name; }
+const std::string &Item::GetName() const { return ItemNames::Get(nameId); }
+ItemNameId Item::GetNameId() const { return nameId; }
 double Item::GetBonus() const { return bonus; }
 int Item::GetLevel() const { return level; }
 ItemType Item::GetType() const { return type; }
+ItemRarity Item::GetRarity() const { return rarity; }
 
 // Setters
-void Item::SetName(const std::string &name) { this->name = name; }
+void Item::SetName(const std::string &name) { this->nameId = ItemNames::Intern(name); }
 void Item::SetBonus(const float bonus) { this->bonus = bonus; }
 void Item::SetLevel(const int level) { this->level = level; }
 
 // Converts item type to string
-std::string Item::GetTypeStr() const {
+const char *Item::GetTypeStr() const {
     switch (type) {
         case ItemType::ARMOR: return "ARMOR";
         case ItemType::WEAPON: return "WEAPON";
@@ -0,0 +1,33 @@
+#include "C:/DandD/include/Items/ItemNames.h"
+#include <iostream>
+#include <stdexcept>
+
+ItemNameId ItemNames::Intern(const std::string &name) {
+    const auto found = ids.find(name);
+    if (found != ids.end()) {
+        return found->second;
+    }
+
+    if (names.size() >= MAX_NAMES) {
+        std::cerr << "Too many distinct item names, cannot add: " << name << std::endl;
+        throw std::runtime_error("Item name table is full");
+    }
+
+    const auto id = static_cast<ItemNameId>(names.size());
+    names.push_back(name);
+    ids.emplace(name, id);
+    return id;
+}
+
+const std::string &ItemNames::Get(const ItemNameId id) {
+    if (id >= names.size()) {
+        std::cerr << "Unknown item name id: " << id << std::endl;
+        throw std::runtime_error("Unknown item name id");
+    }
+
+    return names[id];
+}
+
+size_t ItemNames::Count() {
+    return names.size();
+}
@@ -4,3 +4,7 @@
 Armor::Armor(const std::string &n, const double _bonus, const int _level)
     : Item(n, _bonus, _level, ItemType::ARMOR) {
 }
+
+Armor::Armor(const Item &item)
+    : Item(item) {
+}
@@ -4,3 +4,7 @@
 Spell::Spell(const std::string &n, const double _bonus, const int _level)
     : Item(n, _bonus, _level, ItemType::SPELL) {
 }
+
+Spell::Spell(const Item &item)
+    : Item(item) {
+}
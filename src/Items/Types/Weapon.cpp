@@ -4,3 +4,7 @@
 Weapon::Weapon(const std::string &n, const double _bonus, const int _level)
     : Item(n, _bonus, _level, ItemType::WEAPON) {
 }
+
+Weapon::Weapon(const Item &item)
+    : Item(item) {
+}
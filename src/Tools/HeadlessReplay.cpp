@@ -0,0 +1,804 @@
+// Headless driver for the game rules: plays recorded runs back and soaks auto-battle sessions without a window.
+//
+// Usage:
+//   DANDD_headless replay <file.replay> [repeat]
+//   DANDD_headless soak <runs> [weapon|spell|best] [seed] [easy|normal|hard]
+//   DANDD_headless roam <monsters> [size] [turns] [radius]
+//   DANDD_headless path [size] [queries]
+//   DANDD_headless fov [size] [radius] [steps]
+//   DANDD_headless sight <monsters> [size] [range]
+//   DANDD_headless schedule [actors] [actions]
+//   DANDD_headless loot [items] [level] [boss]
+//   DANDD_headless alias [entries] [draws]
+
+#include "C:/DandD/include/Core/FieldOfView.h"
+#include "C:/DandD/include/Core/LineOfSight.h"
+#include "C:/DandD/include/Core/MonsterMovement.h"
+#include "C:/DandD/include/Core/Pathfinder.h"
+#include "C:/DandD/include/Core/ReplayFile.h"
+#include "C:/DandD/include/Core/ReplayPlayer.h"
+#include "C:/DandD/include/Core/TurnScheduler.h"
+#include "C:/DandD/include/Items/ItemNames.h"
+#include "C:/DandD/include/Utils/AliasTable.h"
+#include "C:/DandD/include/Utils/ProbabilitySystem.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <queue>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+    void PrintUsage() {
+        std::cout << "Usage:\n"
+                << "  DANDD_headless replay <file.replay> [repeat]\n"
+                << "  DANDD_headless soak <runs> [weapon|spell|best] [seed] [easy|normal|hard]\n"
+                << "  DANDD_headless roam <monsters> [size] [turns] [radius]\n"
+                << "  DANDD_headless path [size] [queries]\n"
+                << "  DANDD_headless fov [size] [radius] [steps]\n"
+                << "  DANDD_headless sight <monsters> [size] [range]\n"
+                << "  DANDD_headless schedule [actors] [actions]\n"
+                << "  DANDD_headless loot [items] [level] [boss]\n"
+                << "  DANDD_headless alias [entries] [draws]\n";
+    }
+
+    BattlePolicy ParsePolicy(const std::string &name) {
+        if (name == "weapon") return BattlePolicy::WEAPON_ONLY;
+        if (name == "spell") return BattlePolicy::SPELL_ONLY;
+        return BattlePolicy::BEST_DAMAGE;
+    }
+
+    MonsterDifficulty ParseDifficulty(const std::string &name) {
+        if (name == "easy") return MonsterDifficulty::EASY;
+        if (name == "hard") return MonsterDifficulty::HARD;
+        return MonsterDifficulty::NORMAL;
+    }
+
+    const char *DifficultyName(const MonsterDifficulty difficulty) {
+        switch (difficulty) {
+            case MonsterDifficulty::EASY: return "easy";
+            case MonsterDifficulty::HARD: return "hard";
+            default: return "normal";
+        }
+    }
+
+    ReplayRecord MakeRecord(const uint32_t step, const ReplayInputType type, const uint8_t arg0 = 0,
+                            const uint8_t arg1 = 0, const uint8_t arg2 = 0) {
+        return {step, type, {arg0, arg1, arg2}, 0};
+    }
+
+    // Breadth-first search to the closest undefeated monster or treasure; returns the first step towards it
+    bool FindNextStep(const Map &map, const Position &from, MoveDirection &direction) {
+        const int width = static_cast<int>(map.getWidth());
+        const int height = static_cast<int>(map.getHeight());
+        if (width == 0 || height == 0) return false;
+
+        std::vector<uint8_t> isTarget(width * height, 0);
+        const MonsterStore &monsters = map.getMonstersConst();
+        for (size_t i = 0; i < monsters.Size(); i++) {
+            if (monsters.IsAlive(i)) {
+                isTarget[monsters.GetPosition(i).y * width + monsters.GetPosition(i).x] = 1;
+            }
+        }
+        for (const Treasure &treasure: map.getTreasuresConst()) {
+            isTarget[treasure.getPosition().y * width + treasure.getPosition().x] = 1;
+        }
+
+        const int start = from.y * width + from.x;
+        std::vector<int> previous(width * height, -1);
+        std::queue<int> frontier;
+        previous[start] = start;
+        frontier.push(start);
+
+        const int dx[4] = {1, -1, 0, 0};
+        const int dy[4] = {0, 0, -1, 1};
+
+        while (!frontier.empty()) {
+            const int current = frontier.front();
+            frontier.pop();
+
+            if (current != start && isTarget[current]) {
+                // Walk back to the cell next to the start
+                int step = current;
+                while (previous[step] != start) {
+                    step = previous[step];
+                }
+
+                const int stepX = step % width;
+                const int stepY = step / width;
+                if (stepX > from.x) direction = MoveDirection::RIGHT;
+                else if (stepX < from.x) direction = MoveDirection::LEFT;
+                else if (stepY < from.y) direction = MoveDirection::UP;
+                else direction = MoveDirection::DOWN;
+                return true;
+            }
+
+            for (int d = 0; d < 4; d++) {
+                const int nx = current % width + dx[d];
+                const int ny = current / width + dy[d];
+                if (map.isPassable(nx, ny) && previous[ny * width + nx] < 0) {
+                    previous[ny * width + nx] = current;
+                    frontier.push(ny * width + nx);
+                }
+            }
+        }
+
+        return false;
+    }
+
+    // Automated sessions with auto-resolved battles: seeks out monsters and treasure until defeat or a step cap
+    int RunSoak(const int runs, const BattlePolicy policy, const uint32_t baseSeed, const MonsterDifficulty difficulty) {
+        constexpr uint32_t MAX_STEPS_PER_RUN = 20000;
+
+        ReplayPlayer player;
+        player.SetCheckpointVerification(false);
+
+        long long totalBattles = 0;
+        long long totalItems = 0;
+        long long totalLevels = 0;
+        int defeats = 0;
+        int bestLevel = 0;
+
+        const auto start = std::chrono::steady_clock::now();
+
+        for (int run = 0; run < runs; run++) {
+            const uint32_t seed = baseSeed + static_cast<uint32_t>(run);
+            player.Begin(seed, static_cast<Race>(run % 3), difficulty);
+
+            for (uint32_t step = 0; step < MAX_STEPS_PER_RUN; step++) {
+                const ReplayPlayer::Phase phase = player.GetPhase();
+                if (phase == ReplayPlayer::Phase::DEFEAT) {
+                    defeats++;
+                    break;
+                }
+
+                ReplayRecord record{};
+                if (phase == ReplayPlayer::Phase::BATTLE) {
+                    record = MakeRecord(step, ReplayInputType::AUTO_BATTLE, static_cast<uint8_t>(policy));
+                } else if (phase == ReplayPlayer::Phase::LEVEL_UP) {
+                    record = MakeRecord(step, ReplayInputType::LEVEL_UP, 10, 10, 10);
+                } else if (phase == ReplayPlayer::Phase::EQUIPMENT) {
+                    // Take the new item only when it beats the equipped one
+                    const Item *item = player.GetPendingItem();
+                    const Inventory &inventory = player.GetHero().GetInventory();
+                    double currentBonus = 0.0;
+                    switch (item->GetType()) {
+                        case ItemType::WEAPON: currentBonus = inventory.GetWeapon().GetBonus();
+                            break;
+                        case ItemType::ARMOR: currentBonus = inventory.GetArmor().GetBonus();
+                            break;
+                        case ItemType::SPELL: currentBonus = inventory.GetSpell().GetBonus();
+                            break;
+                    }
+                    record = MakeRecord(step, ReplayInputType::EQUIPMENT, item->GetBonus() > currentBonus ? 1 : 0);
+                } else {
+                    MoveDirection direction;
+                    if (!FindNextStep(player.GetMap(), player.GetHero().getCurrentPosition(), direction)) {
+                        break;
+                    }
+                    record = MakeRecord(step, ReplayInputType::MOVE, static_cast<uint8_t>(direction));
+                }
+
+                if (!player.Step(record)) {
+                    const ReplayStats stats = player.GetStats();
+                    std::cerr << "Run " << run << " (seed " << seed << ") rejected input: "
+                            << stats.desyncReason << std::endl;
+                    return 2;
+                }
+            }
+
+            const ReplayStats stats = player.GetStats();
+            totalBattles += stats.battlesFought;
+            totalItems += stats.itemsFound;
+            totalLevels += stats.levelReached;
+            bestLevel = std::max(bestLevel, stats.levelReached);
+        }
+
+        const double elapsedMs = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start).count();
+
+        std::cout << "Runs:            " << runs << " (seeds " << baseSeed << ".." << baseSeed + runs - 1 << ", "
+                << DifficultyName(difficulty) << " monsters)\n"
+                << "Battles:         " << totalBattles << "\n"
+                << "Items found:     " << totalItems << "\n"
+                << "Defeats:         " << defeats << "\n"
+                << "Average level:   " << static_cast<double>(totalLevels) / runs << "\n"
+                << "Best level:      " << bestLevel << "\n"
+                << "Elapsed:         " << elapsedMs << " ms ("
+                << (elapsedMs > 0 ? totalBattles / (elapsedMs / 1000.0) : 0.0) << " battles/s)" << std::endl;
+
+        return 0;
+    }
+
+    // Loads generated rows through the regular map parser (Map only reads from files)
+    void LoadArena(const std::vector<std::string> &rows, Map &map) {
+        const std::string filePath = (std::filesystem::temp_directory_path() / "dandd_arena.txt").string();
+        {
+            std::ofstream file(filePath);
+            file << "[LEVEL_1]\nDATA:\n";
+            for (const std::string &row: rows) {
+                file << row << "\n";
+            }
+        }
+
+        map.loadFromFile(filePath, "[LEVEL_1]");
+        std::filesystem::remove(filePath);
+    }
+
+    // Times monster turns on an open size x size arena; the chase radius covers the whole arena
+    int RunRoam(const int monsterCount, const int size, const int turns, const int radius) {
+        // Walled square, hero in the middle, monsters on a regular pattern filling from the top
+        std::vector<std::string> rows;
+        int placed = 0;
+        for (int y = 0; y < size; y++) {
+            std::string row(size, '.');
+            for (int x = 0; x < size; x++) {
+                if (x == 0 || y == 0 || x == size - 1 || y == size - 1) {
+                    row[x] = '#';
+                } else if (x == size / 2 && y == size / 2) {
+                    row[x] = 'H';
+                } else if (placed < monsterCount && (x + y) % 2 == 0) {
+                    row[x] = 'M';
+                    placed++;
+                }
+            }
+            rows.push_back(row);
+        }
+
+        Map map;
+        LoadArena(rows, map);
+
+        MonsterMovement movement(radius);
+        Position hero = map.getStartPos();
+
+        // The full field build happens on level load, as in the game
+        auto start = std::chrono::steady_clock::now();
+        movement.SyncField(map, hero);
+        const double buildMicros = std::chrono::duration<double, std::micro>(
+            std::chrono::steady_clock::now() - start).count();
+
+        // First turn: every monster sees the hero and joins the schedule
+        start = std::chrono::steady_clock::now();
+        movement.Tick(map, hero);
+        const double firstMicros = std::chrono::duration<double, std::micro>(
+            std::chrono::steady_clock::now() - start).count();
+
+        double totalMicros = 0.0;
+        std::vector<double> turnMicros;
+        turnMicros.reserve(turns);
+        size_t totalMoves = 0;
+        size_t totalCellUpdates = 0;
+
+        for (int turn = 0; turn < turns; turn++) {
+            // Hero paces back and forth so the field keeps changing
+            hero.x += (turn / 4) % 2 == 0 ? 1 : -1;
+
+            start = std::chrono::steady_clock::now();
+            totalMoves += movement.Tick(map, hero);
+            const double micros = std::chrono::duration<double, std::micro>(
+                std::chrono::steady_clock::now() - start).count();
+
+            totalMicros += micros;
+            turnMicros.push_back(micros);
+            totalCellUpdates += movement.GetFlowField().GetLastUpdateCount();
+        }
+
+        // The worst case is what a frame has to absorb, so report the tail next to the average
+        std::sort(turnMicros.begin(), turnMicros.end());
+        const double worstMicros = turnMicros.back();
+        const double p99Micros = turnMicros[(turnMicros.size() - 1) * 99 / 100];
+        const size_t slowTurns = turnMicros.end() - std::upper_bound(turnMicros.begin(), turnMicros.end(), 1000.0);
+
+        std::cout << "Arena:           " << size << "x" << size << ", " << map.GetMonsterCount() << " monsters, "
+                << "chase radius " << radius << "\n"
+                << "Level load:      " << buildMicros << " us (full field build)\n"
+                << "First turn:      " << firstMicros << " us (every monster wakes up)\n"
+                << "Average turn:    " << totalMicros / turns << " us over " << turns << " turns\n"
+                << "99th percentile: " << p99Micros << " us\n"
+                << "Worst turn:      " << worstMicros << " us (" << slowTurns << " turns over 1 ms)\n"
+                << "Monster moves:   " << totalMoves << "\n"
+                << "Cells updated:   " << totalCellUpdates / turns << " per turn" << std::endl;
+
+        return 0;
+    }
+
+    // Walled square arenas for the path benchmark; 'H' marks the corner the queries start from
+    std::vector<std::string> MakePathArena(const std::string &kind, const int size, std::mt19937 &rng) {
+        std::vector<std::string> rows(size, std::string(size, '.'));
+
+        if (kind == "random") {
+            // A quarter of the cells are walls
+            for (std::string &row: rows) {
+                for (char &cell: row) {
+                    cell = rng() % 4 == 0 ? '#' : '.';
+                }
+            }
+        } else if (kind == "maze") {
+            // Perfect maze (recursive backtracker): one-cell corridors, exactly one route between two cells
+            for (std::string &row: rows) {
+                std::fill(row.begin(), row.end(), '#');
+            }
+
+            std::vector<Position> stack = {Position(1, 1)};
+            rows[1][1] = '.';
+            while (!stack.empty()) {
+                const Position cell = stack.back();
+                std::vector<Position> options;
+                const int dx[4] = {2, -2, 0, 0};
+                const int dy[4] = {0, 0, 2, -2};
+                for (int d = 0; d < 4; d++) {
+                    const int nx = cell.x + dx[d];
+                    const int ny = cell.y + dy[d];
+                    if (nx > 0 && ny > 0 && nx < size - 1 && ny < size - 1 && rows[ny][nx] == '#') {
+                        options.emplace_back(nx, ny);
+                    }
+                }
+
+                if (options.empty()) {
+                    stack.pop_back();
+                    continue;
+                }
+
+                const Position next = options[rng() % options.size()];
+                rows[(cell.y + next.y) / 2][(cell.x + next.x) / 2] = '.';
+                rows[next.y][next.x] = '.';
+                stack.push_back(next);
+            }
+        } else if (kind == "serpentine") {
+            // Full-width walls with the gap alternating sides: the longest possible detour
+            for (int y = 2; y < size - 1; y += 2) {
+                std::fill(rows[y].begin(), rows[y].end(), '#');
+                rows[y][(y / 2) % 2 == 0 ? size - 2 : 1] = '.';
+            }
+        }
+
+        for (int i = 0; i < size; i++) {
+            rows[0][i] = rows[size - 1][i] = '#';
+            rows[i][0] = rows[i][size - 1] = '#';
+        }
+        rows[1][1] = 'H';
+
+        return rows;
+    }
+
+    // Times click-to-move path queries on open, random, maze and serpentine arenas with the game's time budget
+    int RunPathBenchmark(const int size, const int queries) {
+        const char *kinds[] = {"open", "random", "maze", "serpentine"};
+
+        for (const char *kind: kinds) {
+            std::mt19937 rng(12345);
+            Map map;
+            LoadArena(MakePathArena(kind, size, rng), map);
+
+            Pathfinder pathfinder;
+            std::vector<Position> path;
+
+            // The first query also builds the column bitsets
+            auto start = std::chrono::steady_clock::now();
+            pathfinder.FindPath(map, map.getStartPos(), map.getStartPos(), path);
+            const double setupMs = std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - start).count();
+
+            double totalMicros = 0.0;
+            double worstMicros = 0.0;
+            int found = 0;
+            int budgetHits = 0;
+            size_t totalLength = 0;
+            int done = 0;
+
+            while (done < queries) {
+                const Position from(1 + static_cast<int>(rng() % (size - 2)), 1 + static_cast<int>(rng() % (size - 2)));
+                const Position to(1 + static_cast<int>(rng() % (size - 2)), 1 + static_cast<int>(rng() % (size - 2)));
+                if (!map.isPassable(from.x, from.y) || !map.isPassable(to.x, to.y)) continue;
+
+                start = std::chrono::steady_clock::now();
+                const bool ok = pathfinder.FindPath(map, from, to, path);
+                const double micros = std::chrono::duration<double, std::micro>(
+                    std::chrono::steady_clock::now() - start).count();
+
+                totalMicros += micros;
+                worstMicros = std::max(worstMicros, micros);
+                found += ok ? 1 : 0;
+                budgetHits += pathfinder.GetLastQueryStats().budgetExceeded ? 1 : 0;
+                totalLength += ok ? path.size() - 1 : 0;
+                done++;
+            }
+
+            std::cout << kind << " " << size << "x" << size << ": setup " << setupMs << " ms, "
+                    << "average " << totalMicros / queries << " us, worst " << worstMicros << " us, "
+                    << found << "/" << queries << " found (average length "
+                    << (found > 0 ? totalLength / found : 0) << "), " << budgetHits << " hit the budget"
+                    << std::endl;
+        }
+
+        return 0;
+    }
+
+    // Times field of view updates while the hero walks diagonally across open and random arenas
+    int RunFovBenchmark(const int size, const int radius, const int steps) {
+        const char *kinds[] = {"open", "random"};
+
+        for (const char *kind: kinds) {
+            std::mt19937 rng(12345);
+            Map map;
+            LoadArena(MakePathArena(kind, size, rng), map);
+
+            FieldOfView fov(radius);
+            fov.Compute(map, map.getStartPos()); // Sizes the bitsets
+
+            double totalMicros = 0.0;
+            double worstMicros = 0.0;
+            size_t totalVisible = 0;
+
+            for (int step = 0; step < steps; step++) {
+                const int offset = 1 + step % (size - 2);
+                const Position origin(offset, offset);
+
+                const auto start = std::chrono::steady_clock::now();
+                fov.Compute(map, origin);
+                const double micros = std::chrono::duration<double, std::micro>(
+                    std::chrono::steady_clock::now() - start).count();
+
+                totalMicros += micros;
+                worstMicros = std::max(worstMicros, micros);
+                totalVisible += fov.GetVisibleCount();
+            }
+
+            std::cout << kind << " " << size << "x" << size << ", radius " << radius << ": average "
+                    << totalMicros / steps << " us, worst " << worstMicros << " us, "
+                    << totalVisible / steps << " cells visible on average" << std::endl;
+        }
+
+        return 0;
+    }
+
+    // Times aggro checks for every monster over 100 turns of 10 frames each: uncached lines every frame,
+    // cached lines, and one symmetric shadowcast sweep per turn
+    int RunSightBenchmark(const int monsterCount, const int size, const int range) {
+        constexpr int TURNS = 100;
+        constexpr int FRAMES_PER_TURN = 10;
+
+        std::mt19937 rng(12345);
+        Map map;
+        LoadArena(MakePathArena("random", size, rng), map);
+
+        MonsterStore &monsters = map.getMonsters();
+        while (static_cast<int>(monsters.Size()) < monsterCount) {
+            const Position pos(1 + static_cast<int>(rng() % (size - 2)), 1 + static_cast<int>(rng() % (size - 2)));
+            if (map.isPassable(pos.x, pos.y)) {
+                monsters.Add(pos, 1, MonsterType::MONSTER);
+            }
+        }
+
+        struct Variant {
+            const char *name;
+            SightMode mode;
+            bool cacheAcrossFrames;
+        };
+        const Variant variants[] = {
+            {"bresenham, no cache", SightMode::BRESENHAM, false},
+            {"bresenham, cached", SightMode::BRESENHAM, true},
+            {"symmetric shadowcast", SightMode::SYMMETRIC_SHADOWCAST, true}
+        };
+
+        for (const Variant &variant: variants) {
+            LineOfSight sight(variant.mode);
+            std::vector<uint8_t> results;
+            size_t seen = 0;
+
+            const auto start = std::chrono::steady_clock::now();
+            for (int turn = 0; turn < TURNS; turn++) {
+                // The hero walks along the middle row
+                const Position hero(1 + turn % (size - 2), size / 2);
+
+                sight.BeginTurn();
+                for (int frame = 0; frame < FRAMES_PER_TURN; frame++) {
+                    if (!variant.cacheAcrossFrames) sight.BeginTurn();
+                    sight.CanSeeTarget(map, monsters, hero, range, results);
+                }
+
+                for (const uint8_t sees: results) seen += sees;
+            }
+            const double micros = std::chrono::duration<double, std::micro>(
+                std::chrono::steady_clock::now() - start).count();
+
+            const SightStats &stats = sight.GetStats();
+            std::cout << variant.name << ": " << micros / TURNS << " us per turn, "
+                    << stats.cellsTested / TURNS << " cells tested per turn, "
+                    << stats.cacheHits << " cache hits, " << stats.sweeps << " sweeps, "
+                    << seen << " monster sightings" << std::endl;
+        }
+
+        return 0;
+    }
+
+    // Runs actors with speeds 50..200 through the scheduler: throughput per tenth of the run, and whether
+    // every actor got a share of actions proportional to its speed
+    int RunScheduleBenchmark(const int actorCount, const int actions) {
+        std::mt19937 rng(12345);
+        TurnScheduler scheduler;
+        std::vector<int> speeds;
+        std::vector<int> actionCounts(actorCount, 0);
+
+        for (int i = 0; i < actorCount; i++) {
+            speeds.push_back(50 + static_cast<int>(rng() % 151));
+            scheduler.Add(i % 100 == 0 ? ActorKind::EFFECT : ActorKind::MONSTER, MonsterHandle::Invalid(),
+                          speeds.back());
+        }
+
+        const int chunk = std::max(1, actions / 10);
+        double worstNanos = 0.0;
+        double bestNanos = 1e18;
+        auto chunkStart = std::chrono::steady_clock::now();
+
+        for (int action = 1; action <= actions; action++) {
+            const ActorId actor = scheduler.Next();
+            actionCounts[actor.slot]++;
+            scheduler.Spend(actor);
+
+            if (action % chunk == 0) {
+                const auto now = std::chrono::steady_clock::now();
+                const double nanos = std::chrono::duration<double, std::nano>(now - chunkStart).count() / chunk;
+                worstNanos = std::max(worstNanos, nanos);
+                bestNanos = std::min(bestNanos, nanos);
+                chunkStart = now;
+            }
+        }
+
+        // Actions per actor should match speed * elapsed time / (cost * NORMAL_SPEED), within one action
+        int worstDeviation = 0;
+        const double elapsed = static_cast<double>(scheduler.GetTime());
+        for (int i = 0; i < actorCount; i++) {
+            const double expected = speeds[i] * elapsed /
+                                    (TurnScheduler::ACTION_COST * TurnScheduler::NORMAL_SPEED);
+            worstDeviation = std::max(worstDeviation,
+                                      static_cast<int>(std::abs(actionCounts[i] - expected) + 0.5));
+        }
+
+        std::cout << actorCount << " actors, " << actions << " actions: " << bestNanos << " to " << worstNanos
+                << " ns per action across tenths of the run, world time " << scheduler.GetTime()
+                << ", worst deviation from the fair share " << worstDeviation << " action(s)" << std::endl;
+
+        return 0;
+    }
+
+    // Pearson's chi-square of observed counts against expected chances, with the statistic a correct sampler
+    // stays under 99.9% of the time (Wilson-Hilferty approximation). Cells nobody can draw are skipped.
+    bool ChiSquareTest(const std::vector<size_t> &observed, const std::vector<double> &chances, const size_t draws,
+                       double &statistic, double &critical) {
+        statistic = 0.0;
+        int cells = 0;
+        for (size_t i = 0; i < observed.size(); i++) {
+            if (chances[i] <= 0.0) {
+                if (observed[i] > 0) return false; // Drawn although impossible
+                continue;
+            }
+
+            const double expected = chances[i] * static_cast<double>(draws);
+            const double diff = static_cast<double>(observed[i]) - expected;
+            statistic += diff * diff / expected;
+            cells++;
+        }
+
+        const double df = std::max(1, cells - 1);
+        const double z = 3.090; // Upper 0.1% of the standard normal
+        const double term = 1.0 - 2.0 / (9.0 * df) + z * std::sqrt(2.0 / (9.0 * df));
+        critical = df * term * term * term;
+        return statistic <= critical;
+    }
+
+    // Rolls loot in bulk: table load time, items per second, and the type/rarity spread against the table
+    int RunLootBenchmark(const int itemCount, const int level, const bool boss) {
+        RandomUtils::seed(12345);
+
+        auto start = std::chrono::steady_clock::now();
+        ItemGenerator::preloadTables();
+        const double loadMs = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start).count();
+
+        const size_t rarities = ItemGenerator::rarityCount();
+        std::vector<size_t> counts(3 * rarities, 0);
+        double bonusSum = 0.0;
+
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < itemCount; i++) {
+            const Item item = boss ? ItemGenerator::generateBossDrop(level) : ItemGenerator::generateRandomItem(level);
+            counts[static_cast<int>(item.GetType()) * rarities + item.GetRarity()]++;
+            bonusSum += item.GetBonus();
+        }
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << "Tables:       " << ItemNames::Count() << " names, " << rarities << " rarities loaded in "
+                << loadMs << " ms\n"
+                << "Items:        " << itemCount << (boss ? " boss drops" : " drops") << " at level " << level
+                << " in " << seconds * 1000.0 << " ms (" << itemCount / seconds / 1e6 << " million/s)\n"
+                << "Average bonus: " << bonusSum / itemCount << "\n";
+
+        std::vector<double> chances(counts.size());
+        const char *typeNames[3] = {"WEAPON", "ARMOR", "SPELL"};
+        for (int type = 0; type < 3; type++) {
+            std::cout << "  " << typeNames[type] << ":";
+            for (size_t rarity = 0; rarity < rarities; rarity++) {
+                const size_t cell = type * rarities + rarity;
+                chances[cell] = ItemGenerator::dropChance(static_cast<ItemType>(type),
+                                                          static_cast<ItemRarity>(rarity), level, boss);
+                std::cout << " " << ItemGenerator::rarityName(static_cast<ItemRarity>(rarity)) << " "
+                        << 100.0 * counts[cell] / itemCount << "% (table " << 100.0 * chances[cell] << "%)";
+            }
+            std::cout << "\n";
+        }
+
+        double statistic = 0.0;
+        double critical = 0.0;
+        const bool passed = ChiSquareTest(counts, chances, itemCount, statistic, critical);
+        std::cout << "Chi-square:   " << statistic << " (limit " << critical << ") "
+                << (passed ? "PASS" : "FAIL") << std::endl;
+
+        return passed ? 0 : 1;
+    }
+
+    // Weighted draws from one large table: alias table against std::discrete_distribution (a binary search),
+    // and the alias table's spread against the weights
+    int RunAliasBenchmark(const int entryCount, const int draws) {
+        std::mt19937 rng(12345);
+        std::exponential_distribution<double> weightDist(1.0);
+        std::vector<double> weights(entryCount);
+        for (double &weight: weights) {
+            weight = weightDist(rng);
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        const AliasTable table(weights);
+        const double buildMs = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start).count();
+
+        std::vector<size_t> counts(entryCount, 0);
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < draws; i++) {
+            counts[table.Sample(rng)]++;
+        }
+        const double aliasSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::discrete_distribution<size_t> discrete(weights.begin(), weights.end());
+        size_t checksum = 0;
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < draws; i++) {
+            checksum += discrete(rng);
+        }
+        const double discreteSeconds = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
+
+        std::vector<double> chances(entryCount);
+        for (int i = 0; i < entryCount; i++) {
+            chances[i] = table.Probability(i);
+        }
+        double statistic = 0.0;
+        double critical = 0.0;
+        const bool passed = ChiSquareTest(counts, chances, draws, statistic, critical);
+
+        std::cout << "Entries:      " << entryCount << " (built in " << buildMs << " ms)\n"
+                << "Alias:        " << draws / aliasSeconds / 1e6 << " million draws/s\n"
+                << "Discrete:     " << draws / discreteSeconds / 1e6 << " million draws/s (checksum "
+                << checksum % 1000 << ")\n"
+                << "Chi-square:   " << statistic << " (limit " << critical << ") "
+                << (passed ? "PASS" : "FAIL") << std::endl;
+
+        return passed ? 0 : 1;
+    }
+
+    // Plays a replay 'repeat' times, checks every run ends in the same state and reports timing
+    int RunReplay(const std::string &filePath, const int repeat) {
+        const ReplayFile replay = ReplayFile::Load(filePath);
+        ReplayPlayer player;
+
+        ReplayStats first{};
+        double totalMs = 0.0;
+
+        for (int run = 0; run < repeat; run++) {
+            const auto start = std::chrono::steady_clock::now();
+            const ReplayStats stats = player.Play(replay);
+            const auto end = std::chrono::steady_clock::now();
+            totalMs += std::chrono::duration<double, std::milli>(end - start).count();
+
+            if (stats.desynced) {
+                std::cerr << "Desync at frame " << stats.desyncFrame << " (record " << stats.recordsApplied
+                        << "): " << stats.desyncReason << std::endl;
+                return 2;
+            }
+
+            if (run == 0) {
+                first = stats;
+            } else if (stats.finalChecksum != first.finalChecksum) {
+                std::cerr << "Run " << run << " ended in a different state than run 0" << std::endl;
+                return 3;
+            }
+        }
+
+        std::cout << "Seed:            " << replay.GetSeed() << " (" << DifficultyName(replay.GetDifficulty())
+                << " monsters)\n"
+                << "Records:         " << first.recordsApplied << "\n"
+                << "Battles fought:  " << first.battlesFought << "\n"
+                << "Items found:     " << first.itemsFound << "\n"
+                << "Level reached:   " << first.levelReached << "\n"
+                << "Hero level:      " << first.heroLevel << "\n"
+                << "Final checksum:  " << std::hex << first.finalChecksum << std::dec << "\n"
+                << "Average time:    " << totalMs / repeat << " ms over " << repeat << " run(s)" << std::endl;
+
+        return 0;
+    }
+}
+
+int main(const int argc, char **argv) {
+    if (argc < 2) {
+        PrintUsage();
+        return 1;
+    }
+
+    const std::string command = argv[1];
+
+    try {
+        if (command == "replay" && argc >= 3) {
+            const int repeat = argc >= 4 ? std::max(1, std::atoi(argv[3])) : 1;
+            return RunReplay(argv[2], repeat);
+        }
+        if (command == "soak" && argc >= 3) {
+            const int runs = std::max(1, std::atoi(argv[2]));
+            const BattlePolicy policy = ParsePolicy(argc >= 4 ? argv[3] : "best");
+            const uint32_t seed = argc >= 5 ? static_cast<uint32_t>(std::strtoul(argv[4], nullptr, 10)) : 1;
+            const MonsterDifficulty difficulty = ParseDifficulty(argc >= 6 ? argv[5] : "normal");
+            return RunSoak(runs, policy, seed, difficulty);
+        }
+        if (command == "roam" && argc >= 3) {
+            const int monsters = std::max(1, std::atoi(argv[2]));
+            const int size = argc >= 4 ? std::max(8, std::atoi(argv[3])) : 150;
+            const int turns = argc >= 5 ? std::max(1, std::atoi(argv[4])) : 200;
+            // Default chase radius covers the whole arena; the game's is MonsterMovement::DEFAULT_CHASE_RADIUS
+            const int radius = argc >= 6 ? std::max(1, std::atoi(argv[5])) : size * 2;
+            return RunRoam(monsters, size, turns, radius);
+        }
+        if (command == "path") {
+            const int size = argc >= 3 ? std::max(8, std::atoi(argv[2])) : 2048;
+            const int queries = argc >= 4 ? std::max(1, std::atoi(argv[3])) : 200;
+            return RunPathBenchmark(size, queries);
+        }
+        if (command == "fov") {
+            const int size = argc >= 3 ? std::max(8, std::atoi(argv[2])) : 2048;
+            const int radius = argc >= 4 ? std::max(1, std::atoi(argv[3])) : FieldOfView::DEFAULT_RADIUS;
+            const int steps = argc >= 5 ? std::max(1, std::atoi(argv[4])) : 1000;
+            return RunFovBenchmark(size, radius, steps);
+        }
+        if (command == "sight" && argc >= 3) {
+            const int monsters = std::max(1, std::atoi(argv[2]));
+            const int size = argc >= 4 ? std::max(8, std::atoi(argv[3])) : 256;
+            const int range = argc >= 5 ? std::max(1, std::atoi(argv[4])) : 16;
+            return RunSightBenchmark(monsters, size, range);
+        }
+        if (command == "schedule") {
+            const int actors = argc >= 3 ? std::max(1, std::atoi(argv[2])) : 100000;
+            const int actions = argc >= 4 ? std::max(1, std::atoi(argv[3])) : 10000000;
+            return RunScheduleBenchmark(actors, actions);
+        }
+        if (command == "loot") {
+            const int items = argc >= 3 ? std::max(1, std::atoi(argv[2])) : 10000000;
+            const int level = argc >= 4 ? std::max(1, std::atoi(argv[3])) : 3;
+            const bool boss = argc >= 5 && std::string(argv[4]) == "boss";
+            return RunLootBenchmark(items, level, boss);
+        }
+        if (command == "alias") {
+            const int entries = argc >= 3 ? std::max(1, std::atoi(argv[2])) : 100000;
+            const int draws = argc >= 4 ? std::max(1, std::atoi(argv[3])) : 10000000;
+            return RunAliasBenchmark(entries, draws);
+        }
+    } catch (const std::exception &e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    PrintUsage();
+    return 1;
+}
@@ -0,0 +1,162 @@
+#include "C:/DandD/include/UI/managers/ResourceManager.h"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <system_error>
+
+std::string ResourceManager::Resolve(const std::string &path, const char *defaultExtension) {
+    std::string slashed = path;
+    std::replace(slashed.begin(), slashed.end(), '\\', '/');
+
+    std::filesystem::path file(slashed);
+    std::error_code error;
+    if (!file.has_extension() && defaultExtension[0] != '\0' && !std::filesystem::exists(file, error)) {
+        file += defaultExtension;
+    }
+
+    // Falls back to a purely textual clean-up when the file system can't answer
+    std::filesystem::path canonical = std::filesystem::weakly_canonical(file, error);
+    if (error) {
+        canonical = file.lexically_normal();
+    }
+    return canonical.generic_string();
+}
+
+const Texture2D &ResourceManager::AcquireTexture(const std::string &path) {
+    const std::string resolved = Resolve(path, ".png");
+
+    const auto found = textures.find(resolved);
+    if (found != textures.end()) {
+        found->second.references++;
+        return found->second.texture;
+    }
+
+    // Only the decode happens off the main thread; the upload waits for UploadDecoded
+    TextureEntry &entry = textures[resolved];
+    entry.texture = Texture2D{};
+    entry.decoded = DecodeAsync([resolved] { return LoadImage(resolved.c_str()); });
+    entry.failed = false;
+    entry.references = 1;
+
+    texturePaths[&entry.texture] = resolved;
+    return entry.texture;
+}
+
+void ResourceManager::ReleaseTexture(const Texture2D &texture) {
+    const auto path = texturePaths.find(&texture);
+    if (path == texturePaths.end()) return;
+
+    const auto entry = textures.find(path->second);
+    if (--entry->second.references > 0) return;
+
+    // Still being decoded: wait for the worker so its image can be freed
+    if (entry->second.decoded.valid()) {
+        UnloadImage(entry->second.decoded.get());
+    }
+    if (entry->second.texture.id != 0) {
+        UnloadTexture(entry->second.texture);
+    }
+    texturePaths.erase(path);
+    textures.erase(entry);
+}
+
+bool ResourceManager::HasFailed(const Texture2D &texture) {
+    const auto path = texturePaths.find(&texture);
+    return path != texturePaths.end() && textures.at(path->second).failed;
+}
+
+void ResourceManager::UploadDecoded(const int maxUploads) {
+    int uploads = 0;
+    for (auto &[path, entry]: textures) {
+        if (uploads >= maxUploads) break;
+        if (!entry.decoded.valid()) continue;
+        if (entry.decoded.wait_for(std::chrono::seconds(0)) != std::future_status::ready) continue;
+
+        Image image = entry.decoded.get();
+        if (!image.data) {
+            std::cerr << "Could not load texture: " << path << std::endl;
+            entry.failed = true;
+            continue;
+        }
+
+        entry.texture = LoadTextureFromImage(image);
+        UnloadImage(image);
+        uploads++;
+    }
+}
+
+bool ResourceManager::HasPendingUploads() {
+    for (const auto &[path, entry]: textures) {
+        if (entry.decoded.valid()) return true;
+    }
+    return false;
+}
+
+std::future<Image> ResourceManager::DecodeAsync(std::function<Image()> decode) {
+    return GetPool().Submit(std::move(decode));
+}
+
+WorkerPool &ResourceManager::GetPool() {
+    // Started on first use, so nothing is spawned until there is something to decode
+    if (!decodePool) {
+        decodePool = new WorkerPool();
+    }
+    return *decodePool;
+}
+
+Font ResourceManager::AcquireFont(const std::string &path) {
+    const std::string resolved = Resolve(path, ".ttf");
+
+    const auto found = fonts.find(resolved);
+    if (found != fonts.end()) {
+        found->second.references++;
+        return found->second.font;
+    }
+
+    // raylib hands back its default font on failure; that one is never ours to unload
+    const Font font = LoadFont(resolved.c_str());
+    if (font.texture.id == 0 || font.texture.id == GetFontDefault().texture.id) {
+        std::cerr << "Could not load font: " << resolved << std::endl;
+        return GetFontDefault();
+    }
+
+    fonts[resolved] = {font, 1};
+    fontPaths[font.texture.id] = resolved;
+    return font;
+}
+
+void ResourceManager::ReleaseFont(const Font &font) {
+    const auto path = fontPaths.find(font.texture.id);
+    if (path == fontPaths.end()) return;
+
+    const auto entry = fonts.find(path->second);
+    if (--entry->second.references > 0) return;
+
+    UnloadFont(entry->second.font);
+    fonts.erase(entry);
+    fontPaths.erase(path);
+}
+
+void ResourceManager::Clear() {
+    for (auto &[path, entry]: textures) {
+        if (entry.decoded.valid()) {
+            UnloadImage(entry.decoded.get());
+        }
+        if (entry.texture.id != 0) {
+            UnloadTexture(entry.texture);
+        }
+    }
+    for (const auto &[path, entry]: fonts) {
+        UnloadFont(entry.font);
+    }
+
+    textures.clear();
+    texturePaths.clear();
+    fonts.clear();
+    fontPaths.clear();
+
+    // Jobs still queued by other owners finish before the workers stop
+    delete decodePool;
+    decodePool = nullptr;
+}
@@ -3,6 +3,9 @@
 //
 
 #include "C:/DandD/include/UI/managers/UIManager.h"
+#include "C:/DandD/include/UI/managers/ResourceManager.h"
+#include "C:/DandD/include/UI/renderers/TextCache.h"
+#include "C:/DandD/include/Utils/ProbabilitySystem.h"
 #include <algorithm>
 #include <cmath>
 #include <map>
@@ -14,9 +17,9 @@ UIManager::UIManager(const int _screenWidth, const int _screenHeight)
       currentState(UIState::MAIN_MENU), previousState(UIState::MAIN_MENU),
       mainMenu(nullptr), gameHUD(nullptr), characterSelectionPanel(nullptr), battlePanel(nullptr),
       levelUpPanel(nullptr), equipmentPanel(nullptr),
-      mapRenderer(nullptr), hero(nullptr),
-      currentMap(nullptr), attackSystem(nullptr), currentBattleMonster(nullptr), battleSystem(nullptr),
-      defeatPanel(nullptr), selectedRace(Race::Human),
+      mapRenderer(nullptr), spriteAtlas(nullptr), hero(nullptr),
+      currentMap(nullptr), attackSystem(nullptr), currentBattleMonster(MonsterHandle::Invalid()), battleSystem(nullptr),
+      defeatPanel(nullptr), replayRecorder(nullptr), selectedRace(Race::Human),
       currentLevel(1), levelComplete(false), portalCreated(false),
       mapFilePath("C:/DandD/assets/maps/maps.txt"),
       transitionTimer(0.0f), isTransitioning(false) {
@@ -46,6 +49,7 @@ void UIManager::Initialize() {
         });
     }
     if (!mapRenderer) mapRenderer = new MapRenderer(screenWidth, screenHeight);
+    if (!spriteAtlas) spriteAtlas = new TextureAtlas();
     if (!battleSystem) battleSystem = new BattleSystem();
     if (!characterSelectionPanel) characterSelectionPanel = new CharacterSelectionPanel(screenWidth, screenHeight);
 
@@ -88,6 +92,13 @@ void UIManager::Initialize() {
 
 // Loads resources required by various UI components.
 void UIManager::LoadResources() const {
+    // Map and HUD sprites are packed into one atlas, so both can draw without switching textures.
+    // Their files decode on the worker pool; the atlas is built once they are in, or when gameplay starts.
+    if (spriteAtlas) {
+        if (mapRenderer) mapRenderer->RegisterSprites(*spriteAtlas);
+        if (gameHUD) gameHUD->RegisterSprites(*spriteAtlas);
+    }
+
     if (mainMenu) mainMenu->LoadResources();
     if (gameHUD) gameHUD->LoadResources();
     if (mapRenderer) mapRenderer->LoadResources();
@@ -110,6 +121,11 @@ void UIManager::Unload() {
         delete mapRenderer;
         mapRenderer = nullptr;
     }
+    if (spriteAtlas) {
+        spriteAtlas->Unload(); // After everything drawing from it is gone.
+        delete spriteAtlas;
+        spriteAtlas = nullptr;
+    }
 
     delete characterSelectionPanel;
     characterSelectionPanel = nullptr;
@@ -128,10 +144,33 @@ void UIManager::Unload() {
 
     delete defeatPanel;
     defeatPanel = nullptr;
+
+    TextCache::Clear(); // The fonts are gone; their texture ids may come back for other fonts.
+    ResourceManager::Clear(); // Anything a component failed to release.
+}
+
+// Moves finished background decodes onto the GPU, a few per frame, so the menu is up before they are all in.
+void UIManager::UploadLoadedResources() const {
+    ResourceManager::UploadDecoded();
+
+    if (spriteAtlas && !spriteAtlas->IsBuilt() && spriteAtlas->IsDecoded()) {
+        BuildSpriteAtlas();
+    }
+}
+
+// Packs the atlas, waiting for any sprite still decoding, and hands the icons to the HUD.
+void UIManager::BuildSpriteAtlas() const {
+    if (!spriteAtlas || spriteAtlas->IsBuilt()) return;
+
+    spriteAtlas->Build();
+    spriteAtlas->UseForShapes(); // Rectangles and lines batch with the sprites too.
+    if (gameHUD) gameHUD->ApplyButtonSprites(); // The icons have their rectangles now.
 }
 
 // Updates the current UI state based on the game's progression.
 void UIManager::Update(const float deltaTime) {
+    UploadLoadedResources();
+
     switch (currentState) {
         case UIState::MAIN_MENU:
             UpdateMainMenu(deltaTime);
@@ -277,41 +316,10 @@ void UIManager::GenerateNewLevel() {
 void UIManager::CheckLevelCompletion() {
     if (levelComplete || portalCreated || !currentMap) return; // Don't re-check if already complete or portal exists
 
-    const auto monsters = currentMap->getMonstersConst(); // Get current monsters on the map
-
-    if (monsters.empty()) {
-        levelComplete = true; // If no monsters, level is complete
-        CreatePortal(); // Create portal for next level
-        return;
-    }
-
-    int aliveNormalMonsters = 0;
-    int aliveBosses = 0;
-    int totalNormalMonsters = 0;
-    int totalBosses = 0;
-
-    // Count alive and total monsters/bosses.
-    for (const auto &monster: monsters) {
-        if (monster.GetType() == MonsterType::BOSS) {
-            totalBosses++;
-            if (!monster.isDefeated()) {
-                aliveBosses++;
-            }
-        } else {
-            totalNormalMonsters++;
-            if (!monster.isDefeated()) {
-                aliveNormalMonsters++;
-            }
-        }
-    }
-
-    const bool normalMonstersCleared = (totalNormalMonsters > 0 && aliveNormalMonsters == 0);
-    const bool bossesCleared = (totalBosses > 0 && aliveBosses == 0);
-
     // Level is complete if all normal monsters or all bosses are cleared.
-    if (normalMonstersCleared || bossesCleared) {
+    if (currentMap->IsLevelCleared()) {
         levelComplete = true;
-        CreatePortal();
+        CreatePortal(); // Create portal for next level
     }
 }
 
@@ -405,13 +413,26 @@ void UIManager::OnCharacterSelectionBack() {
 }
 
 // Initiates a battle between the hero and a monster.
-void UIManager::StartBattle(Hero *heroRef, Monster *monster) {
-    if (!battlePanel || !heroRef || !monster || !battleSystem) return;
+void UIManager::StartBattle(Hero *heroRef, const MonsterHandle monster) {
+    if (!battlePanel || !heroRef || !battleSystem || !currentMap || !currentMap->getMonstersConst().IsValid(monster)) return;
 
     currentBattleMonster = monster; // Store reference to current monster
 
     battleSystem->StartBattle(heroRef, monster); // Start battle logic
-    battlePanel->StartBattle(heroRef, monster, battleSystem); // Initialize battle panel
+
+    // Auto mode settles the whole encounter this frame and never shows the battle panel
+    if (mainMenu && mainMenu->IsAutoBattleEnabled()) {
+        const BattlePolicy policy = mainMenu->GetAutoBattlePolicy();
+        if (replayRecorder) {
+            replayRecorder->RecordAutoBattle(policy); // One record for the whole fight, not one per attack
+        }
+        battleSystem->ResolveBattle(policy);
+        currentBattleMonster = MonsterHandle::Invalid();
+        ShowBossDrop();
+        return;
+    }
+
+    battlePanel->StartBattle(heroRef, battleSystem->GetCurrentMonster(), battleSystem); // Initialize battle panel
 
     SetState(UIState::BATTLE); // Transition to battle state
 }
@@ -423,8 +444,9 @@ void UIManager::EndBattle() {
         OnBattleEnd(result); // Handle battle end result
     }
 
-    currentBattleMonster = nullptr; // Clear current monster reference
+    currentBattleMonster = MonsterHandle::Invalid(); // Clear current monster reference
     SetState(UIState::GAMEPLAY); // Return to gameplay
+    ShowBossDrop();
 }
 
 // Checks if a battle is currently active.
@@ -434,7 +456,19 @@ bool UIManager::IsBattleActive() const {
 
 // Returns the result of the battle.
 BattleResult UIManager::GetBattleResult() const {
-    return battlePanel ? battlePanel->GetResult() : BattleResult::ONGOING;
+    return battleSystem ? battleSystem->GetLastResult() : BattleResult::ONGOING;
+}
+
+// Returns the monster difficulty selected in the options menu.
+MonsterDifficulty UIManager::GetMonsterDifficulty() const {
+    return mainMenu ? mainMenu->GetMonsterDifficulty() : MonsterDifficulty::NORMAL;
+}
+
+// Sets how deep monsters search their attacks for the rest of the run.
+void UIManager::SetMonsterDifficulty(const MonsterDifficulty difficulty) {
+    if (battleSystem) {
+        battleSystem->GetMonsterAI()->SetDifficulty(difficulty);
+    }
 }
 
 // Shows the equipment choice panel for a new item.
@@ -536,6 +570,19 @@ void UIManager::SetAttackSystem(Attack *attack) {
     attackSystem = attack;
 }
 
+// Sets the replay recorder and subscribes it to the battle event stream.
+void UIManager::SetReplayRecorder(ReplayRecorder *recorder) {
+    replayRecorder = recorder;
+
+    if (battleSystem) {
+        battleSystem->SetEventListener([this](const BattleEvent &event) {
+            if (replayRecorder && hero) {
+                replayRecorder->RecordBattleEvent(event, *hero);
+            }
+        });
+    }
+}
+
 // Updates the stats displayed in the GameHUD.
 void UIManager::UpdateHUDStats() {
     if (!gameHUD || !currentMap) return;
@@ -552,6 +599,18 @@ void UIManager::UpdateMapRenderer() {
     }
 }
 
+// Hands the hero's field of view to the map renderer for fog of war.
+void UIManager::SetFieldOfView(const FieldOfView *fov) {
+    if (mapRenderer) {
+        mapRenderer->SetFieldOfView(fov);
+    }
+}
+
+// Forwards screen-to-map picking to the map renderer.
+bool UIManager::ScreenToMapCell(const Vector2 screenPos, Position &cell) const {
+    return mapRenderer && mapRenderer->ScreenToWorld(screenPos, cell);
+}
+
 // Updates the main menu logic.
 void UIManager::UpdateMainMenu(const float deltaTime) {
     if (mainMenu) {
@@ -566,12 +625,68 @@ void UIManager::UpdateGameplay(const float deltaTime) {
         gameHUD->Update(deltaTime);
     }
     if (mapRenderer) {
-        mapRenderer->Update(deltaTime);
+        if (IsKeyPressed(KEY_M)) {
+            mapRenderer->ToggleMinimapOverview(); // Whole level or the hero's surroundings
+        }
+
+        const float wheel = GetMouseWheelMove();
+        if (wheel != 0.0f) {
+            mapRenderer->Zoom(wheel); // From close-up to the whole level
+        }
     }
 
     HandlePortalInteraction(); // Check if hero is on a portal
 }
 
+// Steps the map camera at the simulation rate; it only follows the hero during gameplay.
+void UIManager::FixedUpdate(const float tickTime) {
+    if (currentState == UIState::GAMEPLAY && mapRenderer) {
+        mapRenderer->Update(tickTime);
+    }
+}
+
+// Passes the frame's position between simulation steps on to the map renderer.
+void UIManager::SetRenderInterpolation(const float alpha) const {
+    if (mapRenderer) {
+        mapRenderer->Interpolate(alpha);
+    }
+}
+
+// Tells the game loop how much of the screen is animating on its own, so idle frames can be skipped.
+RedrawNeed UIManager::GetRedrawNeed() const {
+    // Textures still arriving replace their placeholders as they land
+    if (ResourceManager::HasPendingUploads() || (spriteAtlas && !spriteAtlas->IsBuilt())) {
+        return RedrawNeed::EVERY_FRAME;
+    }
+
+    switch (currentState) {
+        case UIState::BATTLE:
+        case UIState::LEVEL_TRANSITION:
+            return RedrawNeed::EVERY_FRAME; // Timed animations throughout
+
+        case UIState::GAMEPLAY:
+        case UIState::LEVEL_UP:
+        case UIState::EQUIPMENT_SELECTION:
+            // The map and HUD are drawn under every panel
+            if ((mapRenderer && mapRenderer->IsCameraMoving()) || (gameHUD && gameHUD->IsTransitioning())) {
+                return RedrawNeed::EVERY_FRAME;
+            }
+            return RedrawNeed::AMBIENT;
+
+        case UIState::MAIN_MENU:
+        case UIState::CHARACTER_SELECTION:
+        case UIState::DEFEAT:
+            break;
+    }
+
+    return RedrawNeed::NONE;
+}
+
+// Map tile layer draw calls of the last frame, for the stats overlay.
+int UIManager::GetMapTileDrawCalls() const {
+    return mapRenderer ? mapRenderer->GetTileDrawCalls() : 0;
+}
+
 // Updates the battle panel logic.
 void UIManager::UpdateBattle(const float deltaTime) {
     if (battlePanel) {
@@ -728,6 +843,8 @@ void UIManager::HandlePortalInteraction() {
 
 // Initializes gameplay elements after a new game or load game.
 void UIManager::InitializeGameplay() {
+    BuildSpriteAtlas(); // The map and HUD draw from it from here on.
+
     if (gameHUD && hero) {
         gameHUD->Initialize(hero); // Initialize HUD with hero stats
     }
@@ -757,7 +874,7 @@ void UIManager::CleanupGameplay() {
     portals.clear(); // Clear all portals
     portalCreated = false; // Reset portal creation flag
     levelComplete = false; // Reset level completion flag
-    currentBattleMonster = nullptr; // Clear current battle monster
+    currentBattleMonster = MonsterHandle::Invalid(); // Clear current battle monster
 }
 
 // Resets level-specific flags and timers.
@@ -773,30 +890,14 @@ void UIManager::ResetLevelState() {
 bool UIManager::AreAllMonstersDefeated() const {
     if (!currentMap) return false;
 
-    const auto &monsters = currentMap->getMonstersConst();
-
-    for (const Monster &monster: monsters) {
-        if (monster.GetType() == MonsterType::MONSTER && !monster.isDefeated()) {
-            return false; // Found an alive normal monster
-        }
-    }
-
-    return true; // All normal monsters are defeated
+    return currentMap->getMonstersConst().CountAlive(MonsterType::MONSTER) == 0;
 }
 
 // Checks if all bosses on the current map are defeated.
 bool UIManager::AreAllBossesDefeated() const {
     if (!currentMap) return false;
 
-    const auto &monsters = currentMap->getMonsters();
-
-    for (const Monster &monster: monsters) {
-        if (monster.GetType() == MonsterType::BOSS && !monster.isDefeated()) {
-            return false; // Found an alive boss
-        }
-    }
-
-    return true; // All bosses are defeated
+    return currentMap->getMonstersConst().CountAlive(MonsterType::BOSS) == 0;
 }
 
 // Checks if a given position on the map is a wall.
@@ -807,6 +908,10 @@ bool UIManager::IsPositionWall(const Position &pos) const {
 
 // Callback when level up stats are confirmed.
 void UIManager::OnLevelUpConfirm(const int str, const int mana, const float health) {
+    if (replayRecorder) {
+        replayRecorder->RecordLevelUp(str, mana, static_cast<int>(health));
+    }
+
     if (hero) {
         hero->levelUp(str, mana, health); // Apply stat increases to hero
     }
@@ -830,35 +935,15 @@ void UIManager::OnEquipmentKeep() {
 void UIManager::OnEquipmentEquip() {
     if (!hero || !equipmentPanel || !pendingItem) return;
 
+    if (replayRecorder) {
+        replayRecorder->RecordEquipment(true);
+    }
+
     // Get non-const reference to inventory for modifications
     Inventory &inventory = hero->GetInventory(); // This needs to be non-const
 
-    // Actually equip the item to the hero's inventory using the correct methods
-    switch (pendingItem->GetType()) {
-        case ItemType::ARMOR: {
-            const Armor *newArmor = dynamic_cast<const Armor *>(pendingItem.get());
-            if (newArmor) {
-                inventory.newArmor(*newArmor);
-            }
-            break;
-        }
-        case ItemType::WEAPON: {
-            const Weapon *newWeapon = dynamic_cast<const Weapon *>(pendingItem.get());
-            if (newWeapon) {
-                inventory.newWeapon(*newWeapon);
-            }
-            break;
-        }
-        case ItemType::SPELL: {
-            const Spell *newSpell = dynamic_cast<const Spell *>(pendingItem.get());
-            if (newSpell) {
-                inventory.newSpell(*newSpell);
-            }
-            break;
-        }
-        default:
-            break;
-    }
+    // Actually equip the item to the hero's inventory slot matching its type
+    inventory.equip(*pendingItem);
 
     // Now update the GameHUD with the new item references
     if (gameHUD) {
@@ -884,14 +969,22 @@ void UIManager::UpdateInventoryButtons() {
 
 // Callback for handling the end of a battle.
 void UIManager::OnBattleEnd(const BattleResult result) {
-    // Notify the battle panel about the end result.
-    if (battlePanel) {
+    // Notify the battle panel about the end result (auto-resolved battles never show it).
+    if (battlePanel && currentState == UIState::BATTLE) {
         battlePanel->OnBattleEnd(result);
     }
 
     // If player won, update map (remove defeated monster) and check for level completion.
-    if (result == BattleResult::PLAYER_WON && currentBattleMonster && currentMap) {
+    if (result == BattleResult::PLAYER_WON && currentMap && currentMap->getMonstersConst().IsValid(currentBattleMonster)) {
         currentMap->setCell(*hero->GetPosition(), '.'); // Replace monster cell with floor
+
+        // Bosses always drop loot. A manual battle reports its end twice (battle system, then the panel
+        // closing); only the first report, while the battle is still active, rolls the drop.
+        const MonsterStore &monsters = currentMap->getMonstersConst();
+        if (battleSystem && battleSystem->IsBattleActive() &&
+            monsters.GetType(monsters.IndexOf(currentBattleMonster)) == MonsterType::BOSS) {
+            bossDrop = ItemGenerator::generateBossDrop(currentMap->GetCurrentLevel());
+        }
         UpdateMapRenderer(); // Refresh map rendering
         UpdateHUDStats(); // Update HUD stats (e.g., monster count)
 
@@ -908,6 +1001,15 @@ void UIManager::OnBattleEnd(const BattleResult result) {
     }
 }
 
+// Offers the boss drop rolled at the end of the battle; the level waits for the choice before moving on
+void UIManager::ShowBossDrop() {
+    if (!bossDrop || currentState != UIState::GAMEPLAY) return;
+
+    const Item drop = *bossDrop;
+    bossDrop.reset();
+    ShowEquipmentChoice(drop);
+}
+
 // Checks if a battle should start at the new position.
 bool UIManager::CheckForBattle(const Position &newPosition) {
     if (!hero || !battleSystem) return false;
@@ -920,15 +1022,15 @@ bool UIManager::CheckForBattle(const Position &newPosition) {
     return false;
 }
 
-void UIManager::ShowEquipmentChoice(std::unique_ptr<Item> newItem) {
-    if (!equipmentPanel || !hero || !newItem) return;
+void UIManager::ShowEquipmentChoice(const Item &newItem) {
+    if (!equipmentPanel || !hero) return;
 
     if (currentState == UIState::EQUIPMENT_SELECTION) {
         return; // Avoid showing multiple equipment panels
     }
 
-    // Store the item with ownership
-    pendingItem = std::move(newItem);
+    // Store a copy of the item; the panel points at it until the choice is made
+    pendingItem = newItem;
 
     const Item *currentItem = nullptr;
     switch (pendingItem->GetType()) {
@@ -945,6 +1047,6 @@ void UIManager::ShowEquipmentChoice(std::unique_ptr<Item> newItem) {
             break;
     }
 
-    equipmentPanel->Show(currentItem, pendingItem.get());
+    equipmentPanel->Show(currentItem, &*pendingItem);
     SetState(UIState::EQUIPMENT_SELECTION);
 }
@@ -1,6 +1,8 @@
 #include "C:/DandD/include/UI/panels/BattlePanel.h"
+#include "C:/DandD/include/UI/renderers/TextCache.h"
 #include <algorithm>
 #include <cmath>
+#include <cstdio>
 #include <iomanip>
 
 // Constructor for BattlePanel. Initializes UI state, colors, fonts, and button properties.
@@ -99,8 +101,7 @@ void BattlePanel::StartBattle(Hero *_player, Monster *monster, BattleSystem *bat
     isPlayerTurn = true; // Player always starts first
     waitingForInput = true; // Wait for player's action
 
-    clearLog(); // Clear previous battle log entries
-    addLogEntry("Battle begins!"); // Add initial log message
+    // The battle log is read from the BattleSystem event stream, which StartBattle has already reset
 }
 
 // Updates the state of the battle panel, including animations and input handling.
@@ -174,14 +175,8 @@ void BattlePanel::onWeaponAttack() {
     // Only allow action if waiting for input, it's player's turn, and battle system is valid.
     if (!waitingForInput || !isPlayerTurn || !battleSystem) return;
 
-    // Delegate the attack logic to the BattleSystem.
-    const double damage = battleSystem->PerformPlayerAttack(AttackType::WEAPON);
-
-    // Add a log entry describing the attack and damage.
-    const std::string attackName = player->GetInventory().GetWeapon().GetName();
-    const std::string logEntry = player->GetName() + " used " + attackName + "! It dealt " +
-                                 std::to_string(static_cast<int>(damage)) + " damage.";
-    addLogEntry(logEntry);
+    // Delegate the attack logic to the BattleSystem; it records the attack event for the log.
+    battleSystem->PerformPlayerAttack(AttackType::WEAPON);
 
     waitingForInput = false; // Player has made a choice, no longer waiting for input
 
@@ -196,14 +191,8 @@ void BattlePanel::onWeaponAttack() {
 void BattlePanel::onSpellAttack() {
     if (!waitingForInput || !isPlayerTurn || !battleSystem) return;
 
-    // Delegate the spell attack logic to the BattleSystem.
-    double damage = battleSystem->PerformPlayerAttack(AttackType::SPELL);
-
-    // Add a log entry describing the spell attack and damage.
-    const std::string attackName = player->GetInventory().GetSpell().GetName();
-    const std::string logEntry = player->GetName() + " used " + attackName + "! It dealt " +
-                                 std::to_string(static_cast<int>(damage)) + " damage.";
-    addLogEntry(logEntry);
+    // Delegate the spell attack logic to the BattleSystem; it records the attack event for the log.
+    battleSystem->PerformPlayerAttack(AttackType::SPELL);
 
     waitingForInput = false; // Player has made a choice
 
@@ -220,10 +209,8 @@ void BattlePanel::onFlee() {
 
     // Delegate fleeing logic to the BattleSystem.
     if (battleSystem->CanPlayerFlee()) {
-        addLogEntry(player->GetName() + " fled from battle!");
         battleSystem->PlayerFlee(); // Inform battle system of flee
     } else {
-        addLogEntry("Cannot flee from this battle!");
         waitingForInput = true; // If flee failed, player can choose another action
     }
 }
@@ -232,13 +219,8 @@ void BattlePanel::onFlee() {
 void BattlePanel::HandleMonsterTurn() {
     if (!battleSystem || !battleSystem->IsBattleActive()) return;
 
-    // Delegate monster attack logic to the BattleSystem.
-    double damage = battleSystem->PerformMonsterAttack();
-
-    // Add a log entry describing the monster's attack.
-    const std::string logEntry = currentMonster->GetName() + " attacked! You lost " +
-                                 std::to_string(static_cast<int>(damage)) + " HP.";
-    addLogEntry(logEntry);
+    // Delegate monster attack logic to the BattleSystem; it records the attack event for the log.
+    battleSystem->PerformMonsterAttack();
 
     // Check if the battle is still active after the monster's attack.
     if (battleSystem->IsBattleActive()) {
@@ -249,22 +231,7 @@ void BattlePanel::HandleMonsterTurn() {
 
 // Callback method called by UIManager or BattleSystem when the battle concludes.
 void BattlePanel::OnBattleEnd(const BattleResult result) {
-    battleResult = result; // Store the battle outcome
-
-    // Add a log entry based on the battle result.
-    switch (result) {
-        case BattleResult::PLAYER_WON:
-            addLogEntry("Victory! " + player->GetName() + " wins!");
-            break;
-        case BattleResult::PLAYER_LOST:
-            addLogEntry("Defeat! " + player->GetName() + " was defeated!");
-            break;
-        case BattleResult::PLAYER_FLED:
-            addLogEntry("You escaped from battle!");
-            break;
-        default:
-            break;
-    }
+    battleResult = result; // Store the battle outcome (the result line comes from the event stream)
 
     currentState = BattleState::ANIMATING_OUT; // Begin animation to hide the panel
 }
@@ -291,13 +258,13 @@ void BattlePanel::drawHeader() const {
 
     // Draw player information.
     const std::string heroInfo = player->GetName() + " | Level: " + std::to_string(player->GetLevel());
-    DrawTextEx(uiFont, heroInfo.c_str(),
+    TextCache::Draw(uiFont, heroInfo.c_str(),
                {headerRect.x + 10, headerRect.y + 10}, 20, 1, WHITE);
 
     // Draw monster information (right-aligned).
     std::string monsterInfo = currentMonster->GetName() + " | Level: " + std::to_string(currentMonster->GetLevel());
-    Vector2 monsterTextSize = MeasureTextEx(uiFont, monsterInfo.c_str(), 20, 1);
-    DrawTextEx(uiFont, monsterInfo.c_str(),
+    Vector2 monsterTextSize = TextCache::Measure(uiFont, monsterInfo.c_str(), 20, 1);
+    TextCache::Draw(uiFont, monsterInfo.c_str(),
                {headerRect.x + headerRect.width - monsterTextSize.x - 10, headerRect.y + 10},
                20, 1, textColor);
 }
@@ -324,14 +291,10 @@ void BattlePanel::drawHealthBars() const {
     DrawRectangleLinesEx(heroHealthBg, 1, WHITE); // Border
 
     // Display hero's health text.
-    std::ostringstream healthStreamHero;
-    healthStreamHero << std::fixed << std::setprecision(1)
-            << player->GetHealth() << "/"
-            << player->GetMaxHealth();
+    char heroHealth[32];
+    std::snprintf(heroHealth, sizeof(heroHealth), "%.1f/%.1f", player->GetHealth(), player->GetMaxHealth());
 
-    const std::string heroHealth = healthStreamHero.str();
-
-    DrawTextEx(uiFont, heroHealth.c_str(),
+    TextCache::Draw(uiFont, heroHealth,
                {heroHealthBg.x + 5, heroHealthBg.y + 2}, 16, 1, WHITE);
 
     // Monster Health Bar (right-aligned)
@@ -351,15 +314,12 @@ void BattlePanel::drawHealthBars() const {
     DrawRectangleLinesEx(monsterHealthBg, 1, WHITE);
 
     // Display monster's health text.
-    std::ostringstream healthStreamMonster;
-    healthStreamMonster << std::fixed << std::setprecision(1)
-            << currentMonster->GetHealth() << "/"
-            << currentMonster->GetMaxHealth();
-
-    const std::string monsterHealth = healthStreamMonster.str();
+    char monsterHealth[32];
+    std::snprintf(monsterHealth, sizeof(monsterHealth), "%.1f/%.1f", currentMonster->GetHealth(),
+                  currentMonster->GetMaxHealth());
 
-    Vector2 monsterHealthSize = MeasureTextEx(uiFont, monsterHealth.c_str(), 16, 1);
-    DrawTextEx(uiFont, monsterHealth.c_str(),
+    Vector2 monsterHealthSize = TextCache::Measure(uiFont, monsterHealth, 16, 1);
+    TextCache::Draw(uiFont, monsterHealth,
                {monsterHealthBg.x + monsterHealthBg.width - monsterHealthSize.x - 5, monsterHealthBg.y + 2},
                16, 1, WHITE);
 }
@@ -377,21 +337,76 @@ void BattlePanel::drawBattleLog() const {
     DrawRectangleRounded(logRect, 0.05f, 10, logBackgroundColor); // Draw log background
     DrawRectangleRoundedLines(logRect, 0.05f, 10, 1, GRAY); // Draw log border
 
-    DrawTextEx(uiFont, "Battle Log",
+    TextCache::Draw(uiFont, "Battle Log",
                {logRect.x + 10, logRect.y + 5}, 18, 1, LIGHTGRAY); // Log title
 
     float lineHeight = 25; // Spacing between log lines
     float textY = logRect.y + 35; // Starting Y position for text
 
-    // Determine the starting index to display only the most recent 'maxLogLines' entries.
-    const int startIndex = std::max(0, static_cast<int>(battleLog.size()) - maxLogLines);
-    for (int i = startIndex; i < battleLog.size(); i++) {
-        DrawTextEx(uiFont, battleLog[i].c_str(),
-                   {logRect.x + 10, textY}, 16, 1, textColor);
+    if (!battleSystem) return;
+
+    // Only the most recent 'maxLogLines' events are formatted; older ones stay as raw records.
+    const BattleEventLog &eventLog = battleSystem->GetEventLog();
+    const size_t visibleLines = static_cast<size_t>(maxLogLines);
+    const size_t startIndex = eventLog.Size() > visibleLines ? eventLog.Size() - visibleLines : 0;
+
+    char line[128];
+    for (size_t i = startIndex; i < eventLog.Size(); i++) {
+        if (!formatLogEntry(eventLog.At(i), line, sizeof(line))) continue;
+
+        TextCache::Draw(uiFont, line, {logRect.x + 10, textY}, 16, 1, textColor);
         textY += lineHeight; // Move to the next line
     }
 }
 
+// Builds the display text for a single battle event into a caller-provided buffer.
+bool BattlePanel::formatLogEntry(const BattleEvent &event, char *buffer, const size_t bufferSize) const {
+    if (!player || !currentMonster) return false;
+
+    const int damage = static_cast<int>(event.damage);
+    const char *critText = event.critical ? " Critical hit!" : "";
+
+    switch (event.type) {
+        case BattleEventType::BATTLE_STARTED:
+            std::snprintf(buffer, bufferSize, "Battle begins!");
+            return true;
+
+        case BattleEventType::ATTACK:
+            if (event.actor == BattleActor::HERO) {
+                const Item &item = event.attackType == AttackType::WEAPON
+                                       ? static_cast<const Item &>(player->GetInventory().GetWeapon())
+                                       : static_cast<const Item &>(player->GetInventory().GetSpell());
+                std::snprintf(buffer, bufferSize, "%s used %s! It dealt %d damage.%s",
+                              player->GetName().c_str(), item.GetName().c_str(), damage, critText);
+            } else {
+                std::snprintf(buffer, bufferSize, "%s attacked! You lost %d HP.%s",
+                              currentMonster->GetName().c_str(), damage, critText);
+            }
+            return true;
+
+        case BattleEventType::FLED:
+            std::snprintf(buffer, bufferSize, "%s fled from battle!", player->GetName().c_str());
+            return true;
+
+        case BattleEventType::BATTLE_ENDED:
+            switch (event.result) {
+                case BattleResult::PLAYER_WON:
+                    std::snprintf(buffer, bufferSize, "Victory! %s wins!", player->GetName().c_str());
+                    return true;
+                case BattleResult::PLAYER_LOST:
+                    std::snprintf(buffer, bufferSize, "Defeat! %s was defeated!", player->GetName().c_str());
+                    return true;
+                case BattleResult::PLAYER_FLED:
+                    std::snprintf(buffer, bufferSize, "You escaped from battle!");
+                    return true;
+                default:
+                    return false;
+            }
+    }
+
+    return false;
+}
+
 // Draws the player action buttons.
 void BattlePanel::drawButtons() const {
     if (!player) return;
@@ -409,11 +424,11 @@ void BattlePanel::drawButtons() const {
     const Rectangle spellBounds = spellButton.GetBounds();
 
     // Measure text size for centering.
-    const Vector2 weaponTextSize = MeasureTextEx(uiFont, weaponLabel.c_str(), 14, 1);
-    const Vector2 spellTextSize = MeasureTextEx(uiFont, spellLabel.c_str(), 14, 1);
+    const Vector2 weaponTextSize = TextCache::Measure(uiFont, weaponLabel.c_str(), 14, 1);
+    const Vector2 spellTextSize = TextCache::Measure(uiFont, spellLabel.c_str(), 14, 1);
 
     // Draw weapon name below the weapon button.
-    DrawTextEx(uiFont, weaponLabel.c_str(),
+    TextCache::Draw(uiFont, weaponLabel.c_str(),
                {
                    weaponBounds.x + (weaponBounds.width - weaponTextSize.x) / 2,
                    weaponBounds.y + (weaponBounds.height - weaponTextSize.y) / 2 + 15
@@ -422,26 +437,13 @@ void BattlePanel::drawButtons() const {
     );
 
     // Draw spell name below the spell button.
-    DrawTextEx(uiFont, spellLabel.c_str(),
+    TextCache::Draw(uiFont, spellLabel.c_str(),
                {
                    spellBounds.x + (spellBounds.width - spellTextSize.x) / 2,
                    spellBounds.y + (spellBounds.height - spellTextSize.y) / 2 + 15
                }, 14, 1, LIGHTGRAY);
 }
 
-// Adds a new entry to the battle log, managing the maximum number of lines.
-void BattlePanel::addLogEntry(const std::string &entry) {
-    battleLog.push_back(entry); // Add entry to the end of the log
-    if (battleLog.size() > maxLogLines) {
-        battleLog.erase(battleLog.begin()); // Remove the oldest entry if log exceeds max lines
-    }
-}
-
-// Clears all entries from the battle log.
-void BattlePanel::clearLog() {
-    battleLog.clear();
-}
-
 // Checks if the battle panel is currently active or animating in.
 bool BattlePanel::IsActive() const {
     return currentState == BattleState::ACTIVE || currentState == BattleState::ANIMATING_IN;
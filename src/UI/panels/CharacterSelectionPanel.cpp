@@ -3,6 +3,7 @@
 //
 
 #include "C:/DandD/include/UI/panels/CharacterSelectionPanel.h"
+#include "C:/DandD/include/UI/managers/ResourceManager.h"
 #include <iostream>
 #include <sstream>
 #include <vector>
@@ -11,7 +12,8 @@
 // Initializes screen dimensions, default states, colors, and loads initial data.
 CharacterSelectionPanel::CharacterSelectionPanel(const int screenWidth, const int screenHeight)
     : screenWidth(screenWidth), screenHeight(screenHeight),
-      backgroundTexture({0}), // Initialize texture to empty
+      backgroundTexture(nullptr), // Acquired by LoadBackgroundImage
+      fallbackTexture({0}), // Nothing generated yet
       selectedRaceIndex(-1), // No race selected initially
       isVisible(false), // Panel is not visible by default
       selectionConfirmed(false), // Selection not confirmed initially
@@ -38,16 +40,21 @@ void CharacterSelectionPanel::Initialize() {
 }
 
 // Loads the background image for the panel.
-// Includes a fallback to a generated gradient image if the texture fails to load.
+// The file decodes in the background; if it fails, Update generates a gradient image as a fallback.
 void CharacterSelectionPanel::LoadBackgroundImage() {
-    // Load background image from a specified path.
-    backgroundTexture = LoadTexture("C:/DandD/assets/background/walls4.png");
-    // If texture loading fails (id is 0), generate a simple gradient image as a fallback.
-    if (backgroundTexture.id == 0) {
-        const Image img = GenImageGradientRadial(screenWidth, screenHeight, 0.0f, BLACK, DARKBLUE);
-        backgroundTexture = LoadTextureFromImage(img);
-        UnloadImage(img); // Unload the CPU-side image data after converting to GPU texture.
-    }
+    ReleaseBackgroundImage(); // Initialize may run more than once.
+
+    // Load background image from a specified path, shared with the main menu.
+    backgroundTexture = &ResourceManager::AcquireTexture("C:/DandD/assets/background/walls4.png");
+}
+
+// Generates the gradient fallback once the background file is known to have failed.
+void CharacterSelectionPanel::GenerateFallbackBackground() {
+    if (fallbackTexture.id != 0 || !backgroundTexture || !ResourceManager::HasFailed(*backgroundTexture)) return;
+
+    const Image img = GenImageGradientRadial(screenWidth, screenHeight, 0.0f, BLACK, DARKBLUE);
+    fallbackTexture = LoadTextureFromImage(img);
+    UnloadImage(img); // Unload the CPU-side image data after converting to GPU texture.
 }
 
 // Populates the 'races' vector with predefined character race data.
@@ -138,6 +145,8 @@ void CharacterSelectionPanel::Hide() {
 void CharacterSelectionPanel::Update() {
     if (!isVisible) return; // Only update if the panel is visible.
 
+    GenerateFallbackBackground(); // In case the background file turned out to be missing.
+
     Vector2 mousePos = GetMousePosition(); // Get current mouse cursor position.
 
     // Update all race selection buttons.
@@ -158,18 +167,20 @@ void CharacterSelectionPanel::Draw() const {
     if (!isVisible) return; // Only draw if the panel is visible.
 
     // Draw background image, scaled to cover the screen while maintaining aspect ratio.
-    if (backgroundTexture.id != 0) {
-        const float scaleX = static_cast<float>(screenWidth) / backgroundTexture.width;
-        const float scaleY = static_cast<float>(screenHeight) / backgroundTexture.height;
+    // Nothing is drawn while the file is still loading.
+    const Texture2D &background = backgroundTexture && backgroundTexture->id != 0 ? *backgroundTexture : fallbackTexture;
+    if (background.id != 0) {
+        const float scaleX = static_cast<float>(screenWidth) / background.width;
+        const float scaleY = static_cast<float>(screenHeight) / background.height;
         const float scale = (scaleX > scaleY) ? scaleX : scaleY; // Choose larger scale to ensure coverage.
 
         // Calculate origin to center the scaled texture.
         Vector2 origin = {
-            (screenWidth - backgroundTexture.width * scale) / 2,
-            (screenHeight - backgroundTexture.height * scale) / 2
+            (screenWidth - background.width * scale) / 2,
+            (screenHeight - background.height * scale) / 2
         };
 
-        DrawTextureEx(backgroundTexture, origin, 0.0f, scale, WHITE); // Draw the texture.
+        DrawTextureEx(background, origin, 0.0f, scale, WHITE); // Draw the texture.
     }
 
     // Draw a semi-transparent black overlay for readability over the background.
@@ -399,8 +410,17 @@ void CharacterSelectionPanel::Reset() {
 // Destructor for CharacterSelectionPanel.
 // Responsible for unloading the background texture to prevent memory leaks.
 CharacterSelectionPanel::~CharacterSelectionPanel() {
-    if (backgroundTexture.id != 0) {
-        // Only unload if the texture was actually loaded.
-        UnloadTexture(backgroundTexture);
+    ReleaseBackgroundImage();
+}
+
+// Gives the background back: the fallback gradient is ours, the file texture is shared.
+void CharacterSelectionPanel::ReleaseBackgroundImage() {
+    if (fallbackTexture.id != 0) {
+        UnloadTexture(fallbackTexture);
+        fallbackTexture = Texture2D{};
+    }
+    if (backgroundTexture) {
+        ResourceManager::ReleaseTexture(*backgroundTexture);
+        backgroundTexture = nullptr;
     }
 }
@@ -3,6 +3,7 @@
 //
 
 #include "C:/DandD/include/UI/panels/EquipmentPanel.h"
+#include "C:/DandD/include/Utils/ProbabilitySystem.h"
 #include <cmath>
 #include <iomanip>
 
@@ -44,18 +45,16 @@ void EquipmentPanel::ShowComparison(const Item *newTreasure) {
 
     const Inventory &inventory = player->GetInventory(); // Get the player's inventory.
     const Item *currentItem = nullptr; // Initialize current item pointer.
-    const std::string typeStr = newTreasure->GetTypeStr(); // Get the string representation of the new item's type.
+    itemType = newTreasure->GetType();
 
     // Based on the new item's type, retrieve the corresponding currently equipped item from inventory.
-    if (typeStr == "ARMOR") {
-        currentItem = &inventory.GetArmor();
-        itemType = ItemType::ARMOR;
-    } else if (typeStr == "WEAPON") {
-        currentItem = &inventory.GetWeapon();
-        itemType = ItemType::WEAPON;
-    } else if (typeStr == "SPELL") {
-        currentItem = &inventory.GetSpell();
-        itemType = ItemType::SPELL;
+    switch (itemType) {
+        case ItemType::ARMOR: currentItem = &inventory.GetArmor();
+            break;
+        case ItemType::WEAPON: currentItem = &inventory.GetWeapon();
+            break;
+        case ItemType::SPELL: currentItem = &inventory.GetSpell();
+            break;
     }
 
     // Call the overloaded Show method to display the comparison.
@@ -253,8 +252,14 @@ void EquipmentPanel::DrawPanelContent(const int x, const int y, const Item *item
     DrawText(name.c_str(), x + 10, y + 85, FONT_SIZE, WHITE);
 
     // Draw the item's type.
-    const std::string typeStr = item->GetTypeStr();
-    DrawText(typeStr.c_str(), x + 10, y + 110, SMALL_FONT_SIZE, LIGHTGRAY);
+    DrawText(item->GetTypeStr(), x + 10, y + 110, SMALL_FONT_SIZE, LIGHTGRAY);
+
+    // Rarity next to the type; the plainest tier is left unlabelled
+    if (item->GetRarity() > 0) {
+        const int typeWidth = MeasureText(item->GetTypeStr(), SMALL_FONT_SIZE);
+        DrawText(ItemGenerator::rarityName(item->GetRarity()).c_str(), x + 20 + typeWidth, y + 110,
+                 SMALL_FONT_SIZE, GOLD);
+    }
 
     // Draw the item's stats, with comparison highlights if enabled.
     DrawItemStats(x + 10, y + 140, item, showComparison);
@@ -266,31 +271,31 @@ void EquipmentPanel::DrawItemIcon(int x, int y, const Item *item) const {
         static_cast<float>(x), static_cast<float>(y), static_cast<float>(ICON_SIZE), static_cast<float>(ICON_SIZE)
     };
 
-    Color bgColor;
-    std::string symbol;
+    Color bgColor = GRAY;
+    const char *symbol = "?"; // Default for unknown types.
 
     // Assign color and symbol based on item type.
-    const std::string typeStr = item->GetTypeStr();
-    if (typeStr == "ARMOR") {
-        bgColor = BLUE;
-        symbol = "A";
-    } else if (typeStr == "WEAPON") {
-        bgColor = RED;
-        symbol = "W";
-    } else if (typeStr == "SPELL") {
-        bgColor = PURPLE;
-        symbol = "S";
-    } else {
-        bgColor = GRAY;
-        symbol = "?"; // Default for unknown types.
+    switch (item->GetType()) {
+        case ItemType::ARMOR:
+            bgColor = BLUE;
+            symbol = "A";
+            break;
+        case ItemType::WEAPON:
+            bgColor = RED;
+            symbol = "W";
+            break;
+        case ItemType::SPELL:
+            bgColor = PURPLE;
+            symbol = "S";
+            break;
     }
 
     DrawRectangleRec(iconRect, bgColor); // Draw icon background.
     DrawRectangleLinesEx(iconRect, 2, WHITE); // Draw icon border.
 
     // Draw the symbol centered within the icon.
-    const int symbolWidth = MeasureText(symbol.c_str(), 40);
-    DrawText(symbol.c_str(), x + (ICON_SIZE - symbolWidth) / 2, y + (ICON_SIZE - 40) / 2, 40, WHITE);
+    const int symbolWidth = MeasureText(symbol, 40);
+    DrawText(symbol, x + (ICON_SIZE - symbolWidth) / 2, y + (ICON_SIZE - 40) / 2, 40, WHITE);
 }
 
 // Draws the stats of an item, optionally showing a comparison to the current item.
@@ -343,14 +348,14 @@ void EquipmentPanel::DrawItemStats(int x, int y, const Item *item, bool showComp
     currentY += lineHeight;
 
     // Generate and display description based on item type.
-    std::string typeStr = item->GetTypeStr();
     std::string description;
-    if (typeStr == "WEAPON") {
-        description = "Increases attack damage";
-    } else if (typeStr == "ARMOR") {
-        description = "Reduces damage taken";
-    } else if (typeStr == "SPELL") {
-        description = "Increases spell power";
+    switch (item->GetType()) {
+        case ItemType::WEAPON: description = "Increases attack damage";
+            break;
+        case ItemType::ARMOR: description = "Reduces damage taken";
+            break;
+        case ItemType::SPELL: description = "Increases spell power";
+            break;
     }
 
     if (!description.empty()) {
@@ -397,20 +402,9 @@ void EquipmentPanel::OnEquipNewItem() {
         return;
     }
 
-    // Determine the type of the new item and call the appropriate inventory method to equip it.
-    const std::string typeStr = newItem->GetTypeStr();
-
+    // The inventory puts the new item into the slot matching its type.
     try {
-        if (typeStr == "ARMOR") {
-            const Armor *armorItem = static_cast<const Armor *>(newItem);
-            player->GetInventory().newArmor(*armorItem);
-        } else if (typeStr == "WEAPON") {
-            const Weapon *weaponItem = static_cast<const Weapon *>(newItem);
-            player->GetInventory().newWeapon(*weaponItem);
-        } else if (typeStr == "SPELL") {
-            const Spell *spellItem = static_cast<const Spell *>(newItem);
-            player->GetInventory().newSpell(*spellItem);
-        }
+        player->GetInventory().equip(*newItem);
 
         if (onEquipCallback) {
             onEquipCallback();
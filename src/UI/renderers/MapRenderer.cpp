@@ -4,18 +4,28 @@
 
 
 #include "C:/DandD/include/UI/renderers/MapRenderer.h"
+#include "C:/DandD/include/UI/managers/ResourceManager.h"
 #include <cmath>
 #include <algorithm>
+#include <iterator>
 
 // Constructor: Initializes MapRenderer with screen dimensions and default camera settings.
 MapRenderer::MapRenderer(const int _screenWidth, const int _screenHeight)
-    : map(nullptr), heroPosition(nullptr), // Pointers to map and hero position are initially null.
+    : map(nullptr), heroPosition(nullptr), fieldOfView(nullptr), // Pointers to map and hero position are initially null.
       screenWidth(_screenWidth), screenHeight(_screenHeight), // Store screen dimensions.
-      cellSize(40.0f), resourcesLoaded(false) {
+      cellSize(40.0f), resourcesLoaded(false),
+      tileFrame(0), chunksX(0), chunksY(0), bakedCellPixels(0), bakedDetail(TileDetail::TEXTURED), bakedMapGeneration(0), bakedTileChanges(0), bakedFovCount(0),
+      bakedFovOrigin(-1, -1), tileDrawCalls(0), atlas(nullptr),
+      floorSprite(TextureAtlas::INVALID_SPRITE), wallSprite(TextureAtlas::INVALID_SPRITE),
+      heroSprite(TextureAtlas::INVALID_SPRITE), monsterSprite(TextureAtlas::INVALID_SPRITE),
+      bossSprite(TextureAtlas::INVALID_SPRITE), treasureSprite(TextureAtlas::INVALID_SPRITE),
+      portalSprite(TextureAtlas::INVALID_SPRITE) {
     // Default cell size and resource loading status.
     camera.visibleCellsX = 10; // Number of cells visible horizontally in the main map view.
     camera.visibleCellsY = 10; // Number of cells visible vertically in the main map view.
-    camera.smoothFactor = 0.1f; // Factor for smooth camera movement.
+    camera.viewWidth = camera.visibleCellsX * cellSize; // The map area stays this size while zooming.
+    camera.viewHeight = camera.visibleCellsY * cellSize;
+    camera.smoothFactor = 0.1f; // Share of the distance to the target covered every 1/60 s.
 }
 
 // Destructor: Ensures all loaded resources are unloaded when the renderer is destroyed.
@@ -30,29 +40,43 @@ void MapRenderer::Initialize(Map *mapRef, Position *heroPositionRef) {
 
     // If both map and hero position are valid, set initial camera position.
     if (heroPosition && map) {
-        camera.position = {
-            static_cast<float>(heroPosition->x) - camera.visibleCellsX * 0.5f, // Center camera on hero's X.
-            static_cast<float>(heroPosition->y) - camera.visibleCellsY * 0.5f // Center camera on hero's Y.
-        };
+        const Vector2 viewCells = GetViewCells();
+        camera.position = ClampCamera({
+            static_cast<float>(heroPosition->x) - viewCells.x * 0.5f, // Center camera on hero's X.
+            static_cast<float>(heroPosition->y) - viewCells.y * 0.5f // Center camera on hero's Y.
+        });
         camera.target = camera.position; // Set the camera target to its initial position.
+        camera.previous = camera.position; // No motion to interpolate yet.
+        camera.current = camera.position;
         visibleArea.needsUpdate = true; // Mark the visible area as needing an update.
     }
 }
 
-// Loads all necessary textures and fonts for rendering the map and its entities.
+// Sets the field of view that decides which cells are hidden by fog.
+void MapRenderer::SetFieldOfView(const FieldOfView *fov) {
+    fieldOfView = fov;
+    ReleaseTileChunks(); // Baked under the old fog
+    ReleaseMinimap();
+}
+
+// Queues every map sprite in the shared atlas, so tiles and entities all draw from one texture.
+void MapRenderer::RegisterSprites(TextureAtlas &atlasRef) {
+    atlas = &atlasRef;
+
+    floorSprite = atlasRef.Add("C:/DandD/assets/map/floor_tile.png");
+    wallSprite = atlasRef.Add("C:/DandD/assets/map/wall_tile.png");
+    heroSprite = atlasRef.Add("C:/DandD/assets/entities/hero_icon.png");
+    monsterSprite = atlasRef.Add("C:/DandD/assets/entities/monster_icon.png");
+    bossSprite = atlasRef.Add("C:/DandD/assets/entities/boss_icon.png");
+    treasureSprite = atlasRef.Add("C:/DandD/assets/objects/treasure_icon.png");
+    portalSprite = atlasRef.Add("C:/DandD/assets/objects/portal_icon.png");
+}
+
+// Loads the font for rendering the map; sprites come from the atlas.
 void MapRenderer::LoadResources() {
     if (resourcesLoaded) return; // Prevent re-loading if already loaded.
 
-    // Load various textures from specified paths.
-    floorTexture = LoadTexture("C:/DandD/assets/map/floor_tile.png");
-    wallTexture = LoadTexture("C:/DandD/assets/map/wall_tile.png");
-    heroTexture = LoadTexture("C:/DandD/assets/entities/hero_icon.png");
-    monsterTexture = LoadTexture("C:/DandD/assets/entities/monster_icon.png");
-    bossTexture = LoadTexture("C:/DandD/assets/entities/boss_icon.png");
-    treasureTexture = LoadTexture("C:/DandD/assets/objects/treasure_icon.png");
-    portalTexture = LoadTexture("C:/DandD/assets/objects/portal_icon.png");
-
-    gameFont = LoadFont("C:/DandD/assets/fonts/.TTF"); // Load game font.
+    gameFont = ResourceManager::AcquireFont("C:/DandD/assets/fonts/.TTF"); // Load game font, shared with the HUD.
 
     resourcesLoaded = true; // Mark resources as loaded.
 }
@@ -61,21 +85,16 @@ void MapRenderer::LoadResources() {
 void MapRenderer::Unload() {
     if (!resourcesLoaded) return; // Only unload if resources were loaded.
 
-    // Unload all textures.
-    UnloadTexture(floorTexture);
-    UnloadTexture(wallTexture);
-    UnloadTexture(heroTexture);
-    UnloadTexture(monsterTexture);
-    UnloadTexture(bossTexture);
-    UnloadTexture(treasureTexture);
-    UnloadTexture(portalTexture);
-    UnloadFont(gameFont); // Unload the font.
+    // Sprites belong to the atlas, which is unloaded by its owner.
+    ResourceManager::ReleaseFont(gameFont); // Release the font.
+    ReleaseTileChunks(); // Free the baked tile layer.
+    ReleaseMinimap(); // And the minimap raster.
 
     resourcesLoaded = false; // Mark resources as unloaded.
 }
 
-// Updates the renderer's state, including screen dimensions and camera position.
-void MapRenderer::Update(float deltaTime) {
+// Updates the renderer's state, including screen dimensions and camera position; called at the simulation rate.
+void MapRenderer::Update(const float deltaTime) {
     const int newWidth = GetScreenWidth();
     const int newHeight = GetScreenHeight();
 
@@ -85,47 +104,108 @@ void MapRenderer::Update(float deltaTime) {
         screenHeight = newHeight;
     }
 
-    UpdateCamera(); // Update the camera's position.
+    UpdateCamera(deltaTime); // Update the camera's position.
+}
+
+// Blends the drawn camera between the last two simulated positions.
+void MapRenderer::Interpolate(const float alpha) {
+    camera.position.x = camera.previous.x + (camera.current.x - camera.previous.x) * alpha;
+    camera.position.y = camera.previous.y + (camera.current.y - camera.previous.y) * alpha;
+
+    // Calculate difference in camera position since last update to check if visible area needs recalculation.
+    Vector2 cameraDiff = {
+        std::abs(camera.position.x - visibleArea.lastCameraPos.x),
+        std::abs(camera.position.y - visibleArea.lastCameraPos.y)
+    };
+
+    // If camera moved significantly, mark visible area for update.
+    if (cameraDiff.x > 0.01f || cameraDiff.y > 0.01f) {
+        visibleArea.needsUpdate = true;
+    }
+}
+
+// Returns true while the camera has not settled: it moved in the last step, or the drawn position lags behind.
+bool MapRenderer::IsCameraMoving() const {
+    constexpr float EPSILON = 0.0005f; // Well under a pixel at any cell size.
+    return std::abs(camera.current.x - camera.previous.x) > EPSILON ||
+           std::abs(camera.current.y - camera.previous.y) > EPSILON ||
+           std::abs(camera.position.x - camera.current.x) > EPSILON ||
+           std::abs(camera.position.y - camera.current.y) > EPSILON;
 }
 
-// Smoothly moves the camera towards the hero's position and clamps it within map bounds.
-void MapRenderer::UpdateCamera() {
+// Smoothly moves the simulated camera towards the hero's position and clamps it within map bounds.
+void MapRenderer::UpdateCamera(const float deltaTime) {
     if (!heroPosition || !map) return; // Requires hero position and map to update camera.
 
     // Set the camera's target position, centered on the hero.
+    const Vector2 viewCells = GetViewCells();
     camera.target = {
-        static_cast<float>(heroPosition->x) - camera.visibleCellsX * 0.5f,
-        static_cast<float>(heroPosition->y) - camera.visibleCellsY * 0.5f
+        static_cast<float>(heroPosition->x) - viewCells.x * 0.5f,
+        static_cast<float>(heroPosition->y) - viewCells.y * 0.5f
     };
 
+    camera.previous = camera.current;
+
     // Calculate the difference between current camera position and target.
     Vector2 diff = {
-        camera.target.x - camera.position.x,
-        camera.target.y - camera.position.y
+        camera.target.x - camera.current.x,
+        camera.target.y - camera.current.y
     };
 
-    // Smoothly interpolate the camera's position towards the target.
-    camera.position.x += diff.x * camera.smoothFactor;
-    camera.position.y += diff.y * camera.smoothFactor;
+    // Smoothly interpolate the camera's position towards the target, at the same speed whatever the step length.
+    const float follow = 1.0f - std::pow(1.0f - camera.smoothFactor, deltaTime * 60.0f);
+    camera.current.x += diff.x * follow;
+    camera.current.y += diff.y * follow;
 
-    // Calculate maximum camera coordinates to prevent it from going off the map.
-    const float maxX = static_cast<float>(map->getWidth()) - camera.visibleCellsX;
-    const float maxY = static_cast<float>(map->getHeight()) - camera.visibleCellsY;
+    camera.current = ClampCamera(camera.current); // Keep the view on the map.
+}
 
-    // Clamp the camera's position within valid map boundaries.
-    camera.position.x = std::clamp(camera.position.x, 0.0f, std::max(0.0f, maxX));
-    camera.position.y = std::clamp(camera.position.y, 0.0f, std::max(0.0f, maxY));
+// Returns how many cells the map area spans at the current cell size.
+Vector2 MapRenderer::GetViewCells() const {
+    return {camera.viewWidth / cellSize, camera.viewHeight / cellSize};
+}
 
-    // Calculate difference in camera position since last update to check if visible area needs recalculation.
-    Vector2 cameraDiff = {
-        std::abs(camera.position.x - visibleArea.lastCameraPos.x),
-        std::abs(camera.position.y - visibleArea.lastCameraPos.y)
+// Clamps a camera position to the map; on an axis where the whole level fits, the level is centred instead.
+Vector2 MapRenderer::ClampCamera(const Vector2 position) const {
+    if (!map) return position;
+
+    // Calculate maximum camera coordinates to prevent it from going off the map.
+    const Vector2 viewCells = GetViewCells();
+    const float maxX = static_cast<float>(map->getWidth()) - viewCells.x;
+    const float maxY = static_cast<float>(map->getHeight()) - viewCells.y;
+
+    return {
+        maxX < 0.0f ? maxX * 0.5f : std::clamp(position.x, 0.0f, maxX),
+        maxY < 0.0f ? maxY * 0.5f : std::clamp(position.y, 0.0f, maxY)
     };
+}
 
-    // If camera moved significantly, mark visible area for update.
-    if (cameraDiff.x > 0.01f || cameraDiff.y > 0.01f) {
-        visibleArea.needsUpdate = true;
+// Returns the smallest cell size: the one that fits the whole level into the map area.
+float MapRenderer::GetMinCellSize() const {
+    constexpr float DEFAULT_MIN = 10.0f; // Small levels still zoom out to here.
+    constexpr float FLOOR = 0.05f; // Guards against absurd level sizes.
+    if (!map || map->getWidth() == 0 || map->getHeight() == 0) return DEFAULT_MIN;
+
+    const float fit = std::min(camera.viewWidth / static_cast<float>(map->getWidth()),
+                               camera.viewHeight / static_cast<float>(map->getHeight()));
+    return std::max(FLOOR, std::min(DEFAULT_MIN, fit));
+}
+
+// Picks the tile layer's level of detail from the cell size.
+MapRenderer::TileDetail MapRenderer::GetTileDetail() const {
+    if (cellSize < RASTER_DETAIL_CELL) return TileDetail::RASTER;
+    if (cellSize < TEXTURED_DETAIL_CELL) return TileDetail::FLAT;
+    return TileDetail::TEXTURED;
+}
+
+// Returns the pixels per cell chunks are baked at: the first step of the ladder at or above the cell size.
+// Steps are at most 1.5x apart, so a blit never shrinks a chunk by more than that.
+int MapRenderer::GetBakeCellPixels() const {
+    constexpr int STEPS[] = {4, 8, 12, 16, 24, 32, 48, 64, 96, 128};
+    for (const int pixels: STEPS) {
+        if (static_cast<float>(pixels) >= cellSize) return pixels;
     }
+    return STEPS[std::size(STEPS) - 1];
 }
 
 // Recalculates the rectangular area of map cells that are currently visible on screen.
@@ -160,10 +240,29 @@ Vector2 MapRenderer::WorldToScreen(const int worldX, const int worldY) const {
     return {mapArea.x + screenX, mapArea.y + screenY};
 }
 
+// Converts screen coordinates back to the map cell drawn there, the inverse of WorldToScreen.
+bool MapRenderer::ScreenToWorld(const Vector2 screenPos, Position &worldPos) const {
+    if (!map) return false;
+
+    const Rectangle mapArea = GetMapArea();
+    if (!CheckCollisionPointRec(screenPos, mapArea)) return false; // Clicks on the HUD or minimap
+
+    // Undo the camera offset, flooring so cells left of or above the origin stay negative
+    const int worldX = static_cast<int>(std::floor((screenPos.x - mapArea.x) / cellSize + camera.position.x));
+    const int worldY = static_cast<int>(std::floor((screenPos.y - mapArea.y) / cellSize + camera.position.y));
+    if (worldX < 0 || worldY < 0 ||
+        worldX >= static_cast<int>(map->getWidth()) || worldY >= static_cast<int>(map->getHeight())) {
+        return false;
+    }
+
+    worldPos = Position(worldX, worldY);
+    return true;
+}
+
 // Returns the screen rectangle where the main game map should be drawn.
 Rectangle MapRenderer::GetMapArea() const {
-    const float mapWidth = camera.visibleCellsX * cellSize; // Calculate map width in pixels.
-    const float mapHeight = camera.visibleCellsY * cellSize; // Calculate map height in pixels.
+    const float mapWidth = camera.viewWidth; // Map width in pixels, the same at every zoom.
+    const float mapHeight = camera.viewHeight; // Map height in pixels.
     const float mapX = (screenWidth - mapWidth) * 0.5f; // Center the map horizontally.
     const float mapY = 150.0f; // Fixed Y position for the top of the map.
 
@@ -179,20 +278,29 @@ bool MapRenderer::IsInVisibleArea(const int x, const int y) const {
 
 // Draws the main game map, including borders, tiles, entities, and the minimap.
 void MapRenderer::Draw() const {
-    if (!map || !resourcesLoaded) return; // Can't draw without map data or loaded resources.
+    if (!map || !resourcesLoaded || !atlas) return; // Can't draw without map data or loaded resources.
 
     const Rectangle mapArea = GetMapArea();
     // DrawRectangleRec(mapArea, BACKGROUND_COLOR); // Optional: Draw a background for the map area.
 
     DrawMapBorder(); // Draw the border around the main map.
+    BakeVisibleChunks(); // Before the scissor, which would clip drawing into the chunk textures too.
+
+    // Cells straddling the edge are cut off at the border rather than spilling over the HUD.
+    BeginScissorMode(static_cast<int>(mapArea.x), static_cast<int>(mapArea.y),
+                     static_cast<int>(mapArea.width), static_cast<int>(mapArea.height));
     DrawTiles(); // Draw all visible map tiles (floor, walls).
-    DrawEntities(); // Draw characters, monsters, and objects.
+    if (GetTileDetail() != TileDetail::RASTER) {
+        DrawEntities(); // Draw characters, monsters, and objects; the raster already has them as dots.
+    }
+    EndScissorMode();
+
     DrawMinimap(); // Draw the small minimap in the corner.
 }
 
 // Draws the portal entity with a pulsing animation effect.
 void MapRenderer::DrawPortal(const Position &position, float animationTime) const {
-    if (!IsInVisibleArea(position.x, position.y) || portalTexture.id == 0) return;
+    if (!IsInVisibleArea(position.x, position.y) || !atlas || !atlas->IsValid(portalSprite)) return;
     // Only draw if visible and texture loaded.
 
     Vector2 screenPos = WorldToScreen(position.x, position.y); // Convert world to screen coordinates.
@@ -206,14 +314,8 @@ void MapRenderer::DrawPortal(const Position &position, float animationTime) cons
     screenPos.x += offset;
     screenPos.y += offset;
 
-    // Draw the portal texture with pulsing effect.
-    DrawTexturePro(
-        portalTexture,
-        {0, 0, static_cast<float>(portalTexture.width), static_cast<float>(portalTexture.height)},
-        // Source rectangle from texture.
-        {screenPos.x, screenPos.y, size, size}, // Destination rectangle on screen with scaled size.
-        {0, 0}, 0.0f, WHITE // Origin, rotation, tint.
-    );
+    // Draw the portal sprite with pulsing effect.
+    atlas->Draw(portalSprite, {screenPos.x, screenPos.y, size, size});
 }
 
 // Draws the border and an inner glow effect around the main map display area.
@@ -230,114 +332,324 @@ void MapRenderer::DrawMapBorder() const {
     DrawRectangleLinesEx(innerBorder, 1, BORDER_GLOW);
 }
 
+// Checks if the hero currently sees a cell; everything counts as seen when there is no fog.
+bool MapRenderer::IsCellInSight(const int x, const int y) const {
+    return !fieldOfView || fieldOfView->IsVisible(x, y);
+}
+
+// Checks if the hero has seen a cell at some point on this level.
+bool MapRenderer::IsCellExplored(const int x, const int y) const {
+    return !fieldOfView || fieldOfView->IsExplored(x, y);
+}
+
 // Helper function to draw a single textured tile at a given screen position.
-void MapRenderer::DrawTexturedTile(const Texture2D &texture, const Vector2 &screenPos) const {
-    if (texture.id != 0) {
-        // Only draw if the texture is valid.
-        DrawTexturePro(
-            texture,
-            {0, 0, static_cast<float>(texture.width), static_cast<float>(texture.height)}, // Source rectangle.
-            {screenPos.x, screenPos.y, cellSize, cellSize}, // Destination rectangle, scaled to cell size.
-            {0, 0}, 0.0f, WHITE // Origin, rotation, tint.
-        );
+void MapRenderer::DrawTexturedTile(const SpriteId sprite, const Vector2 &screenPos, const float size,
+                                   const Color tint) const {
+    // Invalid sprites (failed loads) draw nothing.
+    atlas->Draw(sprite, {screenPos.x, screenPos.y, size, size}, tint);
+}
+
+// Helper function to draw a sprite covering one map cell on screen.
+void MapRenderer::DrawSprite(const SpriteId sprite, const Position &cell) const {
+    const Vector2 screenPos = WorldToScreen(cell.x, cell.y);
+    atlas->Draw(sprite, {screenPos.x, screenPos.y, cellSize, cellSize});
+}
+
+// Returns the sprite drawn for a cell type (floor under entities), or an invalid id for cells left empty.
+SpriteId MapRenderer::GetTileSprite(const char cellType) const {
+    switch (cellType) {
+        case '#':
+            return wallSprite; // Wall.
+        case '.':
+        case 'H':
+        case 'M':
+        case 'B':
+        case 'T':
+            return floorSprite; // Floor for empty spaces or where entities are.
+        default:
+            return TextureAtlas::INVALID_SPRITE; // Nothing for unknown cell types.
     }
 }
 
-// Iterates through visible map cells and draws their corresponding tiles (floor or wall).
+// Bakes the chunks on screen that are new or out of date. Runs outside any scissor: raylib leaves the scissor
+// test on inside BeginTextureMode, so a bake under the map's scissor would lose the cells outside it.
+void MapRenderer::BakeVisibleChunks() const {
+    tileDrawCalls = 0;
+    if (!map || GetTileDetail() == TileDetail::RASTER) return;
+
+    SyncTileChunks(); // Pick up level loads, changed cells and fog movement.
+    UpdateVisibleArea(); // Ensure the visible area is current.
+
+    if (visibleArea.endX <= visibleArea.startX || visibleArea.endY <= visibleArea.startY) return;
+
+    tileFrame++;
+    for (int chunkY = visibleArea.startY / CHUNK_CELLS; chunkY <= (visibleArea.endY - 1) / CHUNK_CELLS; chunkY++) {
+        for (int chunkX = visibleArea.startX / CHUNK_CELLS; chunkX <= (visibleArea.endX - 1) / CHUNK_CELLS; chunkX++) {
+            TileChunk &chunk = tileChunks[chunkY * chunksX + chunkX];
+            chunk.lastSeenFrame = tileFrame;
+            if (chunk.dirty || chunk.target.id == 0) {
+                BakeChunk(chunkX, chunkY);
+                tileDrawCalls++;
+            }
+        }
+    }
+
+    EvictTileChunks(); // Panning across a big level would otherwise keep every chunk it passed.
+}
+
+// Blits the visible part of every chunk on screen; BakeVisibleChunks has brought them up to date.
+// Far out, the level's minimap raster is drawn instead.
 void MapRenderer::DrawTiles() const {
     if (!map) return; // Requires map data.
 
-    UpdateVisibleArea(); // Ensure the visible area is current.
+    if (GetTileDetail() == TileDetail::RASTER) {
+        DrawTileRaster();
+        return;
+    }
+
+    if (visibleArea.endX <= visibleArea.startX || visibleArea.endY <= visibleArea.startY) return;
+
+    const float texturePixels = static_cast<float>(CHUNK_CELLS * bakedCellPixels);
+    for (int chunkY = visibleArea.startY / CHUNK_CELLS; chunkY <= (visibleArea.endY - 1) / CHUNK_CELLS; chunkY++) {
+        for (int chunkX = visibleArea.startX / CHUNK_CELLS; chunkX <= (visibleArea.endX - 1) / CHUNK_CELLS; chunkX++) {
+            const TileChunk &chunk = tileChunks[chunkY * chunksX + chunkX];
+            if (chunk.target.id == 0) continue; // Only if its render texture could not be created.
+
+            // Only the cells of this chunk inside the visible area.
+            const int minX = std::max(visibleArea.startX, chunkX * CHUNK_CELLS);
+            const int minY = std::max(visibleArea.startY, chunkY * CHUNK_CELLS);
+            const int maxX = std::min(visibleArea.endX, (chunkX + 1) * CHUNK_CELLS);
+            const int maxY = std::min(visibleArea.endY, (chunkY + 1) * CHUNK_CELLS);
+
+            // Render textures are stored bottom-up, so rows are counted from the bottom and the height is negative.
+            const float localX = static_cast<float>((minX - chunkX * CHUNK_CELLS) * bakedCellPixels);
+            const float localBottom = static_cast<float>((maxY - chunkY * CHUNK_CELLS) * bakedCellPixels);
+            const Rectangle source = {
+                localX, texturePixels - localBottom,
+                static_cast<float>((maxX - minX) * bakedCellPixels), -static_cast<float>((maxY - minY) * bakedCellPixels)
+            };
+
+            const Vector2 screenPos = WorldToScreen(minX, minY);
+            const Rectangle dest = {
+                screenPos.x, screenPos.y, (maxX - minX) * cellSize, (maxY - minY) * cellSize
+            };
+
+            DrawTexturePro(chunk.target.texture, source, dest, {0, 0}, 0.0f, WHITE);
+            tileDrawCalls++;
+        }
+    }
+}
+
+// Draws the part of the minimap raster under the view as one quad: one texel per cell, whatever the cell count.
+void MapRenderer::DrawTileRaster() const {
+    SyncMinimap();
+    tileDrawCalls = 1;
+    if (minimap.texture.id == 0) return;
+
+    // Only the part of the view covered by the level, so the texture never wraps.
+    const Rectangle mapArea = GetMapArea();
+    const Vector2 viewCells = GetViewCells();
+    const float minX = std::max(0.0f, camera.position.x);
+    const float minY = std::max(0.0f, camera.position.y);
+    const float maxX = std::min(static_cast<float>(minimap.width), camera.position.x + viewCells.x);
+    const float maxY = std::min(static_cast<float>(minimap.height), camera.position.y + viewCells.y);
+    if (maxX <= minX || maxY <= minY) return;
+
+    const Rectangle source = {minX, minY, maxX - minX, maxY - minY};
+    const Rectangle dest = {
+        mapArea.x + (minX - camera.position.x) * cellSize, mapArea.y + (minY - camera.position.y) * cellSize,
+        (maxX - minX) * cellSize, (maxY - minY) * cellSize
+    };
+    DrawTexturePro(minimap.texture, source, dest, {0, 0}, 0.0f, WHITE);
+}
+
+// Brings the chunk grid up to date: everything is re-baked after a level load or a cell size change, otherwise
+// only the chunks around changed cells and around the old and new fog origins.
+void MapRenderer::SyncTileChunks() const {
+    const int cellPixels = GetBakeCellPixels();
+    const TileDetail detail = GetTileDetail();
+    const int neededX = (static_cast<int>(map->getWidth()) + CHUNK_CELLS - 1) / CHUNK_CELLS;
+    const int neededY = (static_cast<int>(map->getHeight()) + CHUNK_CELLS - 1) / CHUNK_CELLS;
+
+    if (tileChunks.empty() || bakedMapGeneration != map->GetLoadGeneration() || bakedCellPixels != cellPixels ||
+        bakedDetail != detail || chunksX != neededX || chunksY != neededY) {
+        ReleaseTileChunks();
+        chunksX = neededX;
+        chunksY = neededY;
+        tileChunks.assign(static_cast<size_t>(chunksX) * chunksY, TileChunk{RenderTexture2D{}, true, 0});
+        bakedCellPixels = cellPixels;
+        bakedDetail = detail;
+        bakedMapGeneration = map->GetLoadGeneration();
+        bakedTileChanges = map->GetTileChanges().size();
+        bakedFovCount = fieldOfView ? fieldOfView->GetComputeCount() : 0;
+        bakedFovOrigin = fieldOfView ? fieldOfView->GetOrigin() : Position(-1, -1);
+        return;
+    }
+
+    const std::vector<Position> &changes = map->GetTileChanges();
+    for (; bakedTileChanges < changes.size(); bakedTileChanges++) {
+        const Position &cell = changes[bakedTileChanges];
+        MarkChunksDirty(cell.x, cell.y, cell.x, cell.y);
+    }
+
+    // Sight and exploration only change within the radius around where the hero was and now is.
+    if (fieldOfView && fieldOfView->GetComputeCount() != bakedFovCount) {
+        const int radius = fieldOfView->GetRadius();
+        const Position &origin = fieldOfView->GetOrigin();
+        MarkChunksDirty(bakedFovOrigin.x - radius, bakedFovOrigin.y - radius,
+                        bakedFovOrigin.x + radius, bakedFovOrigin.y + radius);
+        MarkChunksDirty(origin.x - radius, origin.y - radius, origin.x + radius, origin.y + radius);
+
+        bakedFovCount = fieldOfView->GetComputeCount();
+        bakedFovOrigin = origin;
+    }
+}
+
+// Flags the chunks covering a cell rectangle for re-baking; parts outside the map are ignored.
+void MapRenderer::MarkChunksDirty(const int minX, const int minY, const int maxX, const int maxY) const {
+    if (maxX < 0 || maxY < 0) return;
+
+    const int firstX = std::max(0, minX) / CHUNK_CELLS;
+    const int firstY = std::max(0, minY) / CHUNK_CELLS;
+    const int lastX = std::min(chunksX - 1, maxX / CHUNK_CELLS);
+    const int lastY = std::min(chunksY - 1, maxY / CHUNK_CELLS);
+
+    for (int chunkY = firstY; chunkY <= lastY; chunkY++) {
+        for (int chunkX = firstX; chunkX <= lastX; chunkX++) {
+            tileChunks[chunkY * chunksX + chunkX].dirty = true;
+        }
+    }
+}
+
+// Draws one chunk's tiles into its render texture, fog tint included; unexplored cells stay transparent.
+// At the flat level of detail each cell is a plain quad in its minimap colour.
+void MapRenderer::BakeChunk(const int chunkX, const int chunkY) const {
+    TileChunk &chunk = tileChunks[chunkY * chunksX + chunkX];
+    if (chunk.target.id == 0) {
+        chunk.target = LoadRenderTexture(CHUNK_CELLS * bakedCellPixels, CHUNK_CELLS * bakedCellPixels);
+        if (chunk.target.id == 0) return; // Drawn as missing; retried next frame.
+        if (bakedDetail == TileDetail::TEXTURED) {
+            SetTextureFilter(chunk.target.texture, TEXTURE_FILTER_BILINEAR); // Smooth when drawn below bake size.
+        }
+        bakedChunks.push_back(chunkY * chunksX + chunkX);
+    }
+
+    const int endX = std::min(static_cast<int>(map->getWidth()), (chunkX + 1) * CHUNK_CELLS);
+    const int endY = std::min(static_cast<int>(map->getHeight()), (chunkY + 1) * CHUNK_CELLS);
+    const float tileSize = static_cast<float>(bakedCellPixels);
 
-    // Loop through all cells in the visible area.
-    for (int y = visibleArea.startY; y < visibleArea.endY; y++) {
-        for (int x = visibleArea.startX; x < visibleArea.endX; x++) {
-            const char cellType = map->getCell({x, y}); // Get the character representing the cell type.
-            Vector2 screenPos = WorldToScreen(x, y); // Convert world coordinates to screen coordinates.
-
-            //screenPos.y = GetMapArea().y + GetMapArea().height - screenPos.y - cellSize; // This line appears to be commented out or potentially for an inverted Y-axis.
-
-            // Draw different textures based on cell type.
-            switch (cellType) {
-                case '#':
-                    DrawTexturedTile(wallTexture, screenPos); // Draw wall.
-                    break;
-                case '.':
-                case 'H':
-                case 'M':
-                case 'B':
-                case 'T':
-                    DrawTexturedTile(floorTexture, screenPos); // Draw floor for empty spaces or where entities are.
-                    break;
-                default: ; // Do nothing for unknown cell types.
+    BeginTextureMode(chunk.target);
+    ClearBackground(BLANK);
+
+    for (int y = chunkY * CHUNK_CELLS; y < endY; y++) {
+        for (int x = chunkX * CHUNK_CELLS; x < endX; x++) {
+            if (!IsCellExplored(x, y)) continue; // Never seen: stays black under the fog.
+
+            const Vector2 localPos = {(x - chunkX * CHUNK_CELLS) * tileSize, (y - chunkY * CHUNK_CELLS) * tileSize};
+            const Color tint = IsCellInSight(x, y) ? WHITE : FOG_TINT; // Remembered cells are drawn dimmed.
+            if (bakedDetail == TileDetail::FLAT) {
+                DrawRectangleV(localPos, {tileSize, tileSize}, ColorTint(GetMinimapTileColor(x, y), tint));
+                continue;
             }
+
+            const SpriteId sprite = GetTileSprite(map->getCell({x, y}));
+            if (sprite == TextureAtlas::INVALID_SPRITE) continue;
+
+            DrawTexturedTile(sprite, localPos, tileSize, tint);
+        }
+    }
+
+    EndTextureMode();
+    chunk.dirty = false;
+}
+
+// Frees the render textures of the chunks seen longest ago until the baked ones fit the texture budget.
+// Chunks on screen this frame are never released, even if they alone exceed it.
+void MapRenderer::EvictTileChunks() const {
+    const size_t chunkPixels = static_cast<size_t>(CHUNK_CELLS) * bakedCellPixels;
+    const size_t chunkBytes = chunkPixels * chunkPixels * 4; // RGBA8 colour buffer.
+    const size_t maxChunks = std::max<size_t>(1, MAX_BAKED_CHUNK_BYTES / chunkBytes);
+    if (bakedChunks.size() <= maxChunks) return;
+
+    std::sort(bakedChunks.begin(), bakedChunks.end(), [this](const int a, const int b) {
+        return tileChunks[a].lastSeenFrame < tileChunks[b].lastSeenFrame;
+    });
+
+    size_t released = 0;
+    while (bakedChunks.size() - released > maxChunks) {
+        TileChunk &chunk = tileChunks[bakedChunks[released]];
+        if (chunk.lastSeenFrame == tileFrame) break; // Only on-screen chunks are left.
+
+        UnloadRenderTexture(chunk.target);
+        chunk.target = RenderTexture2D{};
+        released++;
+    }
+    bakedChunks.erase(bakedChunks.begin(), bakedChunks.begin() + static_cast<std::ptrdiff_t>(released));
+}
+
+// Frees every chunk's render texture; the next BakeVisibleChunks rebuilds the grid.
+void MapRenderer::ReleaseTileChunks() const {
+    for (const TileChunk &chunk: tileChunks) {
+        if (chunk.target.id != 0) {
+            UnloadRenderTexture(chunk.target);
         }
     }
+    tileChunks.clear();
+    bakedChunks.clear();
+}
+
+// Returns how many chunk blits and re-bakes the last frame's tile layer took.
+int MapRenderer::GetTileDrawCalls() const {
+    return tileDrawCalls;
 }
 
-// Draws all entities on the map (treasures, monsters, hero) if they are within the visible area.
+// Draws all entities on the map (treasures, monsters, hero) if they are within the visible area and in sight.
+// Treasures and monsters come from the map's spatial buckets under the visible area, so the cost follows what is
+// on screen rather than how many entities the level holds.
+// Every sprite comes from the atlas, so the whole pass batches into a single draw call.
 void MapRenderer::DrawEntities() const {
     if (!map || !heroPosition) return; // Requires map and hero position.
 
+    UpdateVisibleArea(); // Once per frame; the queries below only return entities inside it.
+    const int maxX = visibleArea.endX - 1;
+    const int maxY = visibleArea.endY - 1;
+
     // Draw treasures.
-    for (const auto &treasure: map->getTreasures()) {
-        if (IsInVisibleArea(treasure.getPosition().x, treasure.getPosition().y)) {
-            Vector2 screenPos = WorldToScreen(treasure.getPosition().x, treasure.getPosition().y);
-            const Rectangle destRect = {screenPos.x, screenPos.y, cellSize, cellSize};
-
-            //screenPos.y = GetMapArea().y + GetMapArea().height - screenPos.y - cellSize; // Similar commented line.
-
-            if (treasureTexture.id != 0) {
-                DrawTexturePro(
-                    treasureTexture,
-                    {0, 0, static_cast<float>(treasureTexture.width), static_cast<float>(treasureTexture.height)},
-                    destRect, {0, 0}, 0.0f, WHITE
-                );
-            }
+    const std::vector<Treasure> &treasures = map->getTreasuresConst();
+    visibleEntities.clear();
+    map->QueryTreasures(visibleArea.startX, visibleArea.startY, maxX, maxY, visibleEntities);
+    for (const size_t i: visibleEntities) {
+        const Position &treasurePos = treasures[i].getPosition();
+        if (IsCellInSight(treasurePos.x, treasurePos.y)) {
+            DrawSprite(treasureSprite, treasurePos);
         }
     }
 
     // Draw monsters (only if not defeated).
-    for (const auto &monster: map->getMonsters()) {
-        if (!monster.isDefeated() && IsInVisibleArea(monster.GetPosition().x, monster.GetPosition().y)) {
-            const Vector2 screenPos = WorldToScreen(monster.GetPosition().x, monster.GetPosition().y);
-            const Rectangle destRect = {screenPos.x, screenPos.y, cellSize, cellSize};
-
-            // Choose texture based on monster type (boss or regular).
-            const Texture *texture = (monster.GetType() == MonsterType::BOSS) ? &bossTexture : &monsterTexture;
-
-            if (texture->id != 0) {
-                DrawTexturePro(
-                    *texture,
-                    {0, 0, static_cast<float>(texture->width), static_cast<float>(texture->height)},
-                    destRect, {0, 0}, 0.0f, WHITE
-                );
-            }
+    const MonsterStore &monsters = map->getMonstersConst();
+    visibleEntities.clear();
+    monsters.QueryArea(visibleArea.startX, visibleArea.startY, maxX, maxY, visibleEntities);
+    for (const size_t i: visibleEntities) {
+        const Position &monsterPos = monsters.GetPosition(i);
+        if (monsters.IsAlive(i) && IsCellInSight(monsterPos.x, monsterPos.y)) {
+            // Choose sprite based on monster type (boss or regular).
+            DrawSprite(monsters.GetType(i) == MonsterType::BOSS ? bossSprite : monsterSprite, monsterPos);
         }
     }
 
     // Draw hero (always drawn on top of other entities).
     if (IsInVisibleArea(heroPosition->x, heroPosition->y)) {
-        Vector2 screenPos = WorldToScreen(heroPosition->x, heroPosition->y);
-        const Rectangle destRect = {screenPos.x, screenPos.y, cellSize, cellSize};
-
-        if (heroTexture.id != 0) {
-            DrawTexturePro(
-                heroTexture,
-                {0, 0, static_cast<float>(heroTexture.width), static_cast<float>(heroTexture.height)},
-                destRect, {0, 0}, 0.0f, WHITE
-            );
-        }
+        DrawSprite(heroSprite, *heroPosition);
     }
 }
 
-// Draws a small minimap in the corner of the screen, showing a portion of the map and entities.
+// Draws a small minimap in the corner of the screen: the cached level raster as one textured quad, plus the
+// main camera's viewport.
 void MapRenderer::DrawMinimap() const {
     if (!map || !heroPosition) return; // Requires map and hero position.
 
     constexpr float MINIMAP_SIZE = 200.0f; // Size of the minimap square.
     constexpr float MARGIN = 20.0f; // Margin from screen edges.
-    constexpr int MINIMAP_TILES = 15; // Number of tiles (cells) shown on each side of the minimap.
 
     // Calculate minimap's top-left screen position.
     const Vector2 minimapPos = {
@@ -345,14 +657,23 @@ void MapRenderer::DrawMinimap() const {
         screenHeight - MINIMAP_SIZE - MARGIN
     };
 
-    // Calculate individual cell size for the minimap.
-    const float cellSize = (MINIMAP_SIZE - 4) / MINIMAP_TILES; // Subtract 4 for a small internal border.
-
     DrawMinimapBackground(minimapPos, MINIMAP_SIZE); // Draw the minimap's background and border.
-    DrawMinimapTiles(minimapPos, MINIMAP_SIZE, cellSize); // Draw the map tiles on the minimap.
-    DrawMinimapEntities(minimapPos, MINIMAP_SIZE, cellSize);
-    // Draw entities (hero, monsters, treasures) on the minimap.
-    DrawMinimapViewport(minimapPos, MINIMAP_SIZE, cellSize); // Draw the main camera's viewport on the minimap.
+
+    SyncMinimap(); // Patch and upload whatever changed since the last frame.
+    if (minimap.texture.id == 0) return;
+
+    // Square texels, centred in the minimap; the window is square except for levels smaller than it.
+    const Rectangle window = GetMinimapWindow();
+    const float inner = MINIMAP_SIZE - 4; // Subtract 4 for a small internal border.
+    const float texel = inner / std::max(window.width, window.height);
+    const Rectangle dest = {
+        minimapPos.x + 2 + (inner - window.width * texel) * 0.5f,
+        minimapPos.y + 2 + (inner - window.height * texel) * 0.5f,
+        window.width * texel, window.height * texel
+    };
+
+    DrawTexturePro(minimap.texture, window, dest, {0, 0}, 0.0f, WHITE);
+    DrawMinimapViewport(dest, window); // Draw the main camera's viewport on the minimap.
 }
 
 // Draws the background rectangle and border for the minimap.
@@ -362,190 +683,214 @@ void MapRenderer::DrawMinimapBackground(const Vector2 pos, const float size) con
     DrawRectangleLinesEx({pos.x, pos.y, size, size}, 2, {100, 100, 150, 200}); // Blue-ish border.
 }
 
-// Draws the individual tiles (walls and floors) on the minimap.
-void MapRenderer::DrawMinimapTiles(const Vector2 pos, float size, const float cellSize) const {
-    const Vector2 offset = {pos.x + 2, pos.y + 2}; // Offset for internal drawing to account for border.
-    constexpr int MINIMAP_TILES = 15;
-    const int halfTiles = MINIMAP_TILES / 2;
-
-    // Calculate the world coordinates for the minimap's top-left corner, centered around the hero.
-    int minX = heroPosition->x - halfTiles;
-    int minY = heroPosition->y - halfTiles;
-    int maxX = minX + MINIMAP_TILES;
-    int maxY = minY + MINIMAP_TILES;
-
-    // Clamp the minimap's world boundaries to the actual map's boundaries.
-    // If clamping occurs, shift the entire minimap view to keep the same number of tiles.
-    if (minX < 0) {
-        maxX += -minX; // Shift right if left edge is out of bounds.
-        minX = 0;
-    }
-    if (minY < 0) {
-        maxY += -minY; // Shift down if top edge is out of bounds.
-        minY = 0;
-    }
-    if (maxX > static_cast<int>(map->getWidth())) {
-        minX -= (maxX - static_cast<int>(map->getWidth())); // Shift left if right edge is out of bounds.
-        maxX = static_cast<int>(map->getWidth());
-    }
-    if (maxY > static_cast<int>(map->getHeight())) {
-        minY -= (maxY - static_cast<int>(map->getHeight())); // Shift up if bottom edge is out of bounds.
-        maxY = static_cast<int>(map->getHeight());
-    }
-
-    // Ensure minX and minY don't go below 0 after any shifting.
-    minX = std::max(0, minX);
-    minY = std::max(0, minY);
-
-    // Iterate through the calculated minimap world area and draw tiles.
-    for (int worldY = minY; worldY < maxY; worldY++) {
-        for (int worldX = minX; worldX < maxX; worldX++) {
-            const char cellType = map->getCell({worldX, worldY}); // Get cell type from the map.
-
-            // Convert world coordinates to minimap's local screen coordinates.
-            const int minimapX = worldX - minX;
-            const int minimapY = worldY - minY;
-
-            const float cellX = offset.x + minimapX * cellSize;
-            const float cellY = offset.y + minimapY * cellSize;
-
-            Color cellColor = {0, 0, 0, 0}; // Default transparent color.
-
-            // Assign colors based on cell type.
-            switch (cellType) {
-                case '#':
-                    cellColor = {100, 100, 130, 255}; // Wall color.
-                    break;
-                case '.':
-                case 'H':
-                case 'M':
-                case 'B':
-                case 'T':
-                    cellColor = {50, 50, 70, 255}; // Floor color.
-                    break;
-            }
+// Returns the cells shown in the minimap, in texels of the raster.
+Rectangle MapRenderer::GetMinimapWindow() const {
+    constexpr int MINIMAP_TILES = 15; // Number of tiles (cells) shown on each side of the minimap.
+    const int mapWidth = static_cast<int>(map->getWidth());
+    const int mapHeight = static_cast<int>(map->getHeight());
 
-            if (cellColor.a > 0) {
-                // Only draw if color is not transparent.
-                DrawRectangle(cellX, cellY, cellSize, cellSize, cellColor);
-            }
-        }
+    if (minimap.overview) {
+        return {0, 0, static_cast<float>(mapWidth), static_cast<float>(mapHeight)};
     }
-}
 
-// Draws entities (treasures, monsters, hero) as colored dots on the minimap.
-void MapRenderer::DrawMinimapEntities(const Vector2 pos, float size, const float cellSize) const {
-    const Vector2 offset = {pos.x + 2, pos.y + 2};
-    constexpr int MINIMAP_TILES = 15;
-    const int halfTiles = MINIMAP_TILES / 2;
+    // Centred on the hero, shifted back inside the map at the edges so the same number of tiles stays visible.
+    const int tilesX = std::min(MINIMAP_TILES, mapWidth);
+    const int tilesY = std::min(MINIMAP_TILES, mapHeight);
+    const int minX = std::clamp(heroPosition->x - MINIMAP_TILES / 2, 0, mapWidth - tilesX);
+    const int minY = std::clamp(heroPosition->y - MINIMAP_TILES / 2, 0, mapHeight - tilesY);
 
-    // Recalculate minimap world bounds (same logic as for tiles).
-    int minX = heroPosition->x - halfTiles;
-    int minY = heroPosition->y - halfTiles;
-    int maxX = minX + MINIMAP_TILES;
-    int maxY = minY + MINIMAP_TILES;
+    return {
+        static_cast<float>(minX), static_cast<float>(minY), static_cast<float>(tilesX), static_cast<float>(tilesY)
+    };
+}
 
-    // Apply the same clamping and shifting logic as in DrawMinimapTiles.
-    if (minX < 0) {
-        maxX += -minX;
-        minX = 0;
-    }
-    if (minY < 0) {
-        maxY += -minY;
-        minY = 0;
-    }
-    if (maxX > static_cast<int>(map->getWidth())) {
-        minX -= (maxX - static_cast<int>(map->getWidth()));
-        maxX = static_cast<int>(map->getWidth());
-    }
-    if (maxY > static_cast<int>(map->getHeight())) {
-        minY -= (maxY - static_cast<int>(map->getHeight()));
-        maxY = static_cast<int>(map->getHeight());
+// Brings the raster up to date: a full rebuild on a new level, otherwise only changed cells, the fog around the
+// hero and the entity dots are repainted.
+void MapRenderer::SyncMinimap() const {
+    if (minimap.texture.id == 0 || minimap.mapGeneration != map->GetLoadGeneration() ||
+        minimap.width != static_cast<int>(map->getWidth()) || minimap.height != static_cast<int>(map->getHeight())) {
+        RebuildMinimap();
+        return;
     }
 
-    minX = std::max(0, minX);
-    minY = std::max(0, minY);
+    bool entitiesMoved = false;
 
-    // Draw treasures on the minimap if they are within its bounds.
-    for (const auto &treasure: map->getTreasures()) {
-        const int treasureX = treasure.getPosition().x;
-        const int treasureY = treasure.getPosition().y;
+    const std::vector<Position> &changes = map->GetTileChanges();
+    for (; minimap.tileChanges < changes.size(); minimap.tileChanges++) {
+        const Position &cell = changes[minimap.tileChanges];
+        SetMinimapPixel(cell.x, cell.y, GetMinimapTileColor(cell.x, cell.y));
+        entitiesMoved = true; // Defeated monsters leave their cell through setCell.
+    }
 
-        if (treasureX >= minX && treasureX < maxX && treasureY >= minY && treasureY < maxY) {
-            const float x = offset.x + (treasureX - minX) * cellSize;
-            const float y = offset.y + (treasureY - minY) * cellSize;
-            DrawRectangle(x, y, cellSize, cellSize, {220, 180, 50, 255}); // Gold-like color for treasures.
+    // Exploration only grows within sight of the hero, so only that square needs repainting.
+    if (fieldOfView && fieldOfView->GetComputeCount() != minimap.fovCount) {
+        const int radius = fieldOfView->GetRadius();
+        const Position &origin = fieldOfView->GetOrigin();
+        for (int y = std::max(0, origin.y - radius); y <= std::min(minimap.height - 1, origin.y + radius); y++) {
+            for (int x = std::max(0, origin.x - radius); x <= std::min(minimap.width - 1, origin.x + radius); x++) {
+                SetMinimapPixel(x, y, GetMinimapTileColor(x, y));
+            }
         }
-    }
 
-    // Draw monsters on the minimap if they are within bounds and not defeated.
-    for (const auto &monster: map->getMonsters()) {
-        if (!monster.isDefeated()) {
-            const int monsterX = monster.GetPosition().x;
-            const int monsterY = monster.GetPosition().y;
+        minimap.fovCount = fieldOfView->GetComputeCount();
+        entitiesMoved = true; // Monsters step right after the hero, and sight decides which dots show.
+    }
 
-            if (monsterX >= minX && monsterX < maxX && monsterY >= minY && monsterY < maxY) {
-                const float x = offset.x + (monsterX - minX) * cellSize;
-                const float y = offset.y + (monsterY - minY) * cellSize;
+    if (entitiesMoved || !(minimap.heroPos == *heroPosition) || minimap.treasureCount != map->GetTreasureCount()) {
+        PaintMinimapEntities();
+    }
 
-                // Different colors for boss monsters and regular monsters.
-                const Color color = (monster.GetType() == MonsterType::BOSS)
-                                        ? Color{200, 50, 50, 255} // Red for boss.
-                                        : Color{180, 80, 80, 255}; // Darker red for regular monster.
+    UploadMinimap();
+}
 
-                DrawRectangle(x, y, cellSize, cellSize, color);
-            }
+// Repaints every texel of a newly loaded level into a fresh texture.
+void MapRenderer::RebuildMinimap() const {
+    ReleaseMinimap();
+
+    minimap.width = static_cast<int>(map->getWidth());
+    minimap.height = static_cast<int>(map->getHeight());
+    minimap.mapGeneration = map->GetLoadGeneration();
+    minimap.tileChanges = map->GetTileChanges().size();
+    minimap.fovCount = fieldOfView ? fieldOfView->GetComputeCount() : 0;
+    if (minimap.width == 0 || minimap.height == 0) return;
+
+    minimap.pixels.resize(static_cast<size_t>(minimap.width) * minimap.height);
+    for (int y = 0; y < minimap.height; y++) {
+        for (int x = 0; x < minimap.width; x++) {
+            minimap.pixels[y * minimap.width + x] = GetMinimapTileColor(x, y);
         }
     }
+    minimap.entityCells.clear();
+
+    Image image = GenImageColor(minimap.width, minimap.height, BLANK);
+    minimap.texture = LoadTextureFromImage(image);
+    UnloadImage(image);
+
+    PaintMinimapEntities();
+    minimap.dirtyMinX = 0;
+    minimap.dirtyMinY = 0;
+    minimap.dirtyMaxX = minimap.width - 1;
+    minimap.dirtyMaxY = minimap.height - 1;
+    UploadMinimap();
+}
 
-    // Draw hero on the minimap (always visible since the minimap is centered on the hero).
-    const float heroX = offset.x + (heroPosition->x - minX) * cellSize;
-    const float heroY = offset.y + (heroPosition->y - minY) * cellSize;
-    DrawRectangle(heroX, heroY, cellSize, cellSize, {50, 150, 220, 255}); // Blue for hero.
+// Returns the colour of a cell's tile on the minimap; unexplored and unknown cells are transparent.
+Color MapRenderer::GetMinimapTileColor(const int x, const int y) const {
+    if (!IsCellExplored(x, y)) return {0, 0, 0, 0}; // Unexplored cells stay blank on the minimap too.
+
+    switch (map->getCell({x, y})) {
+        case '#':
+            return {100, 100, 130, 255}; // Wall color.
+        case '.':
+        case 'H':
+        case 'M':
+        case 'B':
+        case 'T':
+            return {50, 50, 70, 255}; // Floor color.
+        default:
+            return {0, 0, 0, 0};
+    }
 }
 
-// Draws a rectangle on the minimap representing the main camera's current viewport.
-void MapRenderer::DrawMinimapViewport(const Vector2 pos, float size, const float cellSize) const {
-    const Vector2 offset = {pos.x + 2, pos.y + 2};
-    constexpr int MINIMAP_TILES = 15;
-    const int halfTiles = MINIMAP_TILES / 2;
+// Writes one texel of the CPU raster and grows the rectangle to upload.
+void MapRenderer::SetMinimapPixel(const int x, const int y, const Color color) const {
+    if (x < 0 || y < 0 || x >= minimap.width || y >= minimap.height) return;
+
+    Color &pixel = minimap.pixels[y * minimap.width + x];
+    if (pixel.r == color.r && pixel.g == color.g && pixel.b == color.b && pixel.a == color.a) return;
 
-    // Recalculate minimap world bounds (same logic as for tiles).
-    int minX = heroPosition->x - halfTiles;
-    int minY = heroPosition->y - halfTiles;
-    int maxX = minX + MINIMAP_TILES;
-    int maxY = minY + MINIMAP_TILES;
+    pixel = color;
+    minimap.dirtyMinX = minimap.dirtyMinX > minimap.dirtyMaxX ? x : std::min(minimap.dirtyMinX, x);
+    minimap.dirtyMinY = minimap.dirtyMinY > minimap.dirtyMaxY ? y : std::min(minimap.dirtyMinY, y);
+    minimap.dirtyMaxX = std::max(minimap.dirtyMaxX, x);
+    minimap.dirtyMaxY = std::max(minimap.dirtyMaxY, y);
+}
 
-    // Apply clamping and shifting.
-    if (minX < 0) {
-        maxX += -minX;
-        minX = 0;
+// Puts the tiles back under last time's entity dots, then paints treasures, monsters and the hero where they are now.
+void MapRenderer::PaintMinimapEntities() const {
+    for (const int cell: minimap.entityCells) {
+        const int x = cell % minimap.width;
+        const int y = cell / minimap.width;
+        SetMinimapPixel(x, y, GetMinimapTileColor(x, y));
     }
-    if (minY < 0) {
-        maxY += -minY;
-        minY = 0;
+    minimap.entityCells.clear();
+
+    const auto paint = [this](const Position &pos, const Color color) {
+        if (pos.x < 0 || pos.y < 0 || pos.x >= minimap.width || pos.y >= minimap.height) return;
+        SetMinimapPixel(pos.x, pos.y, color);
+        minimap.entityCells.push_back(pos.y * minimap.width + pos.x);
+    };
+
+    // Treasures, if in sight.
+    for (const auto &treasure: map->getTreasures()) {
+        if (IsCellInSight(treasure.getPosition().x, treasure.getPosition().y)) {
+            paint(treasure.getPosition(), {220, 180, 50, 255}); // Gold-like color for treasures.
+        }
     }
-    if (maxX > static_cast<int>(map->getWidth())) {
-        minX -= (maxX - static_cast<int>(map->getWidth()));
-        maxX = static_cast<int>(map->getWidth());
+
+    // Monsters in sight and not defeated; different colors for boss monsters and regular monsters.
+    const MonsterStore &monsters = map->getMonstersConst();
+    for (size_t i = 0; i < monsters.Size(); i++) {
+        if (monsters.IsAlive(i) && IsCellInSight(monsters.GetPosition(i).x, monsters.GetPosition(i).y)) {
+            paint(monsters.GetPosition(i), monsters.GetType(i) == MonsterType::BOSS
+                                               ? Color{200, 50, 50, 255} // Red for boss.
+                                               : Color{180, 80, 80, 255}); // Darker red for regular monster.
+        }
     }
-    if (maxY > static_cast<int>(map->getHeight())) {
-        minY -= (maxY - static_cast<int>(map->getHeight()));
-        maxY = static_cast<int>(map->getHeight());
+
+    // Hero last, on top (always visible since the minimap follows the hero).
+    paint(*heroPosition, {50, 150, 220, 255});
+
+    minimap.heroPos = *heroPosition;
+    minimap.treasureCount = map->GetTreasureCount();
+}
+
+// Sends the changed rectangle of the raster to the texture, if anything changed.
+void MapRenderer::UploadMinimap() const {
+    if (minimap.dirtyMinX > minimap.dirtyMaxX || minimap.texture.id == 0) return;
+
+    const int width = minimap.dirtyMaxX - minimap.dirtyMinX + 1;
+    const int height = minimap.dirtyMaxY - minimap.dirtyMinY + 1;
+    minimap.uploadBuffer.resize(static_cast<size_t>(width) * height);
+    for (int y = 0; y < height; y++) {
+        const Color *row = &minimap.pixels[(minimap.dirtyMinY + y) * minimap.width + minimap.dirtyMinX];
+        std::copy(row, row + width, minimap.uploadBuffer.begin() + y * width);
     }
 
-    minX = std::max(0, minX);
-    minY = std::max(0, minY);
+    UpdateTextureRec(minimap.texture,
+                     {
+                         static_cast<float>(minimap.dirtyMinX), static_cast<float>(minimap.dirtyMinY),
+                         static_cast<float>(width), static_cast<float>(height)
+                     },
+                     minimap.uploadBuffer.data());
+
+    minimap.dirtyMinX = 0;
+    minimap.dirtyMinY = 0;
+    minimap.dirtyMaxX = -1;
+    minimap.dirtyMaxY = -1;
+}
+
+// Frees the raster's texture; the next draw rebuilds it.
+void MapRenderer::ReleaseMinimap() const {
+    if (minimap.texture.id != 0) {
+        UnloadTexture(minimap.texture);
+        minimap.texture = Texture2D{};
+    }
+}
+
+// Draws a rectangle on the minimap representing the main camera's current viewport.
+void MapRenderer::DrawMinimapViewport(const Rectangle dest, const Rectangle window) const {
+    const float texel = dest.width / window.width;
 
     // Calculate viewport's screen position and size relative to the minimap.
-    const float viewX = offset.x + (camera.position.x - minX) * cellSize;
-    const float viewY = offset.y + (camera.position.y - minY) * cellSize;
-    const float viewWidth = camera.visibleCellsX * cellSize;
-    const float viewHeight = camera.visibleCellsY * cellSize;
+    const float viewX = dest.x + (camera.position.x - window.x) * texel;
+    const float viewY = dest.y + (camera.position.y - window.y) * texel;
+    const float viewWidth = GetViewCells().x * texel;
+    const float viewHeight = GetViewCells().y * texel;
 
     // Only draw the viewport rectangle if it's within the minimap's visible area.
-    if (viewX + viewWidth > offset.x && viewX < offset.x + MINIMAP_TILES * cellSize &&
-        viewY + viewHeight > offset.y && viewY < offset.y + MINIMAP_TILES * cellSize) {
+    if (viewX + viewWidth > dest.x && viewX < dest.x + dest.width &&
+        viewY + viewHeight > dest.y && viewY < dest.y + dest.height) {
         DrawRectangleLinesEx(
             {viewX, viewY, viewWidth, viewHeight},
             1, {220, 220, 255, 200} // Light blue-ish border for the viewport.
@@ -553,30 +898,58 @@ void MapRenderer::DrawMinimapViewport(const Vector2 pos, float size, const float
     }
 }
 
+// Switches the minimap between the hero's surroundings and the whole level; both use the same raster.
+void MapRenderer::ToggleMinimapOverview() {
+    minimap.overview = !minimap.overview;
+}
+
+// Returns whether the minimap shows the whole level.
+bool MapRenderer::IsMinimapOverview() const {
+    return minimap.overview;
+}
+
 // Returns the current size (in pixels) of a single map cell.
 float MapRenderer::GetCellSize() const {
     return cellSize;
 }
 
-// Sets the size (in pixels) of a single map cell, clamping it to a reasonable range.
-// Also triggers a visible area update.
+// Sets the size (in pixels) of a single map cell, between the whole-level view and MAX_CELL_SIZE.
+// The view stays centred on the same point and the camera jumps there, so a zoom needs no glide.
 void MapRenderer::SetCellSize(const float size) {
-    cellSize = std::max(10.0f, std::min(size, 100.0f)); // Clamp between 10 and 100.
+    const Vector2 oldCells = GetViewCells();
+    const Vector2 center = {camera.current.x + oldCells.x * 0.5f, camera.current.y + oldCells.y * 0.5f};
+
+    cellSize = std::clamp(size, GetMinCellSize(), MAX_CELL_SIZE);
+    const Vector2 viewCells = GetViewCells();
+    camera.visibleCellsX = static_cast<int>(std::ceil(viewCells.x));
+    camera.visibleCellsY = static_cast<int>(std::ceil(viewCells.y));
+
+    camera.current = ClampCamera({center.x - viewCells.x * 0.5f, center.y - viewCells.y * 0.5f});
+    camera.previous = camera.current;
+    camera.position = camera.current;
     visibleArea.needsUpdate = true; // Mark visible area for recalculation.
 }
 
+// Zooms by a number of mouse wheel steps.
+void MapRenderer::Zoom(const float steps) {
+    SetCellSize(cellSize * std::pow(ZOOM_STEP, steps));
+}
+
 // Sets the number of cells visible horizontally and vertically in the main map view.
 // Also triggers a visible area update and recenters the camera.
 void MapRenderer::SetVisibleRange(const int cellsX, const int cellsY) {
     camera.visibleCellsX = std::max(5, cellsX); // Ensure minimum 5 visible cells.
     camera.visibleCellsY = std::max(5, cellsY); // Ensure minimum 5 visible cells.
+    camera.viewWidth = camera.visibleCellsX * cellSize; // The map area grows or shrinks to fit them.
+    camera.viewHeight = camera.visibleCellsY * cellSize;
     visibleArea.needsUpdate = true; // Mark visible area for recalculation.
 
     // Recenter the camera immediately after changing the visible range.
     if (heroPosition) {
+        const Vector2 viewCells = GetViewCells();
         camera.target = {
-            static_cast<float>(heroPosition->x) - camera.visibleCellsX * 0.5f,
-            static_cast<float>(heroPosition->y) - camera.visibleCellsY * 0.5f
+            static_cast<float>(heroPosition->x) - viewCells.x * 0.5f,
+            static_cast<float>(heroPosition->y) - viewCells.y * 0.5f
         };
     }
 }
@@ -585,18 +958,8 @@ void MapRenderer::SetVisibleRange(const int cellsX, const int cellsY) {
 // It's effectively redrawing the background at the monster's previous location,
 // which is a common technique for clearing entities in tile-based rendering without true "removal"
 // from a dynamic list in the renderer itself.
-void MapRenderer::removeMonster(const Monster *monster) {
-    const Vector2 screenPos = WorldToScreen(monster->GetPosition().x, monster->GetPosition().y);
-    const Rectangle destRect = {screenPos.x, screenPos.y, cellSize, cellSize};
-
-    const Texture *texture = &floorTexture; // Use the floor texture to cover the monster.
-
-    if (texture->id != 0) {
-        // Ensure the floor texture is loaded.
-        DrawTexturePro(
-            *texture,
-            {0, 0, static_cast<float>(texture->width), static_cast<float>(texture->height)},
-            destRect, {0, 0}, 0.0f, WHITE
-        );
-    }
+void MapRenderer::removeMonster(const Position &monsterPos) {
+    if (!atlas) return;
+
+    DrawSprite(floorSprite, monsterPos); // Use the floor sprite to cover the monster.
 }
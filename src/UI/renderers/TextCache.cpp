@@ -0,0 +1,132 @@
+#include "C:/DandD/include/UI/renderers/TextCache.h"
+#include <algorithm>
+#include <iterator>
+
+namespace {
+    // FNV-1a over the text and everything else that changes the layout
+    uint64_t hashKey(const unsigned int fontTexture, const int fontBaseSize, const float fontSize,
+                     const float spacing, const std::string_view text) {
+        uint64_t hash = 1469598103934665603ull;
+        const auto mix = [&hash](const void *data, const size_t size) {
+            const auto *bytes = static_cast<const unsigned char *>(data);
+            for (size_t i = 0; i < size; i++) {
+                hash = (hash ^ bytes[i]) * 1099511628211ull;
+            }
+        };
+
+        mix(&fontTexture, sizeof(fontTexture));
+        mix(&fontBaseSize, sizeof(fontBaseSize));
+        mix(&fontSize, sizeof(fontSize));
+        mix(&spacing, sizeof(spacing));
+        mix(text.data(), text.size());
+        return hash;
+    }
+}
+
+Vector2 TextCache::Measure(const Font &font, const std::string_view text, const float fontSize, const float spacing) {
+    return Find(font, text, fontSize, spacing).size;
+}
+
+void TextCache::Draw(const Font &font, const std::string_view text, const Vector2 position, const float fontSize,
+                     const float spacing, const Color tint) {
+    const Entry &entry = Find(font, text, fontSize, spacing);
+    if (!entry.drawable) {
+        DrawTextEx(font, entry.text.c_str(), position, fontSize, spacing, tint);
+        return;
+    }
+
+    for (const GlyphQuad &quad: entry.quads) {
+        const Rectangle dest = {
+            position.x + quad.dest.x, position.y + quad.dest.y, quad.dest.width, quad.dest.height
+        };
+        DrawTexturePro(font.texture, quad.source, dest, {0, 0}, 0.0f, tint);
+    }
+}
+
+void TextCache::Clear() {
+    index.clear();
+    entries.clear();
+}
+
+size_t TextCache::Size() {
+    return entries.size();
+}
+
+const TextCache::Entry &TextCache::Find(const Font &font, const std::string_view text, const float fontSize,
+                                        const float spacing) {
+    const uint64_t key = hashKey(font.texture.id, font.baseSize, fontSize, spacing, text);
+
+    const auto found = index.find(key);
+    if (found != index.end()) {
+        Entry &entry = *found->second;
+        entries.splice(entries.begin(), entries, found->second); // Now the most recently used
+
+        // A hash collision is laid out again in place; the loser is simply no longer cached
+        if (entry.fontTexture != font.texture.id || entry.fontBaseSize != font.baseSize ||
+            entry.fontSize != fontSize || entry.spacing != spacing || entry.text != text) {
+            entry.fontTexture = font.texture.id;
+            entry.fontBaseSize = font.baseSize;
+            entry.fontSize = fontSize;
+            entry.spacing = spacing;
+            entry.text.assign(text.data(), text.size());
+            Layout(font, entry);
+        }
+        return entry;
+    }
+
+    // Reuse the least recently used entry's storage once full
+    if (entries.size() >= CAPACITY) {
+        index.erase(entries.back().key);
+        entries.splice(entries.begin(), entries, std::prev(entries.end()));
+    } else {
+        entries.emplace_front();
+    }
+
+    Entry &entry = entries.front();
+    entry.key = key;
+    entry.fontTexture = font.texture.id;
+    entry.fontBaseSize = font.baseSize;
+    entry.fontSize = fontSize;
+    entry.spacing = spacing;
+    entry.text.assign(text.data(), text.size());
+    Layout(font, entry);
+
+    index[key] = entries.begin();
+    return entry;
+}
+
+void TextCache::Layout(const Font &font, Entry &entry) {
+    entry.size = MeasureTextEx(font, entry.text.c_str(), entry.fontSize, entry.spacing);
+    entry.quads.clear();
+
+    // Line breaks follow raylib's global line spacing, which can change at any time; leave those to DrawTextEx
+    entry.drawable = entry.text.find('\n') == std::string::npos && font.texture.id != 0 && font.baseSize > 0;
+    if (!entry.drawable) return;
+
+    // The same walk as DrawTextEx and DrawTextCodepoint, recorded instead of drawn
+    const float scale = entry.fontSize / static_cast<float>(font.baseSize);
+    const float padding = static_cast<float>(font.glyphPadding);
+    float offsetX = 0.0f;
+
+    for (size_t i = 0; i < entry.text.size();) {
+        int codepointSize = 0;
+        const int codepoint = GetCodepointNext(entry.text.c_str() + i, &codepointSize);
+        const int glyph = GetGlyphIndex(font, codepoint);
+        const Rectangle &rec = font.recs[glyph];
+
+        if (codepoint != ' ' && codepoint != '\t') {
+            entry.quads.push_back({
+                {rec.x - padding, rec.y - padding, rec.width + 2.0f * padding, rec.height + 2.0f * padding},
+                {
+                    offsetX + (font.glyphs[glyph].offsetX - padding) * scale,
+                    (font.glyphs[glyph].offsetY - padding) * scale,
+                    (rec.width + 2.0f * padding) * scale, (rec.height + 2.0f * padding) * scale
+                }
+            });
+        }
+
+        offsetX += (font.glyphs[glyph].advanceX == 0 ? rec.width : static_cast<float>(font.glyphs[glyph].advanceX))
+                * scale + entry.spacing;
+        i += std::max(1, codepointSize);
+    }
+}
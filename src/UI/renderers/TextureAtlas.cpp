@@ -0,0 +1,169 @@
+#include "C:/DandD/include/UI/renderers/TextureAtlas.h"
+#include "C:/DandD/include/UI/managers/ResourceManager.h"
+#include "rlgl.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+
+TextureAtlas::TextureAtlas()
+    : texture{},
+      whiteSprite(INVALID_SPRITE),
+      built(false) {
+}
+
+TextureAtlas::~TextureAtlas() {
+    Unload();
+}
+
+SpriteId TextureAtlas::Add(const std::string &filePath) {
+    if (built) {
+        throw std::runtime_error("Texture atlas is already built: " + filePath);
+    }
+    if (sprites.size() >= INVALID_SPRITE - 1) {
+        throw std::runtime_error("Texture atlas is full: " + filePath);
+    }
+
+    // Decoded, converted and scaled on the worker pool while the rest of startup carries on
+    std::future<Image> decoded = ResourceManager::DecodeAsync([filePath] {
+        Image image = LoadImage(filePath.c_str());
+        if (image.data) {
+            ImageFormat(&image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+
+            // Keep the aspect ratio while fitting the size cap
+            const int largest = std::max(image.width, image.height);
+            if (largest > MAX_SPRITE_SIZE) {
+                const float scale = static_cast<float>(MAX_SPRITE_SIZE) / static_cast<float>(largest);
+                ImageResize(&image, std::max(1, static_cast<int>(std::lround(image.width * scale))),
+                            std::max(1, static_cast<int>(std::lround(image.height * scale))));
+            }
+        }
+        return image;
+    });
+
+    sprites.push_back({Image{}, {0, 0, 0, 0}, std::move(decoded)});
+    return static_cast<SpriteId>(sprites.size() - 1);
+}
+
+void TextureAtlas::Build() {
+    if (built) return;
+
+    // Waits for any decode still running
+    for (Sprite &sprite: sprites) {
+        if (sprite.decoded.valid()) {
+            sprite.image = sprite.decoded.get();
+        }
+    }
+
+    // A small white square whose middle texel serves shape drawing
+    whiteSprite = static_cast<SpriteId>(sprites.size());
+    sprites.push_back({GenImageColor(4, 4, WHITE), {0, 0, 0, 0}, {}});
+
+    // Tallest first keeps the shelves tight
+    std::vector<size_t> order;
+    long long area = 0;
+    int widest = 0;
+    for (size_t i = 0; i < sprites.size(); i++) {
+        if (!sprites[i].image.data) continue;
+        order.push_back(i);
+        area += static_cast<long long>(sprites[i].image.width + PADDING) * (sprites[i].image.height + PADDING);
+        widest = std::max(widest, sprites[i].image.width + PADDING * 2);
+    }
+    std::sort(order.begin(), order.end(), [this](const size_t a, const size_t b) {
+        return sprites[a].image.height > sprites[b].image.height;
+    });
+
+    // Roughly square, at least as wide as the widest sprite
+    int atlasWidth = 64;
+    while (atlasWidth < widest || static_cast<long long>(atlasWidth) * atlasWidth < area) {
+        atlasWidth *= 2;
+    }
+
+    // Place along shelves, a new shelf whenever the row is full
+    int x = PADDING;
+    int y = PADDING;
+    int shelfHeight = 0;
+    for (const size_t index: order) {
+        const Image &image = sprites[index].image;
+        if (x + image.width + PADDING > atlasWidth) {
+            x = PADDING;
+            y += shelfHeight + PADDING;
+            shelfHeight = 0;
+        }
+
+        sprites[index].source = {
+            static_cast<float>(x), static_cast<float>(y), static_cast<float>(image.width),
+            static_cast<float>(image.height)
+        };
+        x += image.width + PADDING;
+        shelfHeight = std::max(shelfHeight, image.height);
+    }
+    const int atlasHeight = y + shelfHeight + PADDING;
+
+    Image atlasImage = GenImageColor(atlasWidth, atlasHeight, BLANK);
+    for (Sprite &sprite: sprites) {
+        if (!sprite.image.data) continue;
+
+        const Rectangle whole = {
+            0, 0, static_cast<float>(sprite.image.width), static_cast<float>(sprite.image.height)
+        };
+        ImageDraw(&atlasImage, sprite.image, whole, sprite.source, WHITE);
+        UnloadImage(sprite.image);
+        sprite.image = Image{};
+    }
+
+    texture = LoadTextureFromImage(atlasImage);
+    UnloadImage(atlasImage);
+    built = true;
+}
+
+void TextureAtlas::Unload() {
+    for (Sprite &sprite: sprites) {
+        if (sprite.decoded.valid()) {
+            UnloadImage(sprite.decoded.get());
+        }
+        if (sprite.image.data) {
+            UnloadImage(sprite.image);
+        }
+    }
+    sprites.clear();
+
+    if (texture.id != 0) {
+        // Shapes may still point at the atlas; hand them back raylib's own white texel first
+        const Texture2D defaultTexture = {rlGetTextureIdDefault(), 1, 1, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8};
+        SetShapesTexture(defaultTexture, {0, 0, 1, 1});
+
+        UnloadTexture(texture);
+        texture = Texture2D{};
+    }
+
+    whiteSprite = INVALID_SPRITE;
+    built = false;
+}
+
+void TextureAtlas::UseForShapes() const {
+    if (!IsValid(whiteSprite)) return;
+
+    const Rectangle &white = sprites[whiteSprite].source;
+    SetShapesTexture(texture, {white.x + 1, white.y + 1, 1, 1});
+}
+
+void TextureAtlas::Draw(const SpriteId sprite, const Rectangle dest, const Color tint) const {
+    if (!IsValid(sprite)) return;
+
+    DrawTexturePro(texture, sprites[sprite].source, dest, {0, 0}, 0.0f, tint);
+}
+
+bool TextureAtlas::IsDecoded() const {
+    return std::all_of(sprites.begin(), sprites.end(), [](const Sprite &sprite) {
+        return !sprite.decoded.valid() || sprite.decoded.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    });
+}
+
+bool TextureAtlas::IsValid(const SpriteId sprite) const {
+    return built && sprite < sprites.size() && sprites[sprite].source.width > 0;
+}
+
+Rectangle TextureAtlas::GetSource(const SpriteId sprite) const {
+    return IsValid(sprite) ? sprites[sprite].source : Rectangle{0, 0, 0, 0};
+}
@@ -3,6 +3,8 @@
 //
 
 #include "C:/DandD/include/UI/screens/GameHUD.h"
+#include "C:/DandD/include/UI/managers/ResourceManager.h"
+#include "C:/DandD/include/UI/renderers/TextCache.h"
 #include <cmath>
 #include <iomanip>
 
@@ -16,7 +18,11 @@ GameHUD::GameHUD(const int _screenWidth, const int _screenHeight)
       currentLevel(1),
       monstersRemaining(0),
       treasuresRemaining(0),
-      backgroundLoaded(false) {
+      shownStatsVersion(0),
+      statsTextValid(false),
+      levelText("LEVEL 1"),
+      monstersText("Current number of monsters: 0"),
+      treasuresText("Current number of treasures: 0") {
     // Define UI colors
     frameColor = {40, 40, 70, 230};
     textColor = {220, 220, 250, 255};
@@ -93,6 +99,7 @@ GameHUD::~GameHUD() {
 // Initializes the GameHUD with a reference to the hero object
 void GameHUD::Initialize(Hero *heroRef) {
     hero = heroRef;
+    statsTextValid = false; // Possibly a different hero, whose versions mean nothing here
 
     // Set initial active state of equipment buttons based on whether an item is equipped
     armorButton.SetActive(armorItem != nullptr);
@@ -120,37 +127,65 @@ void GameHUD::SetSpell(const Spell *spell) {
 
 // Sets the current level
 void GameHUD::SetLevel(const int level) {
+    if (level == currentLevel) return;
+
     currentLevel = level;
+    levelText = "LEVEL " + std::to_string(currentLevel);
 }
 
 // Sets the count of remaining monsters
 void GameHUD::SetMonstersRemaining(const int count) {
+    if (count == monstersRemaining) return;
+
     monstersRemaining = count;
+    monstersText = "Current number of monsters: " + std::to_string(monstersRemaining);
 }
 
 // Sets the count of remaining treasures
 void GameHUD::SetTreasuresRemaining(const int count) {
+    if (count == treasuresRemaining) return;
+
     treasuresRemaining = count;
+    treasuresText = "Current number of treasures: " + std::to_string(treasuresRemaining);
+}
+
+// Queues the HUD's icons in the shared atlas
+void GameHUD::RegisterSprites(TextureAtlas &atlasRef) {
+    atlas = &atlasRef;
+
+    frameSprite = atlasRef.Add("C:/DandD/assets/border/testFrame.png"); // Frame
+    armorIconSprite = atlasRef.Add("C:/DandD/assets/equipment/testArmor.png"); // Armor icon
+    weaponIconSprite = atlasRef.Add("C:/DandD/assets/equipment/testWeapon.png"); // Weapon icon
+    spellIconSprite = atlasRef.Add("C:/DandD/assets/equipment/testSpell.png"); // Spell icon
 }
 
 // Loads necessary textures and fonts for the HUD
 void GameHUD::LoadResources() {
-    hudFont = LoadFont("C:/DandD/assets/fonts/.TTF"); // Loads the HUD font
+    hudFont = ResourceManager::AcquireFont("C:/DandD/assets/fonts/.TTF"); // Shares the map's font
 
-    hudTexture = LoadTexture("C:/DandD/assets/background/walls4"); // Loads background texture
-    frameTexture = LoadTexture("C:/DandD/assets/border/testFrame.png"); // Loads frame texture
-    armorIconTexture = LoadTexture("C:/DandD/assets/equipment/testArmor.png"); // Loads armor icon
-    weaponIconTexture = LoadTexture("C:/DandD/assets/equipment/testWeapon.png"); // Loads weapon icon
-    spellIconTexture = LoadTexture("C:/DandD/assets/equipment/testSpell.png"); // Loads spell icon
+    // Shares the menu's background; the manager finds walls4.png from the bare name
+    hudTexture = &ResourceManager::AcquireTexture("C:/DandD/assets/background/walls4");
 
     // Set font for HP and XP bars
     hpBar.SetFont(hudFont, 21, textColor);
     xpBar.SetFont(hudFont, 21, textColor);
 
-    // Set textures for equipment buttons
-    armorButton.SetTexture(armorIconTexture);
-    weaponButton.SetTexture(weaponIconTexture);
-    spellButton.SetTexture(spellIconTexture);
+    ApplyButtonSprites();
+}
+
+// Points the equipment buttons at their atlas sprites and rounds their corners
+void GameHUD::ApplyButtonSprites() {
+    if (atlas) {
+        // A missing icon leaves its button untextured, as a failed load did before
+        const auto applySprite = [this](Button &button, const SpriteId sprite) {
+            if (atlas->IsValid(sprite)) {
+                button.SetTexture(atlas->GetTexture(), atlas->GetSource(sprite));
+            }
+        };
+        applySprite(armorButton, armorIconSprite);
+        applySprite(weaponButton, weaponIconSprite);
+        applySprite(spellButton, spellIconSprite);
+    }
 
     // Set rounded corners for equipment buttons
     float cornerRadius = 0.3f;
@@ -178,8 +213,11 @@ void GameHUD::Update(const float deltaTime) {
         armorButton = Button(CalculateArmorButtonBounds(), "", nullptr);
         weaponButton = Button(CalculateWeaponButtonBounds(), "", nullptr);
         spellButton = Button(CalculateSpellButtonBounds(), "", nullptr);
+        ApplyButtonSprites(); // New buttons start without their icons
     }
 
+    RefreshStatsText();
+
     // Update HP bar with hero's current health and set max health
     hpBar.Update(hero->GetHealth(), deltaTime);
     hpBar.SetMaxValue(hero->GetMaxHealth());
@@ -208,13 +246,16 @@ void GameHUD::Update(const float deltaTime) {
 }
 
 // Draws all HUD elements
+bool GameHUD::IsTransitioning() const {
+    return hpBar.IsTransitioning() || xpBar.IsTransitioning();
+}
+
 void GameHUD::Draw() const {
     if (!hero) return; // If no hero, do nothing
 
     ClearBackground(darkPurple); // Clear background with a dark purple color
 
-    if (backgroundLoaded)
-        DrawBackground(); // Draw background if loaded
+    DrawBackground(); // Draw background once it is loaded
 
     DrawFrame(); // Draw the HUD frame
     DrawStats(); // Draw hero stats
@@ -226,12 +267,12 @@ void GameHUD::Draw() const {
 
 // Draws the background texture for the HUD
 void GameHUD::DrawBackground() const {
-    if (!backgroundLoaded) return; // Only draw if background is loaded
+    if (!hudTexture || hudTexture->id == 0) return; // Only draw if background is loaded
 
     const Rectangle backgroundRect = {0, 0, static_cast<float>(screenWidth), static_cast<float>(screenHeight)};
     DrawTexturePro(
-        hudTexture,
-        {0, 0, static_cast<float>(hudTexture.width), static_cast<float>(hudTexture.height)}, // Source rectangle
+        *hudTexture,
+        {0, 0, static_cast<float>(hudTexture->width), static_cast<float>(hudTexture->height)}, // Source rectangle
         {0, 0, static_cast<float>(screenWidth), static_cast<float>(screenHeight)}, // Destination rectangle
         {0, 0}, // Origin for rotation
         0.0f, // Rotation
@@ -241,16 +282,13 @@ void GameHUD::DrawBackground() const {
 
 // Unloads all loaded textures and fonts
 void GameHUD::Unload() {
-    UnloadFont(hudFont); // Unload HUD font
-    UnloadTexture(frameTexture); // Unload frame texture
-    UnloadTexture(characterIconTexture); // Unload character icon (might be a placeholder, not used in code)
-    UnloadTexture(armorIconTexture); // Unload armor icon
-    UnloadTexture(weaponIconTexture); // Unload weapon icon
-    UnloadTexture(spellIconTexture); // Unload spell icon
-
-    if (backgroundLoaded) {
-        UnloadTexture(hudTexture); // Unload background texture if it was loaded
-        backgroundLoaded = false;
+    ResourceManager::ReleaseFont(hudFont); // Release HUD font
+    hudFont = Font{};
+    // Icons live in the atlas, which is unloaded by its owner
+
+    if (hudTexture) {
+        ResourceManager::ReleaseTexture(*hudTexture); // Release background texture if it was acquired
+        hudTexture = nullptr;
     }
 }
 
@@ -278,18 +316,18 @@ void GameHUD::DrawFrame() const {
 void DrawStatWithGlow(const Font &font, const char *label, const char *value,
                       const Vector2 position, const Color textColor, const Color valueColor) {
     // Draw the main text for the label
-    DrawTextEx(font, label, position, 24, 1, textColor);
+    TextCache::Draw(font, label, position, 24, 1, textColor);
     // Draw a slightly offset, more transparent version for the glow
-    DrawTextEx(font, label, {position.x - 1.5f, position.y + 1.5f}, 24, 1,
+    TextCache::Draw(font, label, {position.x - 1.5f, position.y + 1.5f}, 24, 1,
                {textColor.r, textColor.g, textColor.b, 100});
 
     // Calculate position for the value text
     const Vector2 valuePos = {position.x + (label == "Strength:" ? 110 : 67), position.y};
     // Draw the main text for the value
-    DrawTextEx(font, value, {valuePos.x - 1.5f, valuePos.y + 1.5f}, 24, 1,
+    TextCache::Draw(font, value, {valuePos.x - 1.5f, valuePos.y + 1.5f}, 24, 1,
                {valueColor.r, valueColor.g, valueColor.b, 100});
     // Draw a slightly offset, more transparent version for the glow
-    DrawTextEx(font, value, valuePos, 24, 1, valueColor);
+    TextCache::Draw(font, value, valuePos, 24, 1, valueColor);
 }
 
 // Draws the hero's strength and mana stats
@@ -301,15 +339,27 @@ void GameHUD::DrawStats() const {
     };
 
     // Draw Strength stat
-    DrawStatWithGlow(hudFont, "Strength:", std::to_string(hero->GetStrength()).c_str(),
+    DrawStatWithGlow(hudFont, "Strength:", strengthText.c_str(),
                      basePos, textColor, {220, 220, 100, 255});
 
     // Draw Mana stat, positioned relative to Strength
     const Vector2 manaPos = {basePos.x + hpBar.GetBounds().width / 2 + 55, basePos.y};
-    DrawStatWithGlow(hudFont, "Mana:", std::to_string(hero->GetMana()).c_str(),
+    DrawStatWithGlow(hudFont, "Mana:", manaText.c_str(),
                      manaPos, textColor, {120, 180, 255, 255});
 }
 
+// Rebuilds the stat texts if the hero's stats changed since they were last formatted
+void GameHUD::RefreshStatsText() {
+    const uint32_t version = hero->GetStatsVersion();
+    if (statsTextValid && version == shownStatsVersion) return;
+
+    const HeroStats &stats = hero->GetStats();
+    strengthText = std::to_string(stats.strength);
+    manaText = std::to_string(stats.mana);
+    shownStatsVersion = version;
+    statsTextValid = true;
+}
+
 // Draws the inventory equipment buttons and their tooltips
 void GameHUD::DrawInventory() const {
     armorButton.Draw(); // Draw armor button
@@ -342,38 +392,32 @@ void GameHUD::DrawLevelInfo() const {
     const float startY = 18; // Y-coordinate for level info
     const float lineHeight = 30; // Vertical spacing between lines
 
-    const std::string levelText = "LEVEL " + std::to_string(currentLevel);
-
     // Draw LEVEL text with a glow effect
-    DrawTextEx(hudFont, levelText.c_str(),
+    TextCache::Draw(hudFont, levelText.c_str(),
                {startX, startY},
                fontSize + 2, 2,
                {255, 255, 150, 255});
-    DrawTextEx(hudFont, levelText.c_str(),
+    TextCache::Draw(hudFont, levelText.c_str(),
                {startX - 1.5f, startY + 1.5f},
                fontSize + 2, 2,
                {255, 255, 150, 100});
 
-    const std::string monstersText = "Current number of monsters: " + std::to_string(monstersRemaining);
-
     // Draw monsters remaining text with a glow effect
-    DrawTextEx(hudFont, monstersText.c_str(),
+    TextCache::Draw(hudFont, monstersText.c_str(),
                {startX - 110, startY + lineHeight},
                fontSize, 1,
                {220, 100, 100, 255});
-    DrawTextEx(hudFont, monstersText.c_str(),
+    TextCache::Draw(hudFont, monstersText.c_str(),
                {startX - 110 - 1.5f, startY + lineHeight + 1.5f},
                fontSize, 1,
                {220, 100, 100, 100});
 
-    const std::string treasuresText = "Current number of treasures: " + std::to_string(treasuresRemaining);
-
     // Draw treasures remaining text with a glow effect
-    DrawTextEx(hudFont, treasuresText.c_str(),
+    TextCache::Draw(hudFont, treasuresText.c_str(),
                {startX - 118, startY + lineHeight * 2},
                fontSize, 1,
                {220, 100, 100, 255});
-    DrawTextEx(hudFont, treasuresText.c_str(),
+    TextCache::Draw(hudFont, treasuresText.c_str(),
                {startX - 118 - 1.5f, startY + lineHeight * 2 + 1.5f},
                fontSize, 1,
                {220, 100, 100, 100});
@@ -446,32 +490,32 @@ void GameHUD::DrawItemTooltip(const char *name, int level, const char *bonus, Re
 
     // Draw each line of the item name
     for (const auto &line: nameLines) {
-        const float textWidth = MeasureTextEx(hudFont, line.c_str(), 24, 1).x;
+        const float textWidth = TextCache::Measure(hudFont, line.c_str(), 24, 1).x;
         const float textX = position.x + (tooltipWidth - textWidth) / 2.0f; // Center text horizontally
 
         // Draw main text and glow effect
-        DrawTextEx(hudFont, line.c_str(), {textX, textY}, 24, 1, textColor);
-        DrawTextEx(hudFont, line.c_str(), {textX - 1.5f, textY + 1}, 24, 1,
+        TextCache::Draw(hudFont, line.c_str(), {textX, textY}, 24, 1, textColor);
+        TextCache::Draw(hudFont, line.c_str(), {textX - 1.5f, textY + 1}, 24, 1,
                    {textColor.r, textColor.g, textColor.b, 100});
         textY += lineHeight; // Move to the next line
     }
 
-    std::string levelText = "Level: " + std::to_string(level);
-    float levelTextWidth = MeasureTextEx(hudFont, levelText.c_str(), 20, 1).x;
+    const std::string itemLevelText = "Level: " + std::to_string(level);
+    float levelTextWidth = TextCache::Measure(hudFont, itemLevelText.c_str(), 20, 1).x;
     float levelTextX = position.x + (tooltipWidth - levelTextWidth) / 2.0f;
 
     // Draw item level text with glow
-    DrawTextEx(hudFont, levelText.c_str(), {levelTextX, textY + 5}, 22, 1, {200, 220, 100, 255});
-    DrawTextEx(hudFont, levelText.c_str(), {levelTextX - 1.5f, textY + 6.5f}, 22, 1, {180, 180, 100, 80});
+    TextCache::Draw(hudFont, itemLevelText.c_str(), {levelTextX, textY + 5}, 22, 1, {200, 220, 100, 255});
+    TextCache::Draw(hudFont, itemLevelText.c_str(), {levelTextX - 1.5f, textY + 6.5f}, 22, 1, {180, 180, 100, 80});
     textY += 22;
 
     std::string bonusText = "Bonus: " + std::string(bonus) + "%";
-    float bonusTextWidth = MeasureTextEx(hudFont, bonusText.c_str(), 20, 1).x;
+    float bonusTextWidth = TextCache::Measure(hudFont, bonusText.c_str(), 20, 1).x;
     float bonusTextX = position.x + (tooltipWidth - bonusTextWidth) / 2.0f;
 
     // Draw item bonus text with glow
-    DrawTextEx(hudFont, bonusText.c_str(), {bonusTextX, textY + 5}, 22, 1, {120, 240, 120, 255});
-    DrawTextEx(hudFont, bonusText.c_str(), {bonusTextX - 2, textY + 6.5f}, 22, 1, {100, 200, 100, 80});
+    TextCache::Draw(hudFont, bonusText.c_str(), {bonusTextX, textY + 5}, 22, 1, {120, 240, 120, 255});
+    TextCache::Draw(hudFont, bonusText.c_str(), {bonusTextX - 2, textY + 6.5f}, 22, 1, {100, 200, 100, 80});
 }
 
 // Calculates the bounding rectangle for the HP bar
@@ -1,4 +1,5 @@
 #include "C:/DandD/include/UI/screens/MainMenu.h"
+#include "C:/DandD/include/UI/managers/ResourceManager.h"
 #include <iostream>
 #include <string>
 #include <sstream>
@@ -9,7 +10,10 @@ MainMenu::MainMenu(const int screenWidth, const int screenHeight)
       currentState(MAIN), // Sets the initial state of the menu to MAIN.
       quitSelected(false),
       startGameSelected(false),
-      loadGameSelected(false) {
+      loadGameSelected(false),
+      autoBattleEnabled(false), // Battles use the battle panel by default
+      autoBattlePolicy(BattlePolicy::BEST_DAMAGE),
+      monsterDifficulty(MonsterDifficulty::NORMAL) {
     // Define various colors used for the UI elements.
     frameColor = {40, 40, 70, 230};
     textColor = {220, 220, 250, 255};
@@ -21,9 +25,8 @@ MainMenu::MainMenu(const int screenWidth, const int screenHeight)
 
     // Initialize textures with default empty values.
     menuFont = GetFontDefault();
-    menuFrameTexture = {0};
-    backgroundTexture = {0};
-    titleTexture = {0};
+    backgroundTexture = nullptr;
+    titleTexture = nullptr;
 
     // Create the menu buttons.
     CreateButtons();
@@ -56,6 +59,21 @@ void MainMenu::ResetSelections() {
     loadGameSelected = false;
 }
 
+// Returns whether battles should be resolved instantly instead of through the battle panel.
+bool MainMenu::IsAutoBattleEnabled() const {
+    return autoBattleEnabled;
+}
+
+// Returns the attack policy used for auto-resolved battles.
+BattlePolicy MainMenu::GetAutoBattlePolicy() const {
+    return autoBattlePolicy;
+}
+
+// Returns the monster search difficulty for new runs.
+MonsterDifficulty MainMenu::GetMonsterDifficulty() const {
+    return monsterDifficulty;
+}
+
 // Initializes the MainMenu by resetting selections and setting the state to MAIN.
 void MainMenu::Initialize() {
     ResetSelections();
@@ -65,29 +83,14 @@ void MainMenu::Initialize() {
 // Loads necessary resources like fonts and textures for the MainMenu.
 void MainMenu::LoadResources() {
     // Attempt to load a custom font. If it fails, fall back to the default font.
-    menuFont = LoadFont("C:/DandD/assets/fonts/menu.ttf");
-    if (menuFont.texture.id == 0) {
+    menuFont = ResourceManager::AcquireFont("C:/DandD/assets/fonts/menu.ttf");
+    if (menuFont.texture.id == GetFontDefault().texture.id) {
         std::cout << "Warning: Could not load custom font, using default font" << std::endl;
-        menuFont = GetFontDefault();
-    }
-
-    // Attempt to load menu frame texture with error handling.
-    menuFrameTexture = LoadTexture("C:/DandD/assets/border/testFrame.png");
-    if (menuFrameTexture.id == 0) {
-        std::cout << "Warning: Could not load menu frame texture" << std::endl;
-    }
-
-    // Attempt to load background texture with error handling.
-    backgroundTexture = LoadTexture("C:/DandD/assets/background/walls4.png");
-    if (backgroundTexture.id == 0) {
-        std::cout << "Warning: Could not load background texture" << std::endl;
     }
 
-    // Attempt to load title texture with error handling.
-    titleTexture = LoadTexture("C:/DandD/assets/ui/title.png");
-    if (titleTexture.id == 0) {
-        std::cout << "Warning: Could not load title texture" << std::endl;
-    }
+    // Background and title decode in the background; the gradient and text fallbacks stand in until they are up.
+    backgroundTexture = &ResourceManager::AcquireTexture("C:/DandD/assets/background/walls4.png");
+    titleTexture = &ResourceManager::AcquireTexture("C:/DandD/assets/ui/title.png");
 
     // Set the loaded font for all interactive buttons.
     startButton.SetFont(menuFont);
@@ -96,6 +99,9 @@ void MainMenu::LoadResources() {
     creditsButton.SetFont(menuFont);
     quitButton.SetFont(menuFont);
     backButton.SetFont(menuFont);
+    battleModeButton.SetFont(menuFont);
+    battlePolicyButton.SetFont(menuFont);
+    difficultyButton.SetFont(menuFont);
 
     std::cout << "MainMenu resources loaded" << std::endl;
 }
@@ -113,6 +119,23 @@ void MainMenu::CreateButtons() {
     backButton = Button({screenWidth / 2.0f - 100, screenHeight - 100.0f, 200, 50}, "Back",
                         [this]() { this->currentState = MAIN; });
 
+    // Options menu toggles; labels are filled in by UpdateOptionLabels.
+    battleModeButton = Button(CalculateButtonBounds(0, 3), "", [this]() {
+        this->autoBattleEnabled = !this->autoBattleEnabled;
+        UpdateOptionLabels();
+    });
+    battlePolicyButton = Button(CalculateButtonBounds(1, 3), "", [this]() {
+        // Cycle WEAPON_ONLY -> SPELL_ONLY -> BEST_DAMAGE
+        this->autoBattlePolicy = static_cast<BattlePolicy>((static_cast<int>(this->autoBattlePolicy) + 1) % 3);
+        UpdateOptionLabels();
+    });
+    difficultyButton = Button(CalculateButtonBounds(2, 3), "", [this]() {
+        // Cycle EASY -> NORMAL -> HARD
+        this->monsterDifficulty = static_cast<MonsterDifficulty>((static_cast<int>(this->monsterDifficulty) + 1) % 3);
+        UpdateOptionLabels();
+    });
+    UpdateOptionLabels();
+
     // Define button colors and styling parameters.
     const Color buttonColor = {60, 60, 85, 255};
     const Color hoverColor = {75, 75, 110, 255};
@@ -134,6 +157,38 @@ void MainMenu::CreateButtons() {
     styleButton(creditsButton);
     styleButton(quitButton);
     styleButton(backButton);
+    styleButton(battleModeButton);
+    styleButton(battlePolicyButton);
+    styleButton(difficultyButton);
+}
+
+// Refreshes the option toggle labels from the current settings.
+void MainMenu::UpdateOptionLabels() {
+    battleModeButton.SetText(autoBattleEnabled ? "Battles: Auto" : "Battles: Manual");
+
+    switch (autoBattlePolicy) {
+        case BattlePolicy::WEAPON_ONLY:
+            battlePolicyButton.SetText("Auto: Weapon");
+            break;
+        case BattlePolicy::SPELL_ONLY:
+            battlePolicyButton.SetText("Auto: Spell");
+            break;
+        case BattlePolicy::BEST_DAMAGE:
+            battlePolicyButton.SetText("Auto: Best damage");
+            break;
+    }
+
+    switch (monsterDifficulty) {
+        case MonsterDifficulty::EASY:
+            difficultyButton.SetText("Monsters: Easy");
+            break;
+        case MonsterDifficulty::NORMAL:
+            difficultyButton.SetText("Monsters: Normal");
+            break;
+        case MonsterDifficulty::HARD:
+            difficultyButton.SetText("Monsters: Hard");
+            break;
+    }
 }
 
 // Updates the state of the menu and its buttons based on delta time and mouse input.
@@ -160,6 +215,9 @@ void MainMenu::Update(float deltaTime) {
             break;
 
         case OPTIONS:
+            battleModeButton.Update(mousePos);
+            battlePolicyButton.Update(mousePos);
+            difficultyButton.Update(mousePos);
             backButton.Update(mousePos);
             break;
 
@@ -205,12 +263,12 @@ void MainMenu::Draw() const {
 
 // Draws the background of the main menu.
 void MainMenu::DrawBackground() const {
-    if (backgroundTexture.id > 0) {
+    if (backgroundTexture && backgroundTexture->id > 0) {
         // Check if background texture was successfully loaded.
         const Rectangle backgroundRect = {0, 0, static_cast<float>(screenWidth), static_cast<float>(screenHeight)};
         DrawTexturePro(
-            backgroundTexture,
-            {0, 0, static_cast<float>(backgroundTexture.width), static_cast<float>(backgroundTexture.height)},
+            *backgroundTexture,
+            {0, 0, static_cast<float>(backgroundTexture->width), static_cast<float>(backgroundTexture->height)},
             // Source rectangle for the whole texture.
             backgroundRect, // Destination rectangle to cover the whole screen.
             {0, 0}, // Origin for texture drawing.
@@ -218,7 +276,7 @@ void MainMenu::DrawBackground() const {
             WHITE // Tint color.
         );
     } else {
-        // Fallback to a gradient background if the texture failed to load.
+        // Fallback to a gradient background if the texture failed to load or is still loading.
         DrawRectangleGradientV(0, 0, screenWidth, screenHeight, darkPurple, ColorAlpha(mysticBlue, 0.6f));
     }
 }
@@ -264,16 +322,16 @@ void MainMenu::DrawTitle() const {
     const int fontSize = 50;
     const std::string title = "Dungeons & Dragons";
 
-    if (titleTexture.id > 0) {
+    if (titleTexture && titleTexture->id > 0) {
         // If title texture loaded, draw it.
-        const float titleWidth = static_cast<float>(titleTexture.width);
-        const float titleHeight = static_cast<float>(titleTexture.height);
+        const float titleWidth = static_cast<float>(titleTexture->width);
+        const float titleHeight = static_cast<float>(titleTexture->height);
         const float scale = 0.5f; // Scale down the texture.
         const float scaledWidth = titleWidth * scale;
         const float scaledHeight = titleHeight * scale;
 
         DrawTexturePro(
-            titleTexture,
+            *titleTexture,
             {0, 0, titleWidth, titleHeight},
             {screenWidth / 2.0f - scaledWidth / 2.0f, 30, scaledWidth, scaledHeight}, // Centered horizontally.
             {0, 0},
@@ -281,7 +339,7 @@ void MainMenu::DrawTitle() const {
             WHITE
         );
     } else {
-        // Fallback to drawing text if the title texture failed to load.
+        // Fallback to drawing text if the title texture failed to load or is still loading.
         const Vector2 titleSize = MeasureTextEx(menuFont, title.c_str(), fontSize, 1);
         const float titleX = screenWidth / 2.0f - titleSize.x / 2.0f;
 
@@ -307,8 +365,11 @@ void MainMenu::DrawMainMenu() const {
                16, 1, ColorAlpha(textColor, 0.7f));
 }
 
-// Draws the options menu content (currently only the back button).
+// Draws the options menu content: battle settings and the back button.
 void MainMenu::DrawOptionsMenu() const {
+    battleModeButton.Draw();
+    battlePolicyButton.Draw();
+    difficultyButton.Draw();
     backButton.Draw();
 }
 
@@ -386,18 +447,11 @@ Rectangle MainMenu::CalculateButtonBounds(const int buttonIndex, const int total
 
 // Unloads all loaded resources to prevent memory leaks.
 void MainMenu::Unload() {
-    // Unload font only if it's not the default font (which is not loaded/unloaded by the user).
-    if (menuFont.texture.id != GetFontDefault().texture.id) {
-        UnloadFont(menuFont);
-    }
-    // Unload textures only if their ID is greater than 0, indicating they were loaded.
-    if (menuFrameTexture.id > 0) {
-        UnloadTexture(menuFrameTexture);
-    }
-    if (backgroundTexture.id > 0) {
-        UnloadTexture(backgroundTexture);
-    }
-    if (titleTexture.id > 0) {
-        UnloadTexture(titleTexture);
-    }
+    // Hand the shared resources back; the manager ignores the default font.
+    ResourceManager::ReleaseFont(menuFont);
+    if (backgroundTexture) ResourceManager::ReleaseTexture(*backgroundTexture);
+    if (titleTexture) ResourceManager::ReleaseTexture(*titleTexture);
+    menuFont = Font{};
+    backgroundTexture = nullptr;
+    titleTexture = nullptr;
 }
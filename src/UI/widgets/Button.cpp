@@ -3,6 +3,7 @@
 //
 
 #include "C:/DandD/include/UI/widgets/Button.h"
+#include "C:/DandD/include/UI/renderers/TextCache.h"
 
 #include <algorithm> // Required for std::clamp
 #include <utility>   // Required for std::move
@@ -13,6 +14,7 @@ Button::Button()
     : bounds({0, 0, 100, 50}), // Default button size and position
       font(GetFontDefault()), // Sets the default Raylib font
       texture({0}), // Initializes texture to an empty (unloaded) state
+      textureSource({0, 0, 0, 0}), // Whole texture once one is set
       action(nullptr), // No click action assigned by default
       isHovered(false), // Not hovered initially
       isPressed(false), // Not pressed initially
@@ -38,6 +40,7 @@ Button::Button(const Rectangle rect, std::string text, std::function<void()> onC
       label(std::move(text)), // Sets the button's text label
       font(GetFontDefault()), // Sets the default Raylib font
       texture({0}), // No texture assigned
+      textureSource({0, 0, 0, 0}),
       action(std::move(onClick)), // Assigns the provided click action
       isHovered(false),
       isPressed(false),
@@ -61,6 +64,7 @@ Button::Button(const Rectangle rect, const Texture2D &buttonTexture, std::functi
     : bounds(rect),
       font(GetFontDefault()),
       texture(buttonTexture), // Sets the button's texture
+      textureSource({0, 0, 0, 0}), // Draw all of it
       action(std::move(onClick)), // Assigns the provided click action
       isHovered(false),
       isPressed(false),
@@ -83,9 +87,21 @@ void Button::SetFont(const Font &customFont) {
     font = customFont;
 }
 
+// Replaces the button's text label (e.g. for toggle buttons).
+void Button::SetText(const std::string &text) {
+    label = text;
+}
+
 // Sets a custom texture for the button's background.
 void Button::SetTexture(const Texture2D &customTexture) {
     texture = customTexture;
+    textureSource = {0, 0, 0, 0};
+}
+
+// Sets a texture region (such as an atlas sprite) for the button's background.
+void Button::SetTexture(const Texture2D &customTexture, const Rectangle source) {
+    texture = customTexture;
+    textureSource = source;
 }
 
 // Sets the colors for the button in its normal, hovered, and pressed states, as well as the text color.
@@ -177,9 +193,11 @@ void Button::Draw() const {
     // Draw the button's background, either with a texture or a solid color/rounded rectangle.
     if (texture.id != 0) {
         // If a texture is assigned and loaded.
+        const Rectangle source = textureSource.width > 0
+                                     ? textureSource
+                                     : Rectangle{0, 0, static_cast<float>(texture.width), static_cast<float>(texture.height)};
         DrawTexturePro(texture,
-                       {0, 0, static_cast<float>(texture.width), static_cast<float>(texture.height)},
-                       // Source rect (whole texture)
+                       source, // Source rect (sprite region or whole texture)
                        drawBounds, // Destination rect (current button bounds)
                        {0, 0}, // Origin for drawing
                        0.0f, // Rotation
@@ -217,16 +235,16 @@ void Button::Draw() const {
     if (!label.empty()) {
         const int fontSize = 20;
         // Measure text size to center it within the button.
-        const Vector2 textSize = MeasureTextEx(font, label.c_str(), fontSize, 1);
+        const Vector2 textSize = TextCache::Measure(font, label.c_str(), fontSize, 1);
         const Vector2 textPos = {
             drawBounds.x + (drawBounds.width - textSize.x) / 2, // Center text horizontally
             drawBounds.y + (drawBounds.height - textSize.y) / 2 // Center text vertically
         };
 
         // Draw a shadow effect for the text.
-        DrawTextEx(font, label.c_str(), {textPos.x + 1, textPos.y + 1}, fontSize, 1, BLACK);
+        TextCache::Draw(font, label.c_str(), {textPos.x + 1, textPos.y + 1}, fontSize, 1, BLACK);
         // Draw the main text.
-        DrawTextEx(font, label.c_str(), textPos, fontSize, 1, textColor);
+        TextCache::Draw(font, label.c_str(), textPos, fontSize, 1, textColor);
     }
 
     // Draw a subtle white highlight when hovered and no custom hover animation is used.
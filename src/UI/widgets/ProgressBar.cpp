@@ -3,6 +3,7 @@
 //
 
 #include "C:/DandD/include/UI/widgets/ProgressBar.h"
+#include "C:/DandD/include/UI/renderers/TextCache.h"
 #include <cmath> // Required for std::fabs and sin
 
 // Constructor for ProgressBar with initial bounds and max value.
@@ -96,6 +97,7 @@ ProgressBar &ProgressBar::operator=(const ProgressBar &other) {
         pulseIntensity = other.pulseIntensity;
         pulseSpeed = other.pulseSpeed;
         pulseTime = other.pulseTime;
+        formattedValid = false; // The formatter may differ
 
         // The assigned object does not own the texture of 'other'.
         ownsTexture = false;
@@ -217,16 +219,16 @@ void ProgressBar::Draw() const {
 
     // Draw text on the progress bar if enabled.
     if (drawText) {
-        const std::string text = GetFormattedText(); // Get the formatted text.
-        const Vector2 textSize = MeasureTextEx(font, text.c_str(), fontSize, 1); // Measure text dimensions.
+        const std::string &text = GetFormattedText(); // Get the formatted text.
+        const Vector2 textSize = TextCache::Measure(font, text.c_str(), fontSize, 1); // Measure text dimensions.
         const Vector2 textPos = {
             bounds.x + (bounds.width - textSize.x) * 0.5f, // Center text horizontally.
             bounds.y + (bounds.height - textSize.y) * 0.5f // Center text vertically.
         };
 
-        DrawTextEx(font, text.c_str(), textPos, fontSize, 1, textColor); // Draw main text.
+        TextCache::Draw(font, text.c_str(), textPos, fontSize, 1, textColor); // Draw main text.
         // Draw a slightly offset, semi-transparent text for a subtle glow/shadow effect.
-        DrawTextEx(font, text.c_str(), {
+        TextCache::Draw(font, text.c_str(), {
                        textPos.x - 1.5f, textPos.y + 1.5f
                    }, fontSize, 1, {textColor.r, textColor.g, textColor.b, 100});
     }
@@ -269,6 +271,11 @@ float ProgressBar::GetPercentage() const {
     return (maxValue > 0.0f) ? (targetValue / maxValue * 100.0f) : 0.0f;
 }
 
+// Returns true while the displayed value has not yet reached the target value.
+bool ProgressBar::IsTransitioning() const {
+    return displayedValue != targetValue;
+}
+
 // Sets the speed at which the displayed value transitions to the target value.
 void ProgressBar::SetTransitionSpeed(const float speed) {
     transitionSpeed = (speed < 0.0f) ? 0.0f : speed; // Ensure speed is non-negative.
@@ -337,11 +344,13 @@ void ProgressBar::SetFontSize(const int newFontSize) {
 // Sets a prefix string to be displayed before the formatted value text.
 void ProgressBar::SetTextPrefix(const std::string &prefix) {
     textPrefix = prefix;
+    formattedValid = false;
 }
 
 // Sets a suffix string to be displayed after the formatted value text.
 void ProgressBar::SetTextSuffix(const std::string &suffix) {
     textSuffix = suffix;
+    formattedValid = false;
 }
 
 // Enables or disables the drawing of text on the progress bar.
@@ -354,6 +363,7 @@ void ProgressBar::SetTextFormat(const std::function<std::string(float, float)> &
     if (formatter) {
         // Only assign if the provided formatter is valid.
         textFormatter = formatter;
+        formattedValid = false;
     }
 }
 
@@ -377,6 +387,13 @@ void ProgressBar::SetBounds(const Rectangle newBounds) {
 }
 
 // Returns the fully formatted text string, including prefix, formatted value, and suffix.
-std::string ProgressBar::GetFormattedText() const {
-    return textPrefix + textFormatter(targetValue, maxValue) + textSuffix;
+const std::string &ProgressBar::GetFormattedText() const {
+    if (!formattedValid || formattedValue != targetValue || formattedMax != maxValue) {
+        formattedText = textPrefix + textFormatter(targetValue, maxValue) + textSuffix;
+        formattedValue = targetValue;
+        formattedMax = maxValue;
+        formattedValid = true;
+    }
+
+    return formattedText;
 }
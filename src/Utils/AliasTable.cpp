@@ -0,0 +1,67 @@
+#include "C:/DandD/include/Utils/AliasTable.h"
+#include <cmath>
+#include <stdexcept>
+
+AliasTable::AliasTable(const std::vector<double> &weights) {
+    Build(weights);
+}
+
+void AliasTable::Build(const std::vector<double> &weights) {
+    if (weights.empty()) {
+        throw std::runtime_error("Alias table needs at least one weight");
+    }
+
+    double total = 0.0;
+    for (const double weight: weights) {
+        if (!(weight >= 0.0) || !std::isfinite(weight)) {
+            throw std::runtime_error("Alias table weights must be finite and not negative");
+        }
+        total += weight;
+    }
+    if (total <= 0.0) {
+        throw std::runtime_error("Alias table weights are all zero");
+    }
+
+    const size_t n = weights.size();
+    threshold.assign(n, COIN_RANGE);
+    alias.resize(n);
+    probability.resize(n);
+
+    // Scale so the average column is exactly full, then pair underfull columns with overfull ones
+    std::vector<double> scaled(n);
+    std::vector<uint32_t> small;
+    std::vector<uint32_t> large;
+    for (size_t i = 0; i < n; i++) {
+        probability[i] = weights[i] / total;
+        scaled[i] = probability[i] * static_cast<double>(n);
+        alias[i] = static_cast<uint32_t>(i);
+        (scaled[i] < 1.0 ? small : large).push_back(static_cast<uint32_t>(i));
+    }
+
+    while (!small.empty() && !large.empty()) {
+        const uint32_t under = small.back();
+        small.pop_back();
+        const uint32_t over = large.back();
+
+        // The underfull column is topped up by the overfull entry, which gives away that much
+        threshold[under] = static_cast<uint64_t>(scaled[under] * static_cast<double>(COIN_RANGE));
+        alias[under] = over;
+        scaled[over] -= 1.0 - scaled[under];
+
+        if (scaled[over] < 1.0) {
+            large.pop_back();
+            small.push_back(over);
+        }
+    }
+
+    // Whatever is left is full up to rounding error
+    for (const uint32_t index: small) threshold[index] = COIN_RANGE;
+    for (const uint32_t index: large) threshold[index] = COIN_RANGE;
+}
+
+size_t AliasTable::Sample(std::mt19937 &gen) const {
+    std::uniform_int_distribution<size_t> column(0, alias.size() - 1);
+    const size_t index = column(gen);
+
+    return static_cast<uint64_t>(gen()) < threshold[index] ? index : alias[index];
+}
@@ -3,29 +3,39 @@
 //
 
 #include "C:/DandD/include/Utils/Attack.h"
-#include <random>
+#include "C:/DandD/include/Utils/ProbabilitySystem.h"
 
-Attack::Attack() : isPlayerTurn(true) {
+Attack::Attack() : isPlayerTurn(true), lastAttackCritical(false) {
 }
 
-double Attack::calculateBaseAttack(const float baseStat, const float bonus, const float armorReduction) {
+double Attack::calculateBaseAttack(const float baseStat, const float bonus, const float armorReduction) const {
     const float total = baseStat * (1.0f + bonus / 100);
 
     return total * (1.0f - armorReduction / 100);
 }
 
 
-double Attack::calculateWeaponAttack(const Entity &attacker, const Entity &defender) {
+double Attack::calculateWeaponAttack(const Entity &attacker, const Entity &defender) const {
     return calculateBaseAttack(attacker.GetStrength(), attacker.GetWeaponBonus(), defender.GetArmorReduction());
 }
 
-double Attack::calculateSpellAttack(const Entity &attacker, const Entity &defender) {
+double Attack::calculateSpellAttack(const Entity &attacker, const Entity &defender) const {
     return calculateBaseAttack(attacker.GetStrength(), attacker.GetSpellBonus(), defender.GetArmorReduction());
 }
 
 double Attack::performAttack(const Entity &attacker, Entity &defender, AttackType type) {
-    double damage = 0.0f;
     const bool criticalHit = isCriticalHit();
+    const double damage = estimateDamage(attacker, defender, type, criticalHit);
+
+    lastAttackCritical = criticalHit;
+    defender.takeDamage(damage);
+
+    return damage;
+}
+
+double Attack::estimateDamage(const Entity &attacker, const Entity &defender, const AttackType type,
+                              const bool criticalHit) const {
+    double damage = 0.0f;
 
     switch (type) {
         case AttackType::WEAPON:
@@ -45,16 +55,11 @@ double Attack::performAttack(const Entity &attacker, Entity &defender, AttackTyp
         damage += bonusDamage;
     }
 
-    defender.takeDamage(damage);
-
     return damage;
 }
 
 bool Attack::isCriticalHit() const {
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dis(1, 100);
-    const int roll = dis(gen);
+    const int roll = RandomUtils::randomValue<int>(1, 100);
 
     return (roll <= CRITICAL_HIT_CHANCE);
 }
@@ -63,6 +68,14 @@ bool Attack::checkCriticalHit() {
     return isCriticalHit();
 }
 
+int Attack::getCriticalHitChance() const {
+    return CRITICAL_HIT_CHANCE;
+}
+
+bool Attack::wasLastAttackCritical() const {
+    return lastAttackCritical;
+}
+
 std::string Attack::getAttackName(const Entity &attacker, const AttackType type) {
     if (type == AttackType::WEAPON) {
         return "Claw Attack";
@@ -72,7 +85,7 @@ std::string Attack::getAttackName(const Entity &attacker, const AttackType type)
 }
 
 void Attack::rewardExperience(Hero &player, const Monster &monster) {
-    const int expGained = static_cast<int>(monster.GetStrength() * 5 + monster.GetLevel() * 20);
+    const int expGained = Balance::experienceReward(monster.GetLevel());
 
     player.addXP(expGained);
 }
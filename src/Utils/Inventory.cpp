@@ -2,24 +2,44 @@
 
 #include "../../../include/Utils/Inventory.h"
 
-Inventory::Inventory(Armor a, Weapon w, Spell s) : armor(std::move(a)), weapon(std::move(w)), spell(std::move(s)) {
+Inventory::Inventory(Armor a, Weapon w, Spell s)
+    : armor(std::move(a)), weapon(std::move(w)), spell(std::move(s)), version(0) {
 }
 
 bool Inventory::newWeapon(const Weapon &replacement) {
     this->weapon = replacement;
+    version++;
     return true;
 }
 
 bool Inventory::newArmor(const Armor &replacement) {
     this->armor = replacement;
+    version++;
     return true;
 }
 
 bool Inventory::newSpell(const Spell &replacement) {
     this->spell = replacement;
+    version++;
     return true;
 }
 
+bool Inventory::equip(const Item &item) {
+    // The type tag decides the slot; items are plain values, so no cast is involved
+    switch (item.GetType()) {
+        case ItemType::ARMOR:
+            return newArmor(Armor(item));
+
+        case ItemType::WEAPON:
+            return newWeapon(Weapon(item));
+
+        case ItemType::SPELL:
+            return newSpell(Spell(item));
+    }
+
+    return false;
+}
+
 Armor const &Inventory::GetArmor() const {
     return armor;
 }
@@ -31,3 +51,7 @@ Weapon const &Inventory::GetWeapon() const {
 Spell const &Inventory::GetSpell() const {
     return spell;
 }
+
+uint32_t Inventory::GetVersion() const {
+    return version;
+}
@@ -3,14 +3,10 @@
 //
 
 #include "C:/DandD/include/Utils/ProbabilitySystem.h"
-
-std::string ItemGenerator::chooseName(const std::vector<std::string> &names) {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dist(0, names.size() - 1);
-
-    return names[dist(gen)];
-}
+#include "C:/DandD/include/Utils/AliasTable.h"
+#include <cstdlib>
+#include <sstream>
+#include <vector>
 
 std::string ItemGenerator::getEquipmentType(const ItemType type) {
     switch (type) {
@@ -27,80 +23,326 @@ std::string ItemGenerator::getEquipmentType(const ItemType type) {
     return "Unknown";
 }
 
-ItemType ItemGenerator::generateRandomType() {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dist(0, 2);
-    return static_cast<ItemType>(dist(gen));
+namespace {
+    constexpr int ITEM_TYPE_COUNT = 3;
+
+    // Names of one [TYPE_LEVEL_N section: a range of nameIds
+    struct NameSection {
+        uint32_t first;
+        uint32_t count;
+    };
+
+    // All sections' names back to back, and one section per (level, type): index level * ITEM_TYPE_COUNT + type
+    std::vector<ItemNameId> nameIds;
+    std::vector<NameSection> nameSections;
+    int nameTableMaxLevel = 0;
+
+    struct RarityTier {
+        std::string name;
+        double bonusMultiplier;
+    };
+
+    // What one draw from a loot table hands out
+    struct LootEntry {
+        ItemType type;
+        ItemRarity rarity;
+    };
+
+    struct LootTable {
+        std::vector<LootEntry> entries;
+        AliasTable alias;
+    };
+
+    // Tables indexed by level; slot 0 is unused
+    std::vector<RarityTier> rarityTiers;
+    std::vector<LootTable> lootTables;
+    std::vector<LootTable> bossLootTables;
+
+    // A "TYPE RARITY weight" line as read, resolved once the whole file is in
+    struct LootLine {
+        std::string type;
+        std::string rarity;
+        double weight;
+        std::string text;
+    };
+
+    const NameSection &findSection(const ItemType type, const int level) {
+        // Levels past the last one in the file keep drawing from the last one
+        const int clamped = std::clamp(level, 1, nameTableMaxLevel);
+        return nameSections[clamped * ITEM_TYPE_COUNT + static_cast<int>(type)];
+    }
+
+    const LootTable &findLootTable(const int level, const bool boss) {
+        // No boss tables in the file: bosses drop from the regular ones
+        const std::vector<LootTable> &tables = boss && !bossLootTables.empty() ? bossLootTables : lootTables;
+        return tables[std::clamp(level, 1, static_cast<int>(tables.size()) - 1)];
+    }
+
+    // Header like [WEAPON_LEVEL_3 or [BOSS_LOOT_LEVEL_2: the part before _LEVEL_ and the level, or level 0
+    int parseLevelHeader(const std::string &line, std::string &prefix) {
+        const size_t split = line.find("_LEVEL_");
+        if (split == std::string::npos) return 0;
+
+        prefix = line.substr(1, split - 1);
+        return std::atoi(line.c_str() + split + 7);
+    }
+
+    // Levels 1..max from the lines read per level; a gap repeats the level before it
+    std::vector<LootTable> compileLootTables(const std::vector<std::vector<LootLine> > &levels,
+                                             const std::vector<ItemType> &typeByName,
+                                             const std::vector<std::string> &typeNames,
+                                             const std::string &filePath) {
+        std::vector<LootTable> tables(1);
+
+        for (size_t level = 1; level < levels.size(); level++) {
+            if (levels[level].empty()) {
+                if (tables.size() == 1) {
+                    throw std::runtime_error("Loot table for level " + std::to_string(level) + " is empty in: " +
+                                             filePath);
+                }
+                tables.push_back(tables.back());
+                continue;
+            }
+
+            LootTable table;
+            std::vector<double> weights;
+            for (const LootLine &line: levels[level]) {
+                const auto type = std::find(typeNames.begin(), typeNames.end(), line.type);
+                const auto rarity = std::find_if(rarityTiers.begin(), rarityTiers.end(),
+                                                 [&line](const RarityTier &tier) { return tier.name == line.rarity; });
+                if (type == typeNames.end() || rarity == rarityTiers.end()) {
+                    throw std::runtime_error("Unknown item type or rarity in loot line '" + line.text + "' in: " +
+                                             filePath);
+                }
+
+                table.entries.push_back({
+                    typeByName[type - typeNames.begin()],
+                    static_cast<ItemRarity>(rarity - rarityTiers.begin())
+                });
+                weights.push_back(line.weight);
+            }
+
+            table.alias.Build(weights);
+            tables.push_back(std::move(table));
+        }
+
+        return tables;
+    }
 }
 
-static std::unordered_map<std::string, std::vector<std::string> > nameCache;
+void ItemGenerator::preloadTables(const std::string &filePath) {
+    std::ifstream file(filePath);
+    if (!file.is_open()) {
+        throw std::runtime_error("Could not open file: " + filePath);
+    }
+
+    enum class Section { NONE, NAMES, RARITY, LOOT, BOSS_LOOT };
+
+    // Read every section first; levels can come in any order and rarities may be listed after the loot
+    std::vector<std::vector<ItemNameId> > sections;
+    std::vector<RarityTier> tiers;
+    std::vector<std::vector<LootLine> > loot;
+    std::vector<std::vector<LootLine> > bossLoot;
+    int maxLevel = 0;
+    Section kind = Section::NONE;
+    int current = -1;
 
-std::string ItemGenerator::generateRandomName(const std::string &filePath, const ItemType type, const int level) {
-    const std::string lookingFor = getEquipmentType(type) + "_LEVEL_" + std::to_string(level);
-    if (nameCache.find(lookingFor) == nameCache.end()) {
-        std::vector<std::string> names;
+    std::string line;
+    while (std::getline(file, line)) {
+        line.erase(0, line.find_first_not_of(" \t\r\n"));
+        line.erase(line.find_last_not_of(" \t\r\n") + 1);
 
-        std::ifstream file(filePath);
-        if (!file.is_open()) {
-            throw std::runtime_error("Could not open file: " + filePath);
+        if (line.empty()) continue;
+
+        if (line[0] == '[') {
+            kind = Section::NONE;
+            current = -1;
+
+            std::string prefix;
+            const int level = parseLevelHeader(line, prefix);
+            if (line == "[RARITY") {
+                kind = Section::RARITY;
+            } else if (level > 0 && (prefix == "LOOT" || prefix == "BOSS_LOOT")) {
+                kind = prefix == "LOOT" ? Section::LOOT : Section::BOSS_LOOT;
+                std::vector<std::vector<LootLine> > &levels = kind == Section::LOOT ? loot : bossLoot;
+                if (level >= static_cast<int>(levels.size())) {
+                    levels.resize(level + 1);
+                }
+                current = level;
+            } else if (level > 0) {
+                for (int type = 0; type < ITEM_TYPE_COUNT; type++) {
+                    if (prefix == getEquipmentType(static_cast<ItemType>(type))) {
+                        kind = Section::NAMES;
+                        current = level * ITEM_TYPE_COUNT + type;
+                        maxLevel = std::max(maxLevel, level);
+                    }
+                }
+
+                if (current >= static_cast<int>(sections.size())) {
+                    sections.resize(current + 1);
+                }
+            }
+            continue;
         }
 
-        std::string line;
-        bool readingNames = false;
+        if (line[0] == ']') {
+            kind = Section::NONE;
+            continue;
+        }
 
-        while (std::getline(file, line)) {
-            line.erase(0, line.find_first_not_of(" \t\r\n"));
-            line.erase(line.find_last_not_of(" \t\r\n") + 1);
+        std::istringstream fields(line);
+        switch (kind) {
+            case Section::NAMES:
+                sections[current].push_back(ItemNames::Intern(line));
+                break;
 
-            if (line.empty()) continue;
+            case Section::RARITY: {
+                RarityTier tier{"", 1.0};
+                if (!(fields >> tier.name >> tier.bonusMultiplier)) {
+                    throw std::runtime_error("Bad rarity line '" + line + "' in: " + filePath);
+                }
+                tiers.push_back(tier);
+                break;
+            }
 
-            if (line[0] == '[' && (line.find(lookingFor) != std::string::npos)) {
-                readingNames = true;
-                continue;
+            case Section::LOOT:
+            case Section::BOSS_LOOT: {
+                LootLine entry{"", "", 0.0, line};
+                if (!(fields >> entry.type >> entry.rarity >> entry.weight)) {
+                    throw std::runtime_error("Bad loot line '" + line + "' in: " + filePath);
+                }
+                (kind == Section::LOOT ? loot : bossLoot)[current].push_back(entry);
+                break;
             }
 
-            if (readingNames) {
-                if (line[0] == ']') break;
-                names.push_back(line);
+            case Section::NONE:
+                break;
+        }
+    }
+
+    if (maxLevel == 0) {
+        throw std::runtime_error("No item names found in: " + filePath);
+    }
+    sections.resize((maxLevel + 1) * ITEM_TYPE_COUNT);
+
+    // Flatten; every (type, level) must have at least one name so a roll always succeeds
+    nameIds.clear();
+    nameSections.assign(sections.size(), NameSection{0, 0});
+    for (int level = 1; level <= maxLevel; level++) {
+        for (int type = 0; type < ITEM_TYPE_COUNT; type++) {
+            const std::vector<ItemNameId> &names = sections[level * ITEM_TYPE_COUNT + type];
+            if (names.empty()) {
+                throw std::runtime_error("Missing item names for " + getEquipmentType(static_cast<ItemType>(type)) +
+                                         " level " + std::to_string(level) + " in: " + filePath);
             }
+
+            nameSections[level * ITEM_TYPE_COUNT + type] = {
+                static_cast<uint32_t>(nameIds.size()), static_cast<uint32_t>(names.size())
+            };
+            nameIds.insert(nameIds.end(), names.begin(), names.end());
         }
+    }
+
+    // A file without loot sections keeps the old drops: every type equally likely, one plain tier
+    rarityTiers = tiers.empty() ? std::vector<RarityTier>{{"COMMON", 1.0}} : tiers;
+    if (rarityTiers.size() > 256) {
+        throw std::runtime_error("Too many rarity tiers in: " + filePath);
+    }
 
-        if (!names.empty()) {
-            return chooseName(names);
+    std::vector<ItemType> typeByName;
+    std::vector<std::string> typeNames;
+    for (int type = 0; type < ITEM_TYPE_COUNT; type++) {
+        typeByName.push_back(static_cast<ItemType>(type));
+        typeNames.push_back(getEquipmentType(static_cast<ItemType>(type)));
+    }
+    if (loot.empty()) {
+        loot.resize(2);
+        for (const std::string &type: typeNames) {
+            loot[1].push_back({type, rarityTiers[0].name, 1.0, type});
         }
+    }
+
+    lootTables = compileLootTables(loot, typeByName, typeNames, filePath);
+    bossLootTables = bossLoot.empty()
+                         ? std::vector<LootTable>()
+                         : compileLootTables(bossLoot, typeByName, typeNames, filePath);
+    nameTableMaxLevel = maxLevel;
+}
 
-        nameCache[lookingFor] = names;
+size_t ItemGenerator::nameCount(const ItemType type, const int level) {
+    if (nameTableMaxLevel == 0) {
+        preloadTables();
     }
 
-    return chooseName(nameCache.at(lookingFor));
+    return findSection(type, level).count;
 }
 
-double ItemGenerator::calculateBonus(const ItemType type, const int level) {
-    static const std::unordered_map<ItemType, std::pair<double, double> > BONUS_RANGES = {
-        {ItemType::ARMOR, {5.0, 10.0}},
-        {ItemType::WEAPON, {20.0, 30.0}},
-        {ItemType::SPELL, {20.0, 30.0}}
-    };
+size_t ItemGenerator::rarityCount() {
+    if (nameTableMaxLevel == 0) {
+        preloadTables();
+    }
+
+    return rarityTiers.size();
+}
 
-    const auto &range = BONUS_RANGES.at(type);
-    const double min = range.first + (level - 1) * (type == ItemType::ARMOR ? 4 : 15);
-    const double max = range.second + (level - 1) * (type == ItemType::ARMOR ? 4 : 15);
+const std::string &ItemGenerator::rarityName(const ItemRarity rarity) {
+    if (nameTableMaxLevel == 0) {
+        preloadTables();
+    }
 
-    return RandomUtils::randomValue<double>(min, max);
+    return rarityTiers[std::min<size_t>(rarity, rarityTiers.size() - 1)].name;
 }
 
-Item *ItemGenerator::generateRandomItem(const int level) {
-    const ItemType type = generateRandomType();
+double ItemGenerator::dropChance(const ItemType type, const ItemRarity rarity, const int level, const bool boss) {
+    if (nameTableMaxLevel == 0) {
+        preloadTables();
+    }
+
+    // The same type and rarity may be listed more than once
+    const LootTable &table = findLootTable(level, boss);
+    double chance = 0.0;
+    for (size_t i = 0; i < table.entries.size(); i++) {
+        if (table.entries[i].type == type && table.entries[i].rarity == rarity) {
+            chance += table.alias.Probability(i);
+        }
+    }
+
+    return chance;
+}
 
-    const std::string name = generateRandomName("C:/DandD/assets/equipment/items.txt", type, level);
+ItemNameId ItemGenerator::generateRandomName(const ItemType type, const int level) {
+    // One bounded draw into the section; no I/O and no strings
+    const NameSection &section = findSection(type, level);
+    return nameIds[section.first + RandomUtils::randomValue<size_t>(0, section.count - 1)];
+}
 
-    const double bonus = calculateBonus(type, level);
+double ItemGenerator::calculateBonus(const ItemType type, const int level) {
+    const Balance::BonusRange &range = Balance::itemBonusRange(type, level);
 
-    switch (type) {
-        case ItemType::WEAPON: return new Weapon(name, bonus, level);
-        case ItemType::ARMOR: return new Armor(name, bonus, level);
-        case ItemType::SPELL: return new Spell(name, bonus, level);
-        default: throw std::runtime_error("Invalid item type");
+    return RandomUtils::randomValue<double>(range.min, range.max);
+}
+
+Item ItemGenerator::rollItem(const int level, const bool boss) {
+    if (nameTableMaxLevel == 0) {
+        preloadTables();
     }
+
+    // O(1) whatever the table size: one alias draw picks type and rarity together
+    const LootTable &table = findLootTable(level, boss);
+    const LootEntry &entry = table.entries[table.alias.Sample(RandomUtils::gen)];
+
+    const ItemNameId name = generateRandomName(entry.type, level);
+
+    const double bonus = calculateBonus(entry.type, level) * rarityTiers[entry.rarity].bonusMultiplier;
+
+    // Returned by value: the type is a tag on the item, no subclass object is needed
+    return Item(name, bonus, level, entry.type, entry.rarity);
+}
+
+Item ItemGenerator::generateRandomItem(const int level) {
+    return rollItem(level, false);
+}
+
+Item ItemGenerator::generateBossDrop(const int level) {
+    return rollItem(level, true);
 }
@@ -0,0 +1,88 @@
+#include "C:/DandD/include/Utils/SpatialGrid.h"
+#include <algorithm>
+
+SpatialGrid::SpatialGrid()
+    : bucketsX(0),
+      bucketsY(0) {
+}
+
+void SpatialGrid::Clear() {
+    // Keep the buckets' capacity for the next level
+    for (std::vector<uint32_t> &bucket: buckets) {
+        bucket.clear();
+    }
+}
+
+void SpatialGrid::Insert(const uint32_t id, const Position &pos) {
+    if (pos.x < 0 || pos.y < 0) return;
+
+    Grow(pos.x / BUCKET_CELLS + 1, pos.y / BUCKET_CELLS + 1);
+    FindBucket(pos)->push_back(id);
+}
+
+void SpatialGrid::Remove(const uint32_t id, const Position &pos) {
+    std::vector<uint32_t> *bucket = FindBucket(pos);
+    if (!bucket) return;
+
+    // Order inside a bucket does not matter: swap with the last and pop
+    const auto found = std::find(bucket->begin(), bucket->end(), id);
+    if (found != bucket->end()) {
+        *found = bucket->back();
+        bucket->pop_back();
+    }
+}
+
+void SpatialGrid::Move(const uint32_t id, const Position &from, const Position &to) {
+    if (from.x >= 0 && from.y >= 0 && to.x >= 0 && to.y >= 0 &&
+        from.x / BUCKET_CELLS == to.x / BUCKET_CELLS && from.y / BUCKET_CELLS == to.y / BUCKET_CELLS) {
+        return; // Same bucket; most steps end here
+    }
+
+    Remove(id, from);
+    Insert(id, to);
+}
+
+void SpatialGrid::Query(const int minX, const int minY, const int maxX, const int maxY,
+                        std::vector<uint32_t> &out) const {
+    if (maxX < 0 || maxY < 0 || maxX < minX || maxY < minY) return;
+
+    const int firstX = std::max(0, minX) / BUCKET_CELLS;
+    const int firstY = std::max(0, minY) / BUCKET_CELLS;
+    const int lastX = std::min(bucketsX - 1, maxX / BUCKET_CELLS);
+    const int lastY = std::min(bucketsY - 1, maxY / BUCKET_CELLS);
+
+    for (int y = firstY; y <= lastY; y++) {
+        for (int x = firstX; x <= lastX; x++) {
+            const std::vector<uint32_t> &bucket = buckets[y * bucketsX + x];
+            out.insert(out.end(), bucket.begin(), bucket.end());
+        }
+    }
+}
+
+std::vector<uint32_t> *SpatialGrid::FindBucket(const Position &pos) {
+    if (pos.x < 0 || pos.y < 0) return nullptr;
+
+    const int x = pos.x / BUCKET_CELLS;
+    const int y = pos.y / BUCKET_CELLS;
+    if (x >= bucketsX || y >= bucketsY) return nullptr;
+
+    return &buckets[y * bucketsX + x];
+}
+
+void SpatialGrid::Grow(const int minBucketsX, const int minBucketsY) {
+    if (minBucketsX <= bucketsX && minBucketsY <= bucketsY) return;
+
+    // Re-lay the rows out at the new width; happens a handful of times while the first level loads
+    const int newX = std::max(bucketsX, minBucketsX);
+    const int newY = std::max(bucketsY, minBucketsY);
+    std::vector<std::vector<uint32_t> > grown(static_cast<size_t>(newX) * newY);
+    for (int y = 0; y < bucketsY; y++) {
+        for (int x = 0; x < bucketsX; x++) {
+            grown[y * newX + x] = std::move(buckets[y * bucketsX + x]);
+        }
+    }
+
+    buckets = std::move(grown);
+    bucketsX = newX;
+    bucketsY = newY;
+}
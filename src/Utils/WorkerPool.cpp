@@ -0,0 +1,42 @@
+#include "C:/DandD/include/Utils/WorkerPool.h"
+
+WorkerPool::WorkerPool(unsigned workerCount)
+    : stopping(false) {
+    if (workerCount == 0) {
+        // hardware_concurrency may report 0 when it can't tell
+        const unsigned hardwareThreads = std::thread::hardware_concurrency();
+        workerCount = hardwareThreads > 2 ? hardwareThreads - 1 : 1;
+    }
+
+    for (unsigned i = 0; i < workerCount; i++) {
+        workers.emplace_back(&WorkerPool::Run, this);
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+
+    for (std::thread &worker: workers) {
+        worker.join();
+    }
+}
+
+void WorkerPool::Run() {
+    while (true) {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this] { return stopping || !jobs.empty(); });
+            if (jobs.empty()) return; // Stopping, and nothing left to finish
+
+            job = std::move(jobs.front());
+            jobs.pop();
+        }
+
+        job();
+    }
+}